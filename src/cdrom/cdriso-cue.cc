@@ -68,14 +68,15 @@ bool PCSX::CDRIso::parsecue(const char *isofileString) {
 
     auto createFile = [](CueFile *file, CueScheduler *scheduler, const char *filename) -> CueFile * {
         Context *context = reinterpret_cast<Context *>(scheduler->opaque);
-        UvFile *fi = new UvFile(filename);
+        File *fi = openImageFile(filename);
         if (fi->failed()) {
             delete fi;
-            fi = new UvFile(context->filepath / filename);
+            fi = openImageFile(context->filepath / filename);
         }
-        if (!fi->failed()) {
+        UvFile *uvfi = dynamic_cast<UvFile *>(fi);
+        if (uvfi && !uvfi->failed()) {
             if (g_emulator->settings.get<Emulator::SettingFullCaching>()) {
-                fi->startCaching();
+                uvfi->startCaching();
             }
         }
         file->opaque = fi;
@@ -93,7 +94,7 @@ bool PCSX::CDRIso::parsecue(const char *isofileString) {
         file->size = [](CueFile *file, CueScheduler *scheduler, int compressed,
                         void (*cb)(CueFile *, CueScheduler *, uint64_t)) {
             File *fi = reinterpret_cast<File *>(file->opaque);
-            if (compressed && dynamic_cast<UvFile *>(fi)) {
+            if (compressed && !dynamic_cast<FFmpegAudioFile *>(fi)) {
                 FFmpegAudioFile *cfi =
                     new FFmpegAudioFile(fi, FFmpegAudioFile::Channels::Stereo, FFmpegAudioFile::Endianness::Little,
                                         FFmpegAudioFile::SampleFormat::S16, 44100);
@@ -172,7 +173,7 @@ bool PCSX::CDRIso::parsecue(const char *isofileString) {
     }
     Scheduler_run(&scheduler);
 
-    m_cdHandle.setFile(reinterpret_cast<UvFile *>(disc.tracks[1].file->opaque));
+    m_cdHandle.setFile(reinterpret_cast<File *>(disc.tracks[1].file->opaque));
 
     for (unsigned i = 1; i <= disc.trackCount; i++) {
         CueTrack *track = &disc.tracks[i];
@@ -117,8 +117,9 @@ bool PCSX::CDRIso::parsetoc(const char *isofileStr) {
             } else {
                 sscanf(linebuf, "DATAFILE \"%[^\"]\" %8s", name, time);
                 m_ti[m_numtracks].length = IEC60908b::MSF(time);
-                m_ti[m_numtracks].handle.setFile(new UvFile(filename / name));
-                if (g_emulator->settings.get<Emulator::SettingFullCaching>()) {
+                m_ti[m_numtracks].handle.setFile(openImageFile(filename / name));
+                if (g_emulator->settings.get<Emulator::SettingFullCaching>() &&
+                    m_ti[m_numtracks].handle.isA<UvFile>()) {
                     m_ti[m_numtracks].handle.asA<UvFile>()->startCaching();
                 }
             }
@@ -19,6 +19,8 @@
 
 #include "cdrom/cdriso.h"
 
+#include "support/instrumentation.h"
+#include "support/mmapfile.h"
 #include "supportpsx/iec-60908b.h"
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -75,6 +77,16 @@ PCSX::CDRIso::CDRIso() {
     if (ret != Z_OK) throw("Unable to initialize zlib context");
 }
 
+// opens a disc image file, memory mapped when the setting asks for it
+PCSX::File *PCSX::CDRIso::openImageFile(const std::filesystem::path &path) {
+    if (g_emulator->settings.get<Emulator::SettingMmapDiscImages>()) {
+        File *fi = new MmapFile(path, MmapFile::Access::SEQUENTIAL);
+        if (!fi->failed()) return fi;
+        delete fi;
+    }
+    return new UvFile(path);
+}
+
 // this function tries to get the .sub file of the given .img
 bool PCSX::CDRIso::opensubfile(const char *isoname) {
     char subname[MAXPATHLEN];
@@ -347,8 +359,8 @@ bool PCSX::CDRIso::open(IO<File> isoFile) {
 
     // make sure we have another handle open for cdda
     if (m_numtracks > 1 && !m_ti[1].handle) {
-        m_ti[1].handle.setFile(new UvFile(m_isoPath));
-        if (g_emulator->settings.get<Emulator::SettingFullCaching>()) {
+        m_ti[1].handle.setFile(openImageFile(m_isoPath));
+        if (g_emulator->settings.get<Emulator::SettingFullCaching>() && m_ti[1].handle.isA<UvFile>()) {
             m_ti[1].handle.asA<UvFile>()->startCaching();
         }
     }
@@ -437,6 +449,7 @@ void PCSX::CDRIso::decodeRawSubData() {
 
 // read track
 bool PCSX::CDRIso::readTrack(const IEC60908b::MSF time) {
+    PCSX_INSTRUMENT(DiscIO);
     int sector = time.toLBA() - 150;
     long ret;
 
@@ -35,7 +35,7 @@ class CDRIso {
   public:
     CDRIso(const std::filesystem::path& path) : CDRIso() {
         m_isoPath = path;
-        open(new UvFile(m_isoPath));
+        open(openImageFile(m_isoPath));
     }
     CDRIso(IO<File> isoFile) : CDRIso() {
         m_isoPath = isoFile->filename();
@@ -161,6 +161,9 @@ class CDRIso {
     bool handlepbp(const char* isofile);
     bool handlecbin(const char* isofile);
     bool handleecm(const char* isoname, IO<File> cdh, int32_t* accurate_length);
+    // Opens one of the files holding the disc's data, memory mapped when
+    // the settings ask for it, and as a UvFile otherwise, or if mapping failed.
+    static File* openImageFile(const std::filesystem::path& path);
     bool opensubfile(const char* isoname);
     bool opensbifile(const char* isoname);
 
@@ -20,7 +20,6 @@
 #include "cdrom/file.h"
 
 #include "cdrom/cdriso.h"
-#include "iec-60908b/edcecc.h"
 #include "magic_enum/include/magic_enum/magic_enum_all.hpp"
 
 PCSX::CDRIsoFile::CDRIsoFile(std::shared_ptr<CDRIso> iso, uint32_t lba, int32_t size, SectorMode mode)
@@ -201,7 +200,7 @@ ssize_t PCSX::CDRIsoFile::write(const void* buffer_, size_t size) {
         switch (m_mode) {
             case SectorMode::M2_FORM1:
             case SectorMode::M2_FORM2:
-                compute_edcecc(patched);
+                IEC60908b::computeEDCECC(patched);
                 break;
         }
         ppf->calculatePatch(m_cachedSector, patched, msf);
@@ -19,9 +19,21 @@
 
 #include "cdrom/iso9660-builder.h"
 
-#include <stdexcept>
+#include <utility>
 
-#include "iec-60908b/edcecc.h"
+PCSX::ISO9660Builder::ISO9660Builder(IO<File> out) : m_out(out) {
+    m_worker = std::thread([this]() { workerMain(); });
+}
+
+PCSX::ISO9660Builder::~ISO9660Builder() {
+    if (m_out) flush();
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workAvailable.notify_one();
+    m_worker.join();
+}
 
 void PCSX::ISO9660Builder::writeLicense(IO<File> licenseFile) {
     if (licenseFile && !licenseFile->failed()) {
@@ -50,29 +62,96 @@ void PCSX::ISO9660Builder::writeLicense(IO<File> licenseFile) {
     }
 }
 
+uint8_t* PCSX::ISO9660Builder::stageSector(uint32_t lba, bool needsEDCECC) {
+    auto& batch = *m_staging;
+    if (batch.count() == 0) batch.sectors.reserve(c_batchSize * IEC60908b::FRAMESIZE_RAW);
+    size_t offset = batch.sectors.size();
+    batch.sectors.resize(offset + IEC60908b::FRAMESIZE_RAW);
+    if (needsEDCECC) batch.needsEDCECC.push_back(batch.count());
+    batch.lbas.push_back(lba);
+    return batch.sectors.data() + offset;
+}
+
+void PCSX::ISO9660Builder::submitBatch() {
+    if (m_staging->count() == 0) return;
+    // The sectors vector may have moved while the batch was being filled, so
+    // the pointers can only be resolved now.
+    for (auto index : m_staging->needsEDCECC) {
+        m_staging->pointers.push_back(m_staging->sectors.data() + index * IEC60908b::FRAMESIZE_RAW);
+    }
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_workDone.wait(lock, [this]() { return m_pending < c_maxQueued; });
+        m_queue.push_back(std::move(m_staging));
+        m_pending++;
+        if (m_spare.empty()) {
+            m_staging = std::make_unique<Batch>();
+        } else {
+            m_staging = std::move(m_spare.back());
+            m_spare.pop_back();
+        }
+    }
+    m_workAvailable.notify_one();
+}
+
+void PCSX::ISO9660Builder::workerMain() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_workAvailable.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+        if (m_queue.empty()) return;
+        auto batch = std::move(m_queue.front());
+        m_queue.pop_front();
+        lock.unlock();
+        IEC60908b::computeEDCECC(batch->pointers.data(), batch->pointers.size());
+        writeBatch(*batch);
+        batch->clear();
+        lock.lock();
+        m_spare.push_back(std::move(batch));
+        m_pending--;
+        m_workDone.notify_all();
+    }
+}
+
+void PCSX::ISO9660Builder::writeBatch(const Batch& batch) {
+    // Coalesce runs of consecutive sectors into single writes.
+    size_t count = batch.count();
+    size_t start = 0;
+    while (start < count) {
+        size_t end = start + 1;
+        while ((end < count) && (batch.lbas[end] == batch.lbas[end - 1] + 1)) end++;
+        m_out->writeAt(batch.sectors.data() + start * IEC60908b::FRAMESIZE_RAW,
+                       (end - start) * IEC60908b::FRAMESIZE_RAW, batch.lbas[start] * IEC60908b::FRAMESIZE_RAW);
+        start = end;
+    }
+}
+
+void PCSX::ISO9660Builder::flush() {
+    if (!m_out) return;
+    submitBatch();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_workDone.wait(lock, [this]() { return m_pending == 0; });
+}
+
 PCSX::IEC60908b::MSF PCSX::ISO9660Builder::writeSectorAt(const uint8_t* sectorData, PCSX::IEC60908b::MSF msf,
                                                          SectorMode mode) {
     if (failed()) return {0, 0, 0};
-    Slice slice;
     uint8_t* ptr;
     static const uint8_t c_sync[12] = {0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00};
     uint32_t lba = msf.toLBA() - 150;
     switch (mode) {
         case SectorMode::RAW:
-            m_out->writeAt(sectorData, IEC60908b::FRAMESIZE_RAW, lba * IEC60908b::FRAMESIZE_RAW);
+            ptr = stageSector(lba, false);
+            memcpy(ptr, sectorData, IEC60908b::FRAMESIZE_RAW);
             break;
         case SectorMode::M2_RAW:
-            slice.resize(IEC60908b::FRAMESIZE_RAW);
-            ptr = slice.mutableData<uint8_t>();
+            ptr = stageSector(lba, false);
             memcpy(ptr, c_sync, sizeof(c_sync));
             msf.toBCD(ptr + 12);
             ptr[15] = 2;
             memcpy(ptr + 16, sectorData, 2336);
-            m_out->writeAt(std::move(slice), lba * IEC60908b::FRAMESIZE_RAW);
             break;
         case SectorMode::M2_FORM1:
-            slice.resize(IEC60908b::FRAMESIZE_RAW);
-            ptr = slice.mutableData<uint8_t>();
+            ptr = stageSector(lba, true);
             memcpy(ptr, c_sync, sizeof(c_sync));
             msf.toBCD(ptr + 12);
             ptr[15] = 2;
@@ -81,12 +160,10 @@ PCSX::IEC60908b::MSF PCSX::ISO9660Builder::writeSectorAt(const uint8_t* sectorDa
             ptr[18] = ptr[22] = 8;
             ptr[19] = ptr[23] = 0;
             memcpy(ptr + 24, sectorData, 2048);
-            compute_edcecc(ptr);
-            m_out->writeAt(std::move(slice), lba * IEC60908b::FRAMESIZE_RAW);
+            memset(ptr + 2072, 0, IEC60908b::FRAMESIZE_RAW - 2072);
             break;
         case SectorMode::M2_FORM2:
-            slice.resize(IEC60908b::FRAMESIZE_RAW);
-            ptr = slice.mutableData<uint8_t>();
+            ptr = stageSector(lba, true);
             memcpy(ptr, c_sync, sizeof(c_sync));
             msf.toBCD(ptr + 12);
             ptr[15] = 2;
@@ -95,12 +172,12 @@ PCSX::IEC60908b::MSF PCSX::ISO9660Builder::writeSectorAt(const uint8_t* sectorDa
             ptr[18] = ptr[22] = 8;
             ptr[19] = ptr[23] = 0;
             memcpy(ptr + 24, sectorData, 2324);
-            compute_edcecc(ptr);
-            m_out->writeAt(std::move(slice), lba * IEC60908b::FRAMESIZE_RAW);
+            memset(ptr + 2348, 0, IEC60908b::FRAMESIZE_RAW - 2348);
             break;
         default:
             return {0, 0, 0};
     }
+    if (m_staging->count() >= c_batchSize) submitBatch();
     auto ret = msf;
     msf++;
     if (msf > m_location) m_location = msf;
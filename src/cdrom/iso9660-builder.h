@@ -19,15 +19,27 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "cdrom/common.h"
 #include "support/file.h"
 #include "supportpsx/iec-60908b.h"
 
 namespace PCSX {
 
+// The sectors are staged into batches, and full batches are handed over to a
+// single worker thread, which computes their EDC/ECC and writes them out in
+// order while the next batch gets filled. This means the output file is only
+// guaranteed to be up to date after a flush.
 class ISO9660Builder {
   public:
-    ISO9660Builder(IO<File> out) : m_out(out) {}
+    ISO9660Builder(IO<File> out);
+    ~ISO9660Builder();
     bool failed() { return !m_out || m_out->failed(); }
     IEC60908b::MSF getCurrentLocation() { return m_location; }
     void writeLicense(IO<File> licenseFile = nullptr);
@@ -35,14 +47,49 @@ class ISO9660Builder {
         return writeSectorAt(sectorData, m_location, mode);
     }
     IEC60908b::MSF writeSectorAt(const uint8_t* sectorData, IEC60908b::MSF msf, SectorMode mode);
+    void flush();
     void close() {
+        if (!m_out) return;
+        flush();
         m_out->close();
         m_out = nullptr;
     }
 
   private:
+    static constexpr size_t c_batchSize = 256;
+    // How many full batches can be waiting on the worker before the
+    // producer blocks.
+    static constexpr size_t c_maxQueued = 2;
+    struct Batch {
+        std::vector<uint8_t> sectors;
+        std::vector<uint32_t> lbas;
+        std::vector<uint32_t> needsEDCECC;
+        std::vector<uint8_t*> pointers;
+        size_t count() const { return lbas.size(); }
+        void clear() {
+            sectors.clear();
+            lbas.clear();
+            needsEDCECC.clear();
+            pointers.clear();
+        }
+    };
+    uint8_t* stageSector(uint32_t lba, bool needsEDCECC);
+    void submitBatch();
+    void writeBatch(const Batch& batch);
+    void workerMain();
+
     IO<File> m_out;
     IEC60908b::MSF m_location = {0, 2, 0};
+    std::unique_ptr<Batch> m_staging = std::make_unique<Batch>();
+    std::deque<std::unique_ptr<Batch>> m_queue;
+    std::vector<std::unique_ptr<Batch>> m_spare;
+    // Batches queued or being processed by the worker.
+    size_t m_pending = 0;
+    bool m_stopping = false;
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_workDone;
+    std::thread m_worker;
 };
 
 }  // namespace PCSX
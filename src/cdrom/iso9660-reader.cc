@@ -19,6 +19,12 @@
 
 #include "cdrom/iso9660-reader.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
 #include "cdrom/file.h"
 #include "cdrom/iso9660-lowlevel.h"
 #include "support/strings-helpers.h"
@@ -56,34 +62,146 @@ PCSX::ISO9660Reader::ISO9660Reader(std::shared_ptr<CDRIso> iso) : m_iso(iso) {
 }
 
 PCSX::File *PCSX::ISO9660Reader::open(const std::string_view &filename) {
+    if (m_failed) return new FailedFile();
+    if (StringsHelpers::split(filename, "/").empty()) {
+        auto root = m_pvd.get<ISO9660LowLevel::PVD_RootDir>();
+        return new CDRIsoFile(m_iso, root.get<ISO9660LowLevel::DirEntry_LBA>(),
+                              root.get<ISO9660LowLevel::DirEntry_Size>());
+    }
     auto entry = findEntry(filename);
-    if (!entry.has_value()) return new FailedFile();
+    if (!entry) return new FailedFile();
 
-    return new CDRIsoFile(m_iso, entry.value().first.get<ISO9660LowLevel::DirEntry_LBA>(),
-                          entry.value().first.get<ISO9660LowLevel::DirEntry_Size>());
+    return new CDRIsoFile(m_iso, entry->lba, entry->size);
 }
 
-std::optional<PCSX::ISO9660Reader::FullDirEntry> PCSX::ISO9660Reader::findEntry(const std::string_view &filename) {
-    if (m_failed) return {};
-    auto parts = StringsHelpers::split(filename, "/");
-
-    FullDirEntry current;
-    current.first = m_pvd.get<ISO9660LowLevel::PVD_RootDir>();
-
-    for (auto &part : parts) {
-        auto entries = listAllEntriesFrom(current.first);
-        for (auto &entry : entries) {
-            const auto &entryFilename = entry.first.get<ISO9660LowLevel::DirEntry_Filename>().value;
-            if (entryFilename == part) {
-                current = entry;
-                break;
-            }
+const PCSX::ISO9660Reader::Entry *PCSX::ISO9660Reader::findEntry(const std::string_view &filename) {
+    buildIndex();
+    if (m_failed) return nullptr;
+
+    // Leading, trailing and doubled slashes are ignored.
+    std::string path;
+    for (auto &part : StringsHelpers::split(filename, "/")) {
+        if (!path.empty()) path += '/';
+        path += part;
+    }
+
+    auto it = m_index.find(path);
+    if (it == m_index.end()) return nullptr;
+    return &m_entries[it->second];
+}
+
+void PCSX::ISO9660Reader::buildIndex() {
+    if (m_indexed || m_failed) return;
+    m_indexed = true;
+
+    struct PendingDir {
+        ISO9660LowLevel::DirEntry entry;
+        std::string path;
+    };
+    std::vector<PendingDir> pending;
+    pending.push_back({m_pvd.get<ISO9660LowLevel::PVD_RootDir>(), ""});
+    // Guards against malformed images with directory loops.
+    std::unordered_set<uint32_t> visited;
+
+    for (size_t i = 0; i < pending.size(); i++) {
+        auto dirEntry = pending[i].entry;
+        auto prefix = pending[i].path;
+        if (!visited.insert(dirEntry.get<ISO9660LowLevel::DirEntry_LBA>()).second) continue;
+
+        for (auto &entry : listAllEntriesFrom(dirEntry)) {
+            const auto &name = entry.first.get<ISO9660LowLevel::DirEntry_Filename>().value;
+            // Skips the "." and ".." records, as well as anything which would
+            // escape the destination directory when extracting. The version
+            // suffix is dropped on the host, so "..;1" is just as bad as "..".
+            if (name.empty() || (name == std::string_view("\0", 1)) || (name == "\1")) continue;
+            std::string_view base = std::string_view(name).substr(0, name.find(';'));
+            if (base.empty() || (base == ".") || (base == "..")) continue;
+            if (name.find_first_of("/\\") != std::string::npos) continue;
+
+            bool directory = (entry.first.get<ISO9660LowLevel::DirEntry_Flags>().value & 2) != 0;
+            std::string path = prefix.empty() ? name : prefix + '/' + name;
+            m_entries.push_back({path, entry.first.get<ISO9660LowLevel::DirEntry_LBA>(),
+                                 entry.first.get<ISO9660LowLevel::DirEntry_Size>(),
+                                 entry.second.get<ISO9660LowLevel::DirEntry_XA_Attribs>(), directory});
+            if (directory) pending.push_back({entry.first, std::move(path)});
         }
+    }
+
+    m_index.reserve(m_entries.size());
+    for (size_t i = 0; i < m_entries.size(); i++) m_index.emplace(m_entries[i].path, i);
+}
 
-        if (current.first.get<ISO9660LowLevel::DirEntry_Filename>() != part) return {};
+// Returns where a disc path lands under dest, once the version suffixes are
+// dropped, or nothing if it would end up anywhere else.
+static std::optional<std::filesystem::path> hostPath(const std::filesystem::path &dest, const std::string_view &path) {
+    auto base = dest.lexically_normal();
+    std::filesystem::path ret = base;
+    for (auto &part : PCSX::StringsHelpers::split(path, "/")) {
+        ret /= std::string(part.substr(0, part.find(';')));
     }
+    ret = ret.lexically_normal();
+    auto relative = ret.lexically_relative(base);
+    if (relative.empty() || relative.is_absolute()) return {};
+    auto first = relative.begin()->string();
+    if ((first == ".") || (first == "..")) return {};
+    return ret;
+}
+
+unsigned PCSX::ISO9660Reader::extractAll(const std::filesystem::path &dest, unsigned threads) {
+    buildIndex();
+    if (m_failed) return 0;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::error_code ec;
+    std::filesystem::create_directories(dest, ec);
+    std::vector<const Entry *> files;
+    for (auto &entry : m_entries) {
+        if (entry.directory) {
+            auto path = hostPath(dest, entry.path);
+            if (path) std::filesystem::create_directories(*path, ec);
+        } else {
+            files.push_back(&entry);
+        }
+    }
+    // Going through the image in sector order keeps its reads mostly sequential.
+    std::sort(files.begin(), files.end(), [](const Entry *a, const Entry *b) { return a->lba < b->lba; });
+
+    // The CDRIso object isn't thread safe, so only one worker reads from it
+    // at a time, while the others are writing their previous file out.
+    std::mutex isoMutex;
+    std::atomic<size_t> next = 0;
+    std::atomic<unsigned> extracted = 0;
+    auto worker = [&]() {
+        while (true) {
+            size_t i = next.fetch_add(1);
+            if (i >= files.size()) return;
+            auto entry = files[i];
+            auto path = hostPath(dest, entry->path);
+            if (!path) continue;
+            Slice data;
+            {
+                std::lock_guard<std::mutex> lock(isoMutex);
+                IO<File> in(new CDRIsoFile(m_iso, entry->lba, entry->size));
+                if (in->failed()) continue;
+                void *buffer = malloc(entry->size);
+                ssize_t r = in->read(buffer, entry->size);
+                data.acquire(buffer, std::max(r, ssize_t(0)));
+                if (r != ssize_t(entry->size)) continue;
+            }
+            IO<File> out(new PosixFile(*path, FileOps::TRUNCATE));
+            if (out->failed()) continue;
+            out->write(std::move(data));
+            out->close();
+            extracted++;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < std::min<size_t>(threads, files.size()); i++) workers.emplace_back(worker);
+    worker();
+    for (auto &t : workers) t.join();
 
-    return current;
+    return extracted;
 }
 
 std::vector<PCSX::ISO9660Reader::FullDirEntry> PCSX::ISO9660Reader::listAllEntriesFrom(
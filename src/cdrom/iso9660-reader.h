@@ -19,8 +19,12 @@
 
 #pragma once
 
+#include <filesystem>
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "cdrom/file.h"
@@ -30,8 +34,19 @@ namespace PCSX {
 
 class CDRIso;
 
+// The whole directory tree gets walked once, on the first lookup, and kept as
+// a flat index of full paths. A reader is tied to the CDRIso it was created
+// with, so swapping discs means creating a new reader, which drops the index.
 class ISO9660Reader {
   public:
+    struct Entry {
+        std::string path;
+        uint32_t lba;
+        uint32_t size;
+        uint16_t xaAttribs;
+        bool directory;
+    };
+
     ISO9660Reader(std::shared_ptr<CDRIso>);
     bool failed() { return m_failed; }
     File* open(const std::string_view& filename);
@@ -39,15 +54,31 @@ class ISO9660Reader {
         if (m_failed) return "";
         return std::string_view(m_pvd.get<ISO9660LowLevel::PVD_VolumeIdent>());
     }
+    // All of the files and directories of the disc, in the order they appear
+    // in the directory tree, parents before their children.
+    const std::vector<Entry>& listAll() {
+        buildIndex();
+        return m_entries;
+    }
+    // Extracts all of the files into the destination directory, dropping the
+    // ";1" version suffixes. The disc is read one file at a time, while the
+    // host files are written by the worker threads. Returns the amount of
+    // files extracted successfully.
+    unsigned extractAll(const std::filesystem::path& dest, unsigned threads = 0);
 
   private:
     std::shared_ptr<CDRIso> m_iso;
     bool m_failed = false;
+    bool m_indexed = false;
     typedef std::pair<ISO9660LowLevel::DirEntry, ISO9660LowLevel::DirEntry_XA> FullDirEntry;
 
-    std::optional<FullDirEntry> findEntry(const std::string_view& filename);
+    const Entry* findEntry(const std::string_view& filename);
     std::vector<FullDirEntry> listAllEntriesFrom(const ISO9660LowLevel::DirEntry& entry);
+    void buildIndex();
     ISO9660LowLevel::PVD m_pvd;
+    std::vector<Entry> m_entries;
+    // Keys point into m_entries, which isn't touched anymore once the index is built.
+    std::unordered_map<std::string_view, size_t> m_index;
 };
 
 }  // namespace PCSX
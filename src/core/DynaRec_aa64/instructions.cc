@@ -263,6 +263,7 @@ void DynaRecCPU::recBNE(uint32_t code) {
 void DynaRecCPU::recCOP0(uint32_t code) {
     switch (_Rs_) {  // figure out the type of COP0 opcode
         case 0:
+        case 2:  // CFC0, which the interpreter treats as MFC0
             recMFC0(code);
             break;
         case 4:
@@ -1008,12 +1009,80 @@ void DynaRecCPU::recRFE(uint32_t code) {
     testSoftwareInterrupt<false>();
 }
 
+// Stores $rt to a constant RAM address, through its host pointer. RAM can't be written to while the cache is
+// isolated, so rather than recompiling everything each time the BIOS isolates it, the store checks for it and
+// goes through Memory then.
+void DynaRecCPU::emitRAMStore(int size, uint32_t code, uint32_t address, const void* pointer) {
+    Label isolated, done;
+    if (!m_gprs[_Rt_].isConst()) {
+        allocateReg(_Rt_);
+    }
+
+    gen.Mov(x4, (uintptr_t)&PCSX::g_emulator->m_mem->getBusConfig().ramWritable);
+    gen.Ldrb(w4, MemOperand(x4));
+    gen.Cbz(w4, &isolated);
+    switch (size) {
+        case 8:
+            m_gprs[_Rt_].isConst() ? store<8>(m_gprs[_Rt_].val & 0xFF, pointer)
+                                   : store<8>(m_gprs[_Rt_].allocatedReg, pointer);
+            break;
+        case 16:
+            m_gprs[_Rt_].isConst() ? store<16>(m_gprs[_Rt_].val & 0xFFFF, pointer)
+                                   : store<16>(m_gprs[_Rt_].allocatedReg, pointer);
+            break;
+        case 32:
+            m_gprs[_Rt_].isConst() ? store<32>(m_gprs[_Rt_].val, pointer)
+                                   : store<32>(m_gprs[_Rt_].allocatedReg, pointer);
+            break;
+    }
+    gen.B(&done);
+
+    gen.L(isolated);
+    if (m_gprs[_Rt_].isConst()) {
+        gen.Mov(arg2, m_gprs[_Rt_].val);
+    } else {
+        gen.Mov(arg2, m_gprs[_Rt_].allocatedReg);
+    }
+    gen.Mov(arg1, address);
+
+    // The register allocator state has to stay the same on both paths, so save the volatiles around the call
+    // instead of flushing them. There's an odd amount of them, so xzr pads the last pair to keep sp aligned.
+    const int count = allocateableVolatiles.size();
+    for (int i = 0; i < count; i += 2) {
+        const Register reg = allocateableVolatiles[i].X();
+        const Register reg2 = (i + 1 < count) ? allocateableVolatiles[i + 1].X() : xzr;
+        gen.Stp(reg2, reg, MemOperand(sp, -16, PreIndex));
+    }
+    switch (size) {
+        case 8:
+            emitCall(write8Wrapper);
+            break;
+        case 16:
+            emitCall(write16Wrapper);
+            break;
+        case 32:
+            emitCall(write32Wrapper);
+            break;
+    }
+    for (int i = (count - 1) & ~1; i >= 0; i -= 2) {
+        const Register reg = allocateableVolatiles[i].X();
+        const Register reg2 = (i + 1 < count) ? allocateableVolatiles[i + 1].X() : xzr;
+        gen.Ldp(reg2, reg, MemOperand(sp, 16, PostIndex));
+    }
+    gen.L(done);
+}
+
 void DynaRecCPU::recSB(uint32_t code) {
     if (m_gprs[_Rs_].isConst()) {
         const uint32_t addr = m_gprs[_Rs_].val + _Imm_;
         const auto pointer = PCSX::g_emulator->m_mem->pointerWrite(addr, 8);
 
         if (pointer != nullptr) {
+            if (isRAMPointer(addr)) {
+                emitRAMStore(8, code, addr, pointer);
+                return;
+            }
+
             if (m_gprs[_Rt_].isConst()) {
                 store<8>(m_gprs[_Rt_].val & 0xFF, pointer);
             } else {
@@ -1054,6 +1123,11 @@ void DynaRecCPU::recSH(uint32_t code) {
         const uint32_t addr = m_gprs[_Rs_].val + _Imm_;
         const auto pointer = PCSX::g_emulator->m_mem->pointerWrite(addr, 16);
         if (pointer != nullptr) {
+            if (isRAMPointer(addr)) {
+                emitRAMStore(16, code, addr, pointer);
+                return;
+            }
+
             if (m_gprs[_Rt_].isConst()) {
                 store<16>(m_gprs[_Rt_].val & 0xFFFF, pointer);
             } else {
@@ -1124,6 +1198,11 @@ void DynaRecCPU::recSW(uint32_t code) {
         const uint32_t addr = m_gprs[_Rs_].val + _Imm_;
         const auto pointer = PCSX::g_emulator->m_mem->pointerWrite(addr, 32);
         if (pointer != nullptr) {
+            if (isRAMPointer(addr)) {
+                emitRAMStore(32, code, addr, pointer);
+                return;
+            }
+
             if (m_gprs[_Rt_].isConst()) {
                 store<32>(m_gprs[_Rt_].val, pointer);
             } else {
@@ -117,6 +117,7 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
     bool m_stopCompiling;  // Should we stop compiling code?
     bool m_pcWrittenBack;  // Has the PC been written back already by a jump?
     uint32_t m_ramSize;    // RAM is 2MB on retail units, 8MB on some DTL units (Can be toggled in GUI)
+    uint32_t m_busConfigVersion = 0;  // Version of the memory bus configuration the blocks were compiled against
     const int MAX_BLOCK_SIZE = 50;
 
     enum class RegState { Unknown, Constant };
@@ -178,6 +179,7 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
     void flushRegs();
     void spillRegisterCache();
     void prepareForCall();
+    void emitRAMStore(int size, uint32_t code, uint32_t address, const void* pointer);
     unsigned int m_allocatedRegisters = 0;  // how many registers have been allocated in this block?
 
     // Check if we're executing from valid memory
@@ -225,7 +227,13 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
     virtual bool Init() final;
     virtual void Reset() final;
     virtual void Execute() final {
-        ZoneScoped;         // Tell the Tracy profiler to do its thing
+        ZoneScoped;  // Tell the Tracy profiler to do its thing
+        // Blocks embed pointers resolved through the memory LUTs, so they're stale once the bus layout changes
+        const uint32_t busConfigVersion = PCSX::g_emulator->m_mem->getBusConfig().version;
+        if (busConfigVersion != m_busConfigVersion) {
+            m_busConfigVersion = busConfigVersion;
+            uncompileAll();
+        }
         (*m_dispatcher)();  // Jump to assembly dispatcher
     }
     virtual void Clear(uint32_t Addr, uint32_t Size) final {
@@ -239,7 +247,7 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
 
     virtual void SetPGXPMode(uint32_t pgxpMode) final {
         if (pgxpMode != 0) {
-            throw std::runtime_error("PGXP not supported in x64 JIT");
+            throw std::runtime_error("PGXP not supported in aa64 JIT");
         }
     }
 
@@ -275,6 +283,9 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
         }
     }
 
+    // Whether pointerWrite gave a pointer to RAM for this address, rather than to the scratchpad or an I/O register
+    static bool isRAMPointer(uint32_t address) { return ((address >> 16) & 0x1fff) != 0x1f80; }
+
     // Stores a value of "size" bits from "source" to the given pointer
     template <int size, typename T>
     void store(T source, const void* pointer) {
@@ -297,6 +308,12 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
     template <typename T>
     void call(T& func) {
         prepareForCall();
+        emitCall(func);
+    }
+
+    // Emit a call without touching the register allocator, for callers that keep the volatiles alive themselves
+    template <typename T>
+    void emitCall(T& func) {
         const auto ptr = reinterpret_cast<const void*>(func);
         const int64_t disp = getPCOffset(gen.getCurr<const void*>(), ptr);
 
@@ -0,0 +1,311 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "recompiler.h"
+
+#if defined(DYNAREC_X86_64)
+#include <signal.h>
+#include <string.h>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <ucontext.h>
+#define DYNAREC_FASTMEM_HANDLER
+#endif
+
+// Fastmem accesses are a single host load or store, at base + guest address, padded to the size of a
+// jmp rel32. When one faults, the signal handler overwrites it with a jump to a slow path emitted right
+// after the block, which calls into Memory like the regular path does, and jumps back after the access.
+// Pages only fault for I/O, unmapped areas, and RAM holding compiled code, so this rarely happens.
+// RAM is also read-only while the cache is isolated, and stores patched then are restored afterwards.
+// Like the regular path, each access is charged a cycle, after the access so the slow path doesn't double it.
+
+namespace {
+
+constexpr int c_patchSize = 5;  // Size of jmp rel32
+
+// The CPU running on this thread, for the signal handler to find.
+thread_local DynaRecCPU* s_fastmemCPU = nullptr;
+
+#if defined(DYNAREC_FASTMEM_HANDLER)
+struct sigaction s_previousSegv;
+#if defined(__APPLE__)
+struct sigaction s_previousBus;
+#endif
+
+uintptr_t& hostPC(void* context) {
+    auto ucontext = reinterpret_cast<ucontext_t*>(context);
+#if defined(__APPLE__)
+    return *reinterpret_cast<uintptr_t*>(&ucontext->uc_mcontext->__ss.__rip);
+#else
+    return *reinterpret_cast<uintptr_t*>(&ucontext->uc_mcontext.gregs[REG_RIP]);
+#endif
+}
+
+void faultHandler(int sig, siginfo_t* info, void* context) {
+    auto cpu = s_fastmemCPU;
+    if (cpu && cpu->handleFastmemFault(info->si_addr, hostPC(context))) return;
+
+    // Not ours, hand it over to whoever was there before us.
+#if defined(__APPLE__)
+    const struct sigaction& previous = sig == SIGBUS ? s_previousBus : s_previousSegv;
+#else
+    const struct sigaction& previous = s_previousSegv;
+#endif
+    if (previous.sa_flags & SA_SIGINFO) {
+        previous.sa_sigaction(sig, info, context);
+    } else if ((previous.sa_handler == SIG_DFL) || (previous.sa_handler == SIG_IGN)) {
+        // Returning replays the faulting instruction, which will now crash the regular way.
+        signal(sig, SIG_DFL);
+    } else {
+        previous.sa_handler(sig);
+    }
+}
+
+bool installFaultHandler() {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = faultHandler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGSEGV, &action, &s_previousSegv) != 0) return false;
+#if defined(__APPLE__)
+    // Protection faults are reported as SIGBUS on macOS.
+    if (sigaction(SIGBUS, &action, &s_previousBus) != 0) return false;
+#endif
+    return true;
+}
+#endif
+
+}  // namespace
+
+void DynaRecCPU::initFastmem() {
+    m_fastmemBase = nullptr;
+    m_fastmemPending.clear();
+    m_fastmemSlowPaths.clear();
+    m_fastmemIsolatedPatches.clear();
+#if defined(DYNAREC_FASTMEM_HANDLER)
+    auto& fastMem = PCSX::g_emulator->m_mem->getFastMem();
+    if (!fastMem.enabled()) return;
+    static const bool installed = installFaultHandler();
+    if (installed) m_fastmemBase = fastMem.getBase();
+#endif
+}
+
+void DynaRecCPU::bindFastmem() { s_fastmemCPU = this; }
+
+bool DynaRecCPU::handleFastmemFault(const void* address, uintptr_t& pc) {
+    if (!PCSX::g_emulator->m_mem->getFastMem().contains(address)) return false;
+    const auto slowPath = m_fastmemSlowPaths.find(reinterpret_cast<const uint8_t*>(pc));
+    if (slowPath == m_fastmemSlowPaths.end()) return false;
+
+    // Further runs of this access jump straight to the slow path.
+    auto code = reinterpret_cast<uint8_t*>(pc);
+    if (!PCSX::g_emulator->m_mem->getBusConfig().ramWritable) {
+        std::array<uint8_t, c_patchSize> original;
+        memcpy(original.data(), code, c_patchSize);
+        m_fastmemIsolatedPatches.emplace_back(code, original);
+    }
+    const int32_t displacement = int32_t(slowPath->second - (code + c_patchSize));
+    code[0] = 0xE9;
+    memcpy(code + 1, &displacement, sizeof(displacement));
+    pc = reinterpret_cast<uintptr_t>(slowPath->second);
+    return true;
+}
+
+// Called whenever the LUTs are rebuilt. Once the cache isn't isolated anymore, the accesses which only faulted
+// because of it go back to fastmem. Those which fault for other reasons will simply get patched again.
+void DynaRecCPU::restoreFastmemPatches() {
+    if (m_fastmemIsolatedPatches.empty() || !PCSX::g_emulator->m_mem->getBusConfig().ramWritable) return;
+    for (const auto& [code, original] : m_fastmemIsolatedPatches) {
+        memcpy(code, original.data(), c_patchSize);
+    }
+    m_fastmemIsolatedPatches.clear();
+}
+
+// Loads from the guest address in ecx into dest.
+void DynaRecCPU::emitFastmemLoad(int size, bool signExtend, Reg32 dest) {
+    gen.mov(rax, reinterpret_cast<uintptr_t>(m_fastmemBase));
+    const auto access = gen.getCurr<const uint8_t*>();
+    switch (size) {
+        case 8:
+            signExtend ? gen.movsx(dest, Xbyak::util::byte[rax + rcx]) : gen.movzx(dest, Xbyak::util::byte[rax + rcx]);
+            break;
+        case 16:
+            signExtend ? gen.movsx(dest, word[rax + rcx]) : gen.movzx(dest, word[rax + rcx]);
+            break;
+        case 32:
+            gen.mov(dest, dword[rax + rcx]);
+            break;
+    }
+    const auto length = gen.getCurr<const uint8_t*>() - access;
+    if (length < c_patchSize) gen.nop(c_patchSize - length);
+    gen.add(dword[contextPointer + CYCLE_OFFSET], 1);
+    m_fastmemPending.push_back({access, gen.getCurr<const uint8_t*>(), size, false, signExtend, false, dest, 0});
+}
+
+// Stores $rt to $rs + imm.
+void DynaRecCPU::emitFastmemStore(int size, uint32_t code) {
+    FastmemAccess info;
+    info.size = size;
+    info.store = true;
+    info.signExtend = false;
+    info.constValue = m_gprs[_Rt_].isConst();
+    if (info.constValue) {
+        allocateReg(_Rs_);
+        info.value = m_gprs[_Rt_].val;
+    } else {
+        alloc_rt_rs(code);
+        info.reg = m_gprs[_Rt_].allocatedReg;
+        info.value = 0;
+    }
+    gen.moveAndAdd(ecx, m_gprs[_Rs_].allocatedReg, _Imm_);
+    gen.mov(rax, reinterpret_cast<uintptr_t>(m_fastmemBase));
+
+    info.code = gen.getCurr<const uint8_t*>();
+    switch (size) {
+        case 8:
+            info.constValue ? gen.mov(Xbyak::util::byte[rax + rcx], info.value & 0xFF)
+                            : gen.mov(Xbyak::util::byte[rax + rcx], info.reg.cvt8());
+            break;
+        case 16:
+            info.constValue ? gen.mov(word[rax + rcx], info.value & 0xFFFF)
+                            : gen.mov(word[rax + rcx], info.reg.cvt16());
+            break;
+        case 32:
+            info.constValue ? gen.mov(dword[rax + rcx], info.value) : gen.mov(dword[rax + rcx], info.reg);
+            break;
+    }
+    const auto length = gen.getCurr<const uint8_t*>() - info.code;
+    if (length < c_patchSize) gen.nop(c_patchSize - length);
+    gen.add(dword[contextPointer + CYCLE_OFFSET], 1);
+    info.resume = gen.getCurr<const uint8_t*>();
+    m_fastmemPending.push_back(info);
+}
+
+// Stores $rt to a constant RAM address, through its host pointer. RAM can't be written to while the cache is
+// isolated, so rather than recompiling everything each time the BIOS isolates it, the store checks for it and
+// takes the slow path then. Uses the same slow paths as fastmem, entered through the jcc instead of a patch.
+void DynaRecCPU::emitRAMStore(int size, uint32_t code, uint32_t address, const void* pointer) {
+    FastmemAccess info;
+    info.size = size;
+    info.store = true;
+    info.signExtend = false;
+    info.constValue = m_gprs[_Rt_].isConst();
+    if (info.constValue) {
+        info.value = m_gprs[_Rt_].val;
+    } else {
+        allocateReg(_Rt_);
+        info.reg = m_gprs[_Rt_].allocatedReg;
+        info.value = 0;
+    }
+    gen.mov(ecx, address);
+    gen.mov(rax, reinterpret_cast<uintptr_t>(&PCSX::g_emulator->m_mem->getBusConfig().ramWritable));
+    gen.cmp(Xbyak::util::byte[rax], 0);
+    gen.je(gen.getCurr<const void*>());  // Displacement filled in by emitFastmemSlowPaths
+    info.guard = gen.getCurr<uint8_t*>();
+
+    info.code = gen.getCurr<const uint8_t*>();
+    switch (size) {
+        case 8:
+            info.constValue ? store<8>(info.value & 0xFF, pointer) : store<8>(info.reg.cvt8(), pointer);
+            break;
+        case 16:
+            info.constValue ? store<16>(info.value & 0xFFFF, pointer) : store<16>(info.reg.cvt16(), pointer);
+            break;
+        case 32:
+            info.constValue ? store<32>(info.value, pointer) : store<32>(info.reg, pointer);
+            break;
+    }
+    info.resume = gen.getCurr<const uint8_t*>();
+    m_fastmemPending.push_back(info);
+}
+
+// Emits the slow paths of the accesses of the current block. Needs to be somewhere the block won't run into.
+void DynaRecCPU::emitFastmemSlowPaths() {
+    void* object = PCSX::g_emulator->m_mem.get();
+
+    for (const auto& access : m_fastmemPending) {
+        const auto slowPath = gen.getCurr<const uint8_t*>();
+        if (access.guard) {
+            *reinterpret_cast<int32_t*>(access.guard - 4) = int32_t(slowPath - access.guard);
+        } else {
+            m_fastmemSlowPaths[access.code] = slowPath;
+        }
+
+        // The register allocator state is the one at the access, so save whatever volatile may be live.
+        // There is an even amount of them, so the stack stays aligned.
+        for (const auto reg : allocateableVolatiles) {
+            gen.push(reg.cvt64());
+        }
+        if constexpr (isWindows()) {
+            gen.sub(rsp, 32);
+        }
+
+        if (access.store) {
+            if (access.constValue) {
+                gen.moveImm(arg3, access.value);
+            } else {
+                gen.mov(arg3, access.reg);
+            }
+        } else if (access.size == 32) {
+            gen.xor_(arg3, arg3);  // ReadType::Data
+        }
+        gen.mov(arg2, ecx);
+
+        switch (access.size) {
+            case 8:
+                access.store ? emitMemberFunctionCall(&PCSX::Memory::write8, object)
+                             : emitMemberFunctionCall(&PCSX::Memory::read8, object);
+                break;
+            case 16:
+                access.store ? emitMemberFunctionCall(&PCSX::Memory::write16, object)
+                             : emitMemberFunctionCall(&PCSX::Memory::read16, object);
+                break;
+            case 32:
+                access.store ? emitMemberFunctionCall(&PCSX::Memory::write32, object)
+                             : emitMemberFunctionCall(&PCSX::Memory::read32, object);
+                break;
+        }
+
+        if constexpr (isWindows()) {
+            gen.add(rsp, 32);
+        }
+        if (!access.store) {
+            switch (access.size) {
+                case 8:
+                    access.signExtend ? gen.movsx(eax, al) : gen.movzx(eax, al);
+                    break;
+                case 16:
+                    access.signExtend ? gen.movsx(eax, ax) : gen.movzx(eax, ax);
+                    break;
+            }
+        }
+        for (int i = allocateableVolatiles.size() - 1; i >= 0; i--) {
+            gen.pop(allocateableVolatiles[i].cvt64());
+        }
+        if (!access.store && access.reg != eax) {
+            gen.mov(access.reg, eax);
+        }
+        gen.jmp((void*)access.resume);
+    }
+
+    m_fastmemPending.clear();
+}
+
+#endif  // DYNAREC_X86_64
@@ -685,29 +685,37 @@ void DynaRecCPU::recMULTU(uint32_t code) {
 
 template <int size, bool signExtend>
 void DynaRecCPU::recompileLoadWithDelay(uint32_t code, LoadDelayDependencyType type) {
+    bool fastmem = false;
     if (m_gprs[_Rs_].isConst()) {
         gen.mov(arg2, m_gprs[_Rs_].val + _Imm_);
+    } else if (useFastmem()) {
+        allocateReg(_Rs_);
+        gen.moveAndAdd(ecx, m_gprs[_Rs_].allocatedReg, _Imm_);
+        emitFastmemLoad(size, signExtend, eax);
+        fastmem = true;
     } else {
         allocateReg(_Rs_);
         gen.moveAndAdd(arg2, m_gprs[_Rs_].allocatedReg, _Imm_);
     }
 
-    switch (size) {
-        case 8:
-            callMemoryFunc(&PCSX::Memory::read8);
-            break;
-        case 16:
-            callMemoryFunc(&PCSX::Memory::read16);
-            break;
-        case 32:
-            callMemoryFunc(&PCSX::Memory::read32);
-            break;
+    if (!fastmem) {
+        switch (size) {
+            case 8:
+                callMemoryFunc(&PCSX::Memory::read8);
+                break;
+            case 16:
+                callMemoryFunc(&PCSX::Memory::read16);
+                break;
+            case 32:
+                callMemoryFunc(&PCSX::Memory::read32);
+                break;
+        }
     }
 
     if (_Rt_) {
         m_delayedLoadInfo[m_currentDelayedLoad].active = true;
 
-        switch (size) {
+        switch (fastmem ? 32 : size) {  // Fastmem loads come extended already
             case 8:
                 signExtend ? gen.movsx(eax, al) : gen.movzx(eax, al);
                 break;
@@ -749,7 +757,7 @@ void DynaRecCPU::recompileLoad(uint32_t code) {
         const uint32_t addr = m_gprs[_Rs_].val + _Imm_;
         const auto pointer = PCSX::g_emulator->m_mem->pointerRead(addr);
 
-        if (pointer != nullptr && (_Rt_) != 0) {
+        if (pointer != nullptr && (_Rt_) != 0 && !isWatched(addr)) {
             allocateRegWithoutLoad(_Rt_);
             m_gprs[_Rt_].setWriteback(true);
             load<size, signExtend>(m_gprs[_Rt_].allocatedReg, pointer);
@@ -757,6 +765,17 @@ void DynaRecCPU::recompileLoad(uint32_t code) {
         }
 
         gen.mov(arg2, addr);
+    } else if (useFastmem()) {
+        allocateReg(_Rs_);
+        gen.moveAndAdd(ecx, m_gprs[_Rs_].allocatedReg, _Imm_);
+        if (_Rt_) {
+            allocateRegWithoutLoad(_Rt_);
+            m_gprs[_Rt_].setWriteback(true);
+            emitFastmemLoad(size, signExtend, m_gprs[_Rt_].allocatedReg);
+        } else {
+            emitFastmemLoad(size, signExtend, eax);  // Still needs to happen, in case it's a read with side effects
+        }
+        return;
     } else {
         allocateReg(_Rs_);
         gen.moveAndAdd(arg2, m_gprs[_Rs_].allocatedReg, _Imm_);
@@ -987,9 +1006,14 @@ void DynaRecCPU::recLWR(uint32_t code) {
 void DynaRecCPU::recSB(uint32_t code) {
     if (m_gprs[_Rs_].isConst()) {
         const uint32_t addr = m_gprs[_Rs_].val + _Imm_;
-        const auto pointer = PCSX::g_emulator->m_mem->pointerWrite(addr, 8);
+        const auto pointer = isWatched(addr) ? nullptr : PCSX::g_emulator->m_mem->pointerWrite(addr, 8);
 
         if (pointer != nullptr) {
+            if (isRAMPointer(addr)) {
+                emitRAMStore(8, code, addr, pointer);
+                return;
+            }
+
             if (m_gprs[_Rt_].isConst()) {
                 store<8>(m_gprs[_Rt_].val & 0xFF, pointer);
             } else {
@@ -1011,6 +1035,10 @@ void DynaRecCPU::recSB(uint32_t code) {
         callMemoryFunc(&PCSX::Memory::write8);
     }
 
+    else if (useFastmem()) {
+        emitFastmemStore(8, code);
+    }
+
     else {
         if (m_gprs[_Rt_].isConst()) {  // Full 32-bit value to write in arg3
             gen.moveImm(arg3, m_gprs[_Rt_].val);
@@ -1028,8 +1056,13 @@ void DynaRecCPU::recSB(uint32_t code) {
 void DynaRecCPU::recSH(uint32_t code) {
     if (m_gprs[_Rs_].isConst()) {
         const uint32_t addr = m_gprs[_Rs_].val + _Imm_;
-        const auto pointer = PCSX::g_emulator->m_mem->pointerWrite(addr, 16);
+        const auto pointer = isWatched(addr) ? nullptr : PCSX::g_emulator->m_mem->pointerWrite(addr, 16);
         if (pointer != nullptr) {
+            if (isRAMPointer(addr)) {
+                emitRAMStore(16, code, addr, pointer);
+                return;
+            }
+
             if (m_gprs[_Rt_].isConst()) {
                 store<16>(m_gprs[_Rt_].val & 0xFFFF, pointer);
             } else {
@@ -1040,7 +1073,7 @@ void DynaRecCPU::recSH(uint32_t code) {
             return;
         }
 
-        else if (addr == 0x1f801070) {  // I_STAT
+        else if (addr == 0x1f801070 && !isWatched(addr)) {  // I_STAT
             gen.mov(rax, (uint64_t)&PCSX::g_emulator->m_mem->m_hard[0x1070]);
             if (m_gprs[_Rt_].isConst()) {
                 // Doing an AND directly seems to make Xbyak throw an exception due to the immediate being too big.
@@ -1055,7 +1088,7 @@ void DynaRecCPU::recSH(uint32_t code) {
             return;
         }
 
-        else if (addr >= 0x1f801c00 && addr < 0x1f801e00) {  // SPU registers
+        else if (addr >= 0x1f801c00 && addr < 0x1f801e00 && !isWatched(addr)) {  // SPU registers
             gen.mov(arg1, addr);
             if (m_gprs[_Rt_].isConst()) {
                 gen.moveImm(arg2, m_gprs[_Rt_].val & 0xFFFF);
@@ -1079,6 +1112,10 @@ void DynaRecCPU::recSH(uint32_t code) {
         callMemoryFunc(&PCSX::Memory::write16);
     }
 
+    else if (useFastmem()) {
+        emitFastmemStore(16, code);
+    }
+
     else {
         if (m_gprs[_Rt_].isConst()) {  // Full 32-bit value to write in arg3
             gen.moveImm(arg3, m_gprs[_Rt_].val);
@@ -1096,8 +1133,13 @@ void DynaRecCPU::recSH(uint32_t code) {
 void DynaRecCPU::recSW(uint32_t code) {
     if (m_gprs[_Rs_].isConst()) {
         const uint32_t addr = m_gprs[_Rs_].val + _Imm_;
-        const auto pointer = PCSX::g_emulator->m_mem->pointerWrite(addr, 32);
+        const auto pointer = isWatched(addr) ? nullptr : PCSX::g_emulator->m_mem->pointerWrite(addr, 32);
         if (pointer != nullptr) {
+            if (isRAMPointer(addr)) {
+                emitRAMStore(32, code, addr, pointer);
+                return;
+            }
+
             if (m_gprs[_Rt_].isConst()) {
                 store<32>(m_gprs[_Rt_].val, pointer);
             } else {
@@ -1119,6 +1161,10 @@ void DynaRecCPU::recSW(uint32_t code) {
         callMemoryFunc(&PCSX::Memory::write32);
     }
 
+    else if (useFastmem()) {
+        emitFastmemStore(32, code);
+    }
+
     else {
         if (m_gprs[_Rt_].isConst()) {  // Value to write in arg3
             gen.moveImm(arg3, m_gprs[_Rt_].val);
@@ -1151,7 +1197,7 @@ void DynaRecCPU::recSWL(uint32_t code) {
 
         gen.mov(arg1, alignedAddress);  // Address in arg2 again
         gen.mov(arg2, eax);             // Address to write to in arg2
-        call(write32Wrapper);
+        callWrite32Wrapper();
     } else if (m_gprs[_Rs_].isConst()) {  // Only address is constant
         const uint32_t address = m_gprs[_Rs_].val + _Imm_;
         const uint32_t alignedAddress = address & ~3;
@@ -1167,7 +1213,7 @@ void DynaRecCPU::recSWL(uint32_t code) {
         gen.mov(arg2, m_gprs[_Rt_].allocatedReg);                // Move rt to arg2
         gen.shr(arg2, shift);                                    // Shift rt value
         gen.or_(arg2, eax);                                      // Or with read value
-        call(write32Wrapper);                                    // Write back
+        callWrite32Wrapper();                                    // Write back
     } else if (m_gprs[_Rt_].isConst()) {                         // Only previous rt value is constant
         allocateReg(_Rs_);                                       // Allocate address reg
         gen.moveAndAdd(arg1, m_gprs[_Rs_].allocatedReg, _Imm_);  // Address in arg1
@@ -1201,7 +1247,7 @@ void DynaRecCPU::recSWL(uint32_t code) {
             gen.mov(arg1, arg4);
         }
 
-        call(write32Wrapper);
+        callWrite32Wrapper();
     } else {                                                     // Nothing is constant
         allocateReg(_Rs_);                                       // Allocate address reg
         gen.moveAndAdd(arg1, m_gprs[_Rs_].allocatedReg, _Imm_);  // Address in arg1
@@ -1235,7 +1281,7 @@ void DynaRecCPU::recSWL(uint32_t code) {
             gen.mov(arg1, arg4);
         }
 
-        call(write32Wrapper);
+        callWrite32Wrapper();
     }
 }
 
@@ -1257,7 +1303,7 @@ void DynaRecCPU::recSWR(uint32_t code) {
 
         gen.mov(arg1, alignedAddress);  // Address in arg2 again
         gen.mov(arg2, eax);             // Address to write to in arg2
-        call(write32Wrapper);
+        callWrite32Wrapper();
     } else if (m_gprs[_Rs_].isConst()) {  // Only address is constant
         const uint32_t address = m_gprs[_Rs_].val + _Imm_;
         const uint32_t alignedAddress = address & ~3;
@@ -1273,7 +1319,7 @@ void DynaRecCPU::recSWR(uint32_t code) {
         gen.mov(arg2, m_gprs[_Rt_].allocatedReg);                // Move rt to arg2
         gen.shlImm(arg2, shift);                                 // Shift rt value
         gen.or_(arg2, eax);                                      // Or with read value
-        call(write32Wrapper);                                    // Write back
+        callWrite32Wrapper();                                    // Write back
     } else if (m_gprs[_Rt_].isConst()) {                         // Only previous rt value is constant
         allocateReg(_Rs_);                                       // Allocate address reg
         gen.moveAndAdd(arg1, m_gprs[_Rs_].allocatedReg, _Imm_);  // Address in arg1
@@ -1307,7 +1353,7 @@ void DynaRecCPU::recSWR(uint32_t code) {
             gen.mov(arg1, arg4);
         }
 
-        call(write32Wrapper);
+        callWrite32Wrapper();
     } else {                                                     // Nothing is constant
         allocateReg(_Rs_);                                       // Allocate address reg
         gen.moveAndAdd(arg1, m_gprs[_Rs_].allocatedReg, _Imm_);  // Address in arg1
@@ -1341,13 +1387,14 @@ void DynaRecCPU::recSWR(uint32_t code) {
             gen.mov(arg1, arg4);
         }
 
-        call(write32Wrapper);
+        callWrite32Wrapper();
     }
 }
 
 void DynaRecCPU::recCOP0(uint32_t code) {
     switch (_Rs_) {  // figure out the type of COP0 opcode
         case 0:
+        case 2:  // CFC0, which the interpreter treats as MFC0
             recMFC0(code);
             break;
         case 4:
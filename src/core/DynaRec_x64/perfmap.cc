@@ -0,0 +1,172 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "perfmap.h"
+
+#if defined(DYNAREC_X86_64)
+#if defined(__linux__)
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "fmt/format.h"
+
+#if defined(__linux__)
+namespace {
+
+// See tools/perf/Documentation/jitdump-specification.txt in the Linux tree
+struct JitDumpHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t totalSize;
+    uint32_t elfMach;
+    uint32_t pad1;
+    uint32_t pid;
+    uint64_t timestamp;
+    uint64_t flags;
+};
+
+struct JitDumpRecordHeader {
+    uint32_t id;
+    uint32_t totalSize;
+    uint64_t timestamp;
+};
+
+struct JitDumpCodeLoad {
+    JitDumpRecordHeader header;
+    uint32_t pid;
+    uint32_t tid;
+    uint64_t vma;
+    uint64_t codeAddr;
+    uint64_t codeSize;
+    uint64_t codeIndex;
+};
+
+constexpr uint32_t c_jitDumpMagic = 0x4a695444;
+constexpr uint32_t c_jitCodeLoad = 0;
+constexpr uint32_t c_jitCodeClose = 3;
+
+// perf matches the samples against the timestamps of the entries, and defaults to the monotonic clock for this.
+uint64_t timestamp() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+}  // namespace
+#endif
+
+bool PerfMap::open(bool perfMap, bool jitDump) {
+    close();
+#if defined(__linux__)
+    if (perfMap) {
+        // Appending, as perf expects a single map per process, and the CPU may get re-initialized.
+        m_perfMap = fopen(fmt::format("/tmp/perf-{}.map", getpid()).c_str(), "a");
+    }
+    if (jitDump) openJitDump();
+#endif
+    return enabled();
+}
+
+void PerfMap::openJitDump() {
+#if defined(__linux__)
+    const auto path = fmt::format("/tmp/jit-{}.dump", getpid());
+    int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0666);
+    if (fd < 0) return;
+
+    // perf record only finds the dump through an executable mapping of it showing up in the trace.
+    m_jitDumpMarker = mmap(nullptr, sysconf(_SC_PAGESIZE), PROT_READ | PROT_EXEC, MAP_PRIVATE, fd, 0);
+    if (m_jitDumpMarker == MAP_FAILED) {
+        m_jitDumpMarker = nullptr;
+        ::close(fd);
+        return;
+    }
+    m_jitDump = fdopen(fd, "wb");
+    if (!m_jitDump) {
+        ::close(fd);
+        return;
+    }
+
+    JitDumpHeader header;
+    header.magic = c_jitDumpMagic;
+    header.version = 1;
+    header.totalSize = sizeof(header);
+    header.elfMach = EM_X86_64;
+    header.pad1 = 0;
+    header.pid = getpid();
+    header.timestamp = timestamp();
+    header.flags = 0;
+    fwrite(&header, sizeof(header), 1, m_jitDump);
+#endif
+}
+
+void PerfMap::close() {
+#if defined(__linux__)
+    if (m_perfMap) {
+        fclose(m_perfMap);
+        m_perfMap = nullptr;
+    }
+    if (m_jitDump) {
+        JitDumpRecordHeader record;
+        record.id = c_jitCodeClose;
+        record.totalSize = sizeof(record);
+        record.timestamp = timestamp();
+        fwrite(&record, sizeof(record), 1, m_jitDump);
+        fclose(m_jitDump);
+        m_jitDump = nullptr;
+    }
+    if (m_jitDumpMarker) {
+        munmap(m_jitDumpMarker, sysconf(_SC_PAGESIZE));
+        m_jitDumpMarker = nullptr;
+    }
+#endif
+}
+
+void PerfMap::addCode(const void* code, size_t size, std::string_view name) {
+    if (size == 0) return;
+#if defined(__linux__)
+    if (m_perfMap) {
+        fmt::print(m_perfMap, "{:x} {:x} {}\n", uintptr_t(code), size, name);
+        // Blocks are only compiled once in a while, and this keeps the map usable if we don't exit cleanly.
+        fflush(m_perfMap);
+    }
+    if (m_jitDump) {
+        JitDumpCodeLoad record;
+        record.header.id = c_jitCodeLoad;
+        record.header.totalSize = sizeof(record) + name.size() + 1 + size;
+        record.header.timestamp = timestamp();
+        record.pid = getpid();
+        record.tid = syscall(SYS_gettid);
+        record.vma = uintptr_t(code);
+        record.codeAddr = uintptr_t(code);
+        record.codeSize = size;
+        record.codeIndex = m_codeIndex++;
+        fwrite(&record, sizeof(record), 1, m_jitDump);
+        fwrite(name.data(), name.size(), 1, m_jitDump);
+        fputc(0, m_jitDump);
+        fwrite(code, size, 1, m_jitDump);
+        fflush(m_jitDump);
+    }
+#endif
+}
+#endif  // DYNAREC_X86_64
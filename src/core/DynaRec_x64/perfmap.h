@@ -0,0 +1,52 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include "core/r3000a.h"
+#if defined(DYNAREC_X86_64)
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string_view>
+
+// Describes the code we emit to host profilers, which otherwise only see an anonymous executable mapping.
+// Two formats are supported, both only on Linux:
+//  - /tmp/perf-<pid>.map, which `perf report` reads as is. It can't express code going away, so
+//    when the code buffer is reused, old and new blocks overlap in it.
+//  - /tmp/jit-<pid>.dump, the jitdump format. Each entry is timestamped and carries a copy of the code,
+//    so reused addresses are attributed correctly. Record with `perf record -k mono`, then run
+//    `perf inject --jit` on the result before reporting.
+class PerfMap {
+  public:
+    ~PerfMap() { close(); }
+    bool open(bool perfMap, bool jitDump);
+    void close();
+    bool enabled() const { return m_perfMap || m_jitDump; }
+    void addCode(const void* code, size_t size, std::string_view name);
+
+  private:
+    void openJitDump();
+
+    FILE* m_perfMap = nullptr;
+    FILE* m_jitDump = nullptr;
+    void* m_jitDumpMarker = nullptr;
+    uint64_t m_codeIndex = 0;
+};
+#endif  // DYNAREC_X86_64
@@ -0,0 +1,266 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "recompiler.h"
+
+#if defined(DYNAREC_X86_64)
+#include "core/pgxp_cpu.h"
+#include "core/pgxp_gte.h"
+
+#define COP2_DATA_OFFSET(reg) ((uintptr_t)&m_regs.CP2D.r[(reg)] - (uintptr_t)this)
+#define COP2_CONTROL_OFFSET(reg) ((uintptr_t)&m_regs.CP2C.r[(reg)] - (uintptr_t)this)
+#define PGXP_OPERAND_OFFSET(field) ((uintptr_t)&m_pgxpOperands.field - (uintptr_t)this)
+
+// The arguments mirror the ones the interpreter passes: values named after the destination of the
+// instruction are read once it ran, and the sources are the ones saved right before it did.
+#define PGXP_HANDLER(call)                                                                                        \
+    [](const PGXPOperands& before, const PCSX::psxRegisters& regs, uint32_t code, uint32_t result) { call; }
+
+// Returns the handler to call after the instruction, or nullptr if the current PGXP mode doesn't track it.
+DynaRecCPU::PGXPHandler DynaRecCPU::pgxpHandler(uint32_t code) {
+    const bool full = m_pgxpMode == 2;
+    switch (code >> 26) {
+        case 0x00:
+            if (!full) return nullptr;
+            switch (code & 0x3f) {
+                case 0x00:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_SLL(code, regs.GPR.r[_Rd_], before.rt));
+                case 0x02:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_SRL(code, regs.GPR.r[_Rd_], before.rt));
+                case 0x03:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_SRA(code, regs.GPR.r[_Rd_], before.rt));
+                case 0x04:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_SLLV(code, regs.GPR.r[_Rd_], before.rt, before.rs));
+                case 0x06:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_SRLV(code, regs.GPR.r[_Rd_], before.rt, before.rs));
+                case 0x07:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_SRAV(code, regs.GPR.r[_Rd_], before.rt, before.rs));
+                case 0x10:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_MFHI(code, regs.GPR.r[_Rd_], regs.GPR.n.hi));
+                case 0x11:
+                    return PGXP_HANDLER(PGXP_CPU_MTHI(code, regs.GPR.n.hi, before.rd));
+                case 0x12:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_MFLO(code, regs.GPR.r[_Rd_], regs.GPR.n.lo));
+                case 0x13:
+                    return PGXP_HANDLER(PGXP_CPU_MTLO(code, regs.GPR.n.lo, before.rd));
+                case 0x18:
+                    return PGXP_HANDLER(PGXP_CPU_MULT(code, regs.GPR.n.hi, regs.GPR.n.lo, before.rs, before.rt));
+                case 0x19:
+                    return PGXP_HANDLER(PGXP_CPU_MULTU(code, regs.GPR.n.hi, regs.GPR.n.lo, before.rs, before.rt));
+                case 0x1a:
+                    return PGXP_HANDLER(PGXP_CPU_DIV(code, regs.GPR.n.hi, regs.GPR.n.lo, before.rs, before.rt));
+                case 0x1b:
+                    return PGXP_HANDLER(PGXP_CPU_DIVU(code, regs.GPR.n.hi, regs.GPR.n.lo, before.rs, before.rt));
+                case 0x20:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_ADD(code, regs.GPR.r[_Rd_], before.rs, before.rt));
+                case 0x21:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_ADDU(code, regs.GPR.r[_Rd_], before.rs, before.rt));
+                case 0x22:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_SUB(code, regs.GPR.r[_Rd_], before.rs, before.rt));
+                case 0x23:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_SUBU(code, regs.GPR.r[_Rd_], before.rs, before.rt));
+                case 0x24:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_AND(code, regs.GPR.r[_Rd_], before.rs, before.rt));
+                case 0x25:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_OR(code, regs.GPR.r[_Rd_], before.rs, before.rt));
+                case 0x26:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_XOR(code, regs.GPR.r[_Rd_], before.rs, before.rt));
+                case 0x27:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_NOR(code, regs.GPR.r[_Rd_], before.rs, before.rt));
+                case 0x2a:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_SLT(code, regs.GPR.r[_Rd_], before.rs, before.rt));
+                case 0x2b:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CPU_SLTU(code, regs.GPR.r[_Rd_], before.rs, before.rt));
+            }
+            return nullptr;
+
+        case 0x08:
+        case 0x09:
+        case 0x0a:
+        case 0x0b:
+        case 0x0c:
+        case 0x0d:
+        case 0x0e:
+        case 0x0f:
+            if (!full || !_Rt_) return nullptr;
+            switch (code >> 26) {
+                case 0x08:
+                    return PGXP_HANDLER(PGXP_CPU_ADDI(code, regs.GPR.r[_Rt_], before.rs));
+                case 0x09:
+                    return PGXP_HANDLER(PGXP_CPU_ADDIU(code, regs.GPR.r[_Rt_], before.rs));
+                case 0x0a:
+                    return PGXP_HANDLER(PGXP_CPU_SLTI(code, regs.GPR.r[_Rt_], before.rs));
+                case 0x0b:
+                    return PGXP_HANDLER(PGXP_CPU_SLTIU(code, regs.GPR.r[_Rt_], before.rs));
+                case 0x0c:
+                    return PGXP_HANDLER(PGXP_CPU_ANDI(code, regs.GPR.r[_Rt_], before.rs));
+                case 0x0d:
+                    return PGXP_HANDLER(PGXP_CPU_ORI(code, regs.GPR.r[_Rt_], before.rs));
+                case 0x0e:
+                    return PGXP_HANDLER(PGXP_CPU_XORI(code, regs.GPR.r[_Rt_], before.rs));
+                default:
+                    return PGXP_HANDLER(PGXP_CPU_LUI(code, regs.GPR.r[_Rt_]));
+            }
+
+        case 0x10:  // COP0
+            switch (_Rs_) {
+                case 0:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CP0_MFC0(code, result, before.cop0));
+                case 2:
+                    if (!_Rd_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CP0_CFC0(code, result, before.cop0));
+                case 4:
+                    if (!_Rt_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CP0_MTC0(code, regs.CP0.r[_Rd_], before.rt));
+                case 6:
+                    if (!_Rt_) return nullptr;
+                    return PGXP_HANDLER(PGXP_CP0_CTC0(code, regs.CP0.r[_Rd_], before.rt));
+                case 16:
+                    return PGXP_HANDLER(PGXP_CP0_RFE(code));
+            }
+            return nullptr;
+
+        case 0x12:  // COP2 moves, the GTE operations themselves are tracked by the GTE
+            switch (_Rs_) {
+                case 0:
+                    if (!_Rt_) return nullptr;
+                    return PGXP_HANDLER(PGXP_GTE_MFC2(code, result, before.cop2d));
+                case 2:
+                    if (!_Rt_) return nullptr;
+                    return PGXP_HANDLER(PGXP_GTE_CFC2(code, result, before.cop2c));
+                case 4:
+                    return PGXP_HANDLER(PGXP_GTE_MTC2(code, regs.CP2D.r[_Rd_], before.rt));
+                case 6:
+                    return PGXP_HANDLER(PGXP_GTE_CTC2(code, regs.CP2C.r[_Rd_], before.rt));
+            }
+            return nullptr;
+
+        case 0x20:
+            return PGXP_HANDLER(PGXP_CPU_LB(code, result, before.rs + _Imm_));
+        case 0x21:
+            return PGXP_HANDLER(PGXP_CPU_LH(code, result, before.rs + _Imm_));
+        case 0x22:
+            return PGXP_HANDLER(PGXP_CPU_LWL(code, result, before.rs + _Imm_));
+        case 0x23:
+            return PGXP_HANDLER(PGXP_CPU_LW(code, result, before.rs + _Imm_));
+        case 0x24:
+            return PGXP_HANDLER(PGXP_CPU_LBU(code, result, before.rs + _Imm_));
+        case 0x25:
+            return PGXP_HANDLER(PGXP_CPU_LHU(code, result, before.rs + _Imm_));
+        case 0x26:
+            return PGXP_HANDLER(PGXP_CPU_LWR(code, result, before.rs + _Imm_));
+        case 0x28:
+            return PGXP_HANDLER(PGXP_CPU_SB(code, regs.GPR.r[_Rt_], before.rs + _Imm_));
+        case 0x29:
+            return PGXP_HANDLER(PGXP_CPU_SH(code, regs.GPR.r[_Rt_], before.rs + _Imm_));
+        case 0x2a:
+            return PGXP_HANDLER(PGXP_CPU_SWL(code, regs.GPR.r[_Rt_], before.rs + _Imm_));
+        case 0x2b:
+            return PGXP_HANDLER(PGXP_CPU_SW(code, regs.GPR.r[_Rt_], before.rs + _Imm_));
+        case 0x2e:
+            return PGXP_HANDLER(PGXP_CPU_SWR(code, regs.GPR.r[_Rt_], before.rs + _Imm_));
+        case 0x32:
+            return PGXP_HANDLER(PGXP_GTE_LWC2(code, regs.CP2D.r[_Rt_], before.rs + _Imm_));
+        case 0x3a:
+            return PGXP_HANDLER(PGXP_GTE_SWC2(code, regs.CP2D.r[_Rt_], before.rs + _Imm_));
+    }
+    return nullptr;
+}
+
+// Save the sources of the instruction, which it may overwrite. This is only a few moves,
+// the registers stay where they are.
+void DynaRecCPU::emitPGXPSave(uint32_t code) {
+    const auto saveGPR = [this](uintptr_t offset, int reg) {
+        if (m_gprs[reg].isConst()) {
+            gen.mov(dword[contextPointer + offset], m_gprs[reg].val);
+        } else if (m_gprs[reg].isAllocated()) {
+            gen.mov(dword[contextPointer + offset], m_gprs[reg].allocatedReg);
+        } else {
+            gen.mov(eax, dword[contextPointer + GPR_OFFSET(reg)]);
+            gen.mov(dword[contextPointer + offset], eax);
+        }
+    };
+    const auto saveMemory = [this](uintptr_t offset, uintptr_t source) {
+        gen.mov(eax, dword[contextPointer + source]);
+        gen.mov(dword[contextPointer + offset], eax);
+    };
+
+    saveGPR(PGXP_OPERAND_OFFSET(rs), _Rs_);
+    saveGPR(PGXP_OPERAND_OFFSET(rt), _Rt_);
+    saveGPR(PGXP_OPERAND_OFFSET(rd), _Rd_);
+    switch (code >> 26) {
+        case 0x10:
+            saveMemory(PGXP_OPERAND_OFFSET(cop0), COP0_OFFSET(_Rd_));
+            break;
+        case 0x12:
+            saveMemory(PGXP_OPERAND_OFFSET(cop2d), COP2_DATA_OFFSET(_Rd_));
+            saveMemory(PGXP_OPERAND_OFFSET(cop2c), COP2_CONTROL_OFFSET(_Rd_));
+            break;
+    }
+}
+
+void DynaRecCPU::emitPGXPCall(PGXPHandler handler, uint32_t code) {
+    // The instructions the interpreter hands to PGXP through pgxpLoadedValue(): loads, and moves from
+    // coprocessors, whose value may still sit in a load delay slot instead of $rt. Out of those, LWL,
+    // LWR and the COP0 moves always write $rt right away here, which then already holds that value.
+    const uint32_t* result = &m_regs.GPR.r[_Rt_];
+    const uint32_t op = code >> 26;
+    const bool loaded = (op >= 0x20 && op <= 0x26) || ((op == 0x10 || op == 0x12) && (_Rs_ == 0 || _Rs_ == 2));
+    const bool immediate = op == 0x22 || op == 0x26 || op == 0x10;
+    if (loaded && !immediate) {
+        switch (getLoadDelayDependencyType(_Rt_)) {
+            case LoadDelayDependencyType::DependencyInsideBlock:
+                result = &m_delayedLoadInfo[m_currentDelayedLoad].value;
+                break;
+            case LoadDelayDependencyType::DependencyAcrossBlocks:
+                result = &m_runtimeLoadDelay.value;
+                break;
+            default:
+                break;
+        }
+    }
+
+    writebackRegs();  // The handler reads the results from the guest registers
+    loadThisPointer(arg1.cvt64());
+    gen.mov(arg2, code);
+    gen.mov(arg3.cvt64(), reinterpret_cast<uintptr_t>(handler));
+    loadAddress(arg4.cvt64(), const_cast<uint32_t*>(result));
+    call(pgxpWrapper);
+}
+
+#endif  // DYNAREC_X86_64
@@ -67,6 +67,10 @@ bool DynaRecCPU::Init() {
         PCSX::g_system->message("[Dynarec] Failed to allocate executable memory.\nTry disabling the Dynarec CPU.");
         return false;
     }
+    const auto& debugSettings = PCSX::g_emulator->settings.get<PCSX::Emulator::SettingDebugSettings>();
+    m_perfMap.open(debugSettings.get<PCSX::Emulator::DebugSettings::PerfMap>(),
+                   debugSettings.get<PCSX::Emulator::DebugSettings::JitDump>());
+    initFastmem();
     emitDispatcher();  // Emit our assembly dispatcher
     uncompileAll();    // Mark all blocks as uncompiled
 
@@ -93,6 +97,7 @@ void DynaRecCPU::Shutdown() {
     delete[] m_ramBlocks;
     delete[] m_biosBlocks;
     delete[] m_dummyBlocks;
+    m_perfMap.close();
 
     if constexpr (ENABLE_SYMBOLS) {
         std::ofstream out("DynarecOutput.map");
@@ -110,6 +115,7 @@ void DynaRecCPU::Reset() {
     R3000Acpu::Reset();  // Reset CPU registers
     Shutdown();          // Deinit and re-init dynarec
     Init();
+    m_breakpointResumePC.reset();
 }
 
 std::unique_ptr<PCSX::R3000Acpu> PCSX::Cpus::getDynaRec() { return std::unique_ptr<PCSX::R3000Acpu>(new DynaRecCPU()); }
@@ -144,10 +150,68 @@ void DynaRecCPU::uncompileAll() {
     for (auto i = 0; i < biosSize / 4; i++) {  // Mark all BIOS blocks as uncompiled
         m_biosBlocks[i] = m_uncompiledBlock;
     }
+    if (m_fastmemBase) PCSX::g_emulator->m_mem->getFastMem().unprotectCode();  // No more code to guard
+}
+
+// Throw away all compiled code if it was built for different breakpoints than the current ones.
+// Breakpoints are compiled in only when the debugger is enabled, same as the interpreter only checks them then.
+// Same goes for a different bus configuration, as blocks embed pointers resolved through the memory LUTs.
+void DynaRecCPU::syncDebugState() {
+    const auto& debug = PCSX::g_emulator->m_debug;
+    const auto& bus = PCSX::g_emulator->m_mem->getBusConfig();
+    const bool enabled = bus.debug;
+    const bool watchpoints = enabled && debug->hasWatchpoints();
+    const uint32_t version = debug->breakpointsVersion();
+
+    if (enabled == m_debugBreakpoints && watchpoints == m_watchpoints &&
+        (!enabled || version == m_breakpointsVersion) && bus.version == m_busConfigVersion) {
+        return;
+    }
+    m_debugBreakpoints = enabled;
+    m_watchpoints = watchpoints;
+    m_breakpointsVersion = version;
+    m_busConfigVersion = bus.version;
+    uncompileAll();
+}
+
+// Called at the start of a block which has an exec breakpoint. Returns true if emulation got paused,
+// in which case the block needs to be left right away, and re-entered once emulation is resumed.
+bool DynaRecCPU::checkBlockBreakpoint() {
+    const uint32_t pc = m_regs.pc;
+    const bool resuming = m_breakpointResumePC == pc;
+    m_breakpointResumePC.reset();
+    if (resuming) return false;
+
+    PCSX::g_emulator->m_debug->checkExecBreakpoint(pc);
+    if (PCSX::g_system->running()) return false;
+    m_breakpointResumePC = pc;
+    return true;
+}
+
+// Called for an exec breakpoint where the block can't be split, such as in a delay slot.
+// The pc isn't up to date in the middle of a block, so present the debugger with the right one.
+// If this pauses emulation, it only takes effect once the block is done, so the instruction and the rest of the
+// block still run: for a delay slot, emulation stops at the branch target. Stopping right on the delay slot would
+// require resuming in the middle of a branch, which compiled blocks can't do.
+void DynaRecCPU::checkBreakpoint(uint32_t pc) {
+    const uint32_t blockPC = m_regs.pc;
+    m_regs.pc = pc;
+    PCSX::g_emulator->m_debug->checkExecBreakpoint(pc);
+    m_regs.pc = blockPC;
+}
+
+void DynaRecCPU::emitBreakpointCheck() {
+    flushRegs();  // Let the debugger see up to date registers
+    loadThisPointer(arg1.cvt64());
+    gen.mov(arg2, m_pc);
+    call(breakpointWrapper);
+    m_blockMayPause = true;
 }
 
 void DynaRecCPU::flushCache() {
     gen.reset();       // Reset the emitter's code pointer and code size variables
+    m_fastmemSlowPaths.clear();
+    m_fastmemIsolatedPatches.clear();
     emitDispatcher();  // Re-emit dispatcher
     uncompileAll();    // Mark all blocks as uncompiled
 }
@@ -309,6 +373,10 @@ void DynaRecCPU::emitDispatcher() {
     gen.mov(arg2, 1);                   // Fully emulate load delays
     gen.callFunc(recRecompileWrapper);  // Call recompilation function. Returns pointer to emitted code
     gen.jmp(rax);
+
+    if (m_perfMap.enabled()) {
+        addPerfMapStubs(gen.getCurr<const uint8_t*>());
+    }
 }
 
 // Compile a block, write address of compiled code to *callback
@@ -324,6 +392,8 @@ DynarecCallback DynaRecCPU::recompile(uint32_t pc, bool fullLoadDelayEmulation,
     m_pc = pc & ~3;
     m_firstInstruction = true;
     m_fullLoadDelayEmulation = fullLoadDelayEmulation;
+    m_blockMayPause = false;
+    m_fastmemPending.clear();
     auto& memory = PCSX::g_emulator->m_mem;
 
     // If we somehow ended up compiling a block at an invalid PC, throw an error.
@@ -340,6 +410,7 @@ DynarecCallback DynaRecCPU::recompile(uint32_t pc, bool fullLoadDelayEmulation,
     if (gen.getSize() > codeCacheSize) {  // Flush JIT cache if we've gone above the acceptable size
         flushCache();
     }
+    const auto blockStart = gen.getCurr<const uint8_t*>();
 
     if constexpr (ENABLE_SYMBOLS) {
         m_symbols += fmt::format("{} recompile_{:08X}\n", gen.getCurr<void*>(), m_pc);
@@ -362,6 +433,14 @@ DynarecCallback DynaRecCPU::recompile(uint32_t pc, bool fullLoadDelayEmulation,
         gen.cmp(Xbyak::util::byte[contextPointer + isActiveOffset], 0);
         gen.jne((void*)m_needFullLoadDelays);
     }
+
+    const auto& debug = PCSX::g_emulator->m_debug;
+    if (m_debugBreakpoints && debug->hasExecBreakpoint(m_pc)) {
+        loadThisPointer(arg1.cvt64());
+        call(blockBreakpointWrapper);
+        gen.test(al, al);
+        gen.jnz((void*)m_returnFromBlock);  // Paused on the breakpoint, leave before running anything
+    }
     handleKernelCall();  // Check if this is a kernel call vector, emit some extra code in that case.
 
     const auto shouldContinue = [this, &count]() {
@@ -404,7 +483,10 @@ DynarecCallback DynaRecCPU::recompile(uint32_t pc, bool fullLoadDelayEmulation,
         count++;    // Increment instruction count
 
         const auto func = m_recBSC[code >> 26];  // Look up the opcode in our decoding LUT
-        (*this.*func)(code);                     // Jump into the handler to recompile it
+        const auto pgxp = m_pgxpMode ? pgxpHandler(code) : nullptr;
+        if (pgxp) emitPGXPSave(code);
+        (*this.*func)(code);  // Jump into the handler to recompile it
+        if (pgxp) emitPGXPCall(pgxp, code);
         return true;
     };
 
@@ -431,12 +513,27 @@ DynarecCallback DynaRecCPU::recompile(uint32_t pc, bool fullLoadDelayEmulation,
     m_firstInstruction = false;
 
     while (shouldContinue()) {
+        if (m_debugBreakpoints && debug->hasExecBreakpoint(m_pc)) {
+            // End the block right before the breakpoint if possible, so that the next block starts with the check.
+            // Otherwise, the check is done inline.
+            if (!m_nextIsDelaySlot && !m_delayedLoadInfo[0].active && !m_delayedLoadInfo[1].active) {
+                m_linkedPC = m_pc;
+                break;
+            }
+            emitBreakpointCheck();
+        }
         if (!compileInstruction()) {
             return m_invalidBlock;
         }
         processDelayedLoad();
     }
 
+    // Fastmem stores to the pages of a compiled block need to go through Memory, which clears the block.
+    if (m_fastmemBase && ((startingPC & 0x1fffffff) < 0x00800000)) {
+        memory->getFastMem().protectCode(startingPC & 0x1fffffff);
+        memory->getFastMem().protectCode((m_pc - 4) & 0x1fffffff);
+    }
+
     flushRegs();
     if (!m_pcWrittenBack) {
         gen.mov(dword[contextPointer + PC_OFFSET], m_pc);
@@ -451,10 +548,17 @@ DynarecCallback DynaRecCPU::recompile(uint32_t pc, bool fullLoadDelayEmulation,
     }
 
     gen.add(dword[contextPointer + CYCLE_OFFSET], count * PCSX::Emulator::BIAS);  // Add block cycles;
-    if (m_linkedPC && ENABLE_BLOCK_LINKING && m_linkedPC.value() != startingPC) {
-        handleLinking();
+    // Blocks which may have paused need to go back to the dispatcher, which checks whether we're still running
+    const uint8_t* blockEnd;
+    if (m_linkedPC && ENABLE_BLOCK_LINKING && !m_blockMayPause && m_linkedPC.value() != startingPC) {
+        blockEnd = handleLinking();
     } else {
         gen.jmp((void*)m_returnFromBlock);
+        emitFastmemSlowPaths();
+        blockEnd = gen.getCurr<const uint8_t*>();
+    }
+    if (m_perfMap.enabled()) {
+        addPerfMapBlock(startingPC, blockStart, blockEnd);
     }
 
     // Block linking might have invalidated this block, so don't cache the pointer to the invalidated block.
@@ -489,7 +593,8 @@ void DynaRecCPU::handleKernelCall() {
 
 // Emits a jump to the dispatcher if there's no block to link to.
 // Otherwise, handle linking blocks
-void DynaRecCPU::handleLinking() {
+// Returns the end of the current block's code, which is before the next block if it got compiled right after it
+const uint8_t* DynaRecCPU::handleLinking() {
     // Don't link unless the next PC is valid, and there's over 1MB of free space in the code cache
     if (isPcValid(m_linkedPC.value()) && gen.getRemainingSize() > 0x100000) {
         const auto nextPC = m_linkedPC.value();
@@ -509,9 +614,17 @@ void DynaRecCPU::handleLinking() {
 
             const auto pointer = gen.getCurr<uint8_t*>();
             gen.jne((void*)m_returnFromBlock);  // Return if the block addr changed
-            recompile(nextPC, false);           // Fallthrough to next block
+            if (!m_fastmemPending.empty()) {    // Slow paths go before the next block, and get jumped over
+                Label next;
+                gen.jmp(next, CodeGenerator::T_NEAR);
+                emitFastmemSlowPaths();
+                gen.L(next);
+            }
+            const auto end = gen.getCurr<const uint8_t*>();
+            recompile(nextPC, false);  // Fallthrough to next block
 
             *(uint32_t*)(pointer - 4) = (uint32_t)(uintptr_t)*nextBlockPointer;  // Patch comparison value
+            return end;
         } else {  // If it has already been compiled, link by jumping to the compiled code
             if (Xbyak::inner::IsInInt32(nextBlockOffset)) {
                 gen.cmp(dword[contextPointer + nextBlockOffset], (uint32_t)(uintptr_t)*nextBlockPointer);
@@ -526,6 +639,8 @@ void DynaRecCPU::handleLinking() {
     } else {  // Can't link, so return to dispatcher
         gen.jmp((void*)m_returnFromBlock);
     }
+    emitFastmemSlowPaths();
+    return gen.getCurr<const uint8_t*>();
 }
 
 void DynaRecCPU::handleShellReached() {
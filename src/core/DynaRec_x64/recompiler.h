@@ -27,13 +27,19 @@
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
+#include "core/debug.h"
 #include "core/gpu.h"
 #include "emitter.h"
 #include "fmt/format.h"
+#include "perfmap.h"
 #include "profiler.h"
 #include "regAllocation.h"
 #include "spu/interface.h"
+#include "support/eventbus.h"
 #include "tracy/Tracy.hpp"
 
 #define HOST_REG_CACHE_OFFSET(x) ((uintptr_t)&m_hostRegisterCache[(x)] - (uintptr_t)this)
@@ -89,6 +95,38 @@ static void SPU_writeRegisterWrapper(uint32_t addr, uint16_t value) {
     PCSX::g_emulator->m_spu->writeRegister(addr, value);
 }
 
+// Memory accessors compiled in place of the regular ones while the debugger has read or write breakpoints set.
+// The first argument is the memory object, same as the member functions they replace.
+static uint8_t watchedRead8Wrapper(PCSX::Memory* mem, uint32_t address) {
+    PCSX::g_emulator->m_debug->checkWatchpoint(address, PCSX::Debug::BreakpointType::Read, 1);
+    return mem->read8(address);
+}
+static uint16_t watchedRead16Wrapper(PCSX::Memory* mem, uint32_t address) {
+    PCSX::g_emulator->m_debug->checkWatchpoint(address, PCSX::Debug::BreakpointType::Read, 2);
+    return mem->read16(address);
+}
+static uint32_t watchedRead32Wrapper(PCSX::Memory* mem, uint32_t address) {
+    PCSX::g_emulator->m_debug->checkWatchpoint(address, PCSX::Debug::BreakpointType::Read, 4);
+    return mem->read32(address);
+}
+static void watchedWrite8Wrapper(PCSX::Memory* mem, uint32_t address, uint32_t value) {
+    PCSX::g_emulator->m_debug->checkWatchpoint(address, PCSX::Debug::BreakpointType::Write, 1);
+    mem->write8(address, value);
+}
+static void watchedWrite16Wrapper(PCSX::Memory* mem, uint32_t address, uint32_t value) {
+    PCSX::g_emulator->m_debug->checkWatchpoint(address, PCSX::Debug::BreakpointType::Write, 2);
+    mem->write16(address, value);
+}
+static void watchedWrite32Wrapper(PCSX::Memory* mem, uint32_t address, uint32_t value) {
+    PCSX::g_emulator->m_debug->checkWatchpoint(address, PCSX::Debug::BreakpointType::Write, 4);
+    mem->write32(address, value);
+}
+// Same as write32Wrapper, used by SWL and SWR
+static void watchedWrite32UnalignedWrapper(uint32_t address, uint32_t value) {
+    PCSX::g_emulator->m_debug->checkWatchpoint(address, PCSX::Debug::BreakpointType::Write, 4);
+    PCSX::g_emulator->m_mem->write32(address, value);
+}
+
 using DynarecCallback = void (*)();  // A function pointer to JIT-emitted code
 using namespace Xbyak;
 using namespace Xbyak::util;
@@ -133,6 +171,48 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
 
     const int MAX_BLOCK_SIZE = 50;
 
+    // The debugger state the compiled blocks were built for. All blocks are thrown away when it changes.
+    bool m_debugBreakpoints = false;  // Are exec breakpoints compiled in?
+    bool m_watchpoints = false;       // Are memory accesses compiled with the watched accessors?
+    uint32_t m_breakpointsVersion = 0;
+    uint32_t m_busConfigVersion = 0;  // Version of the memory bus configuration the blocks were compiled against
+    bool m_blockMayPause;  // Can the block being compiled pause emulation before reaching its end?
+    // The exec breakpoint we paused on, which needs to be skipped once when resuming
+    std::optional<uint32_t> m_breakpointResumePC;
+    PCSX::EventBus::Listener m_listener;
+
+    // PGXP tracking is compiled in around the instructions the current mode follows, and nowhere else.
+    uint32_t m_pgxpMode = 0;
+    // Operands of the tracked instruction, as they were before it ran.
+    struct PGXPOperands {
+        uint32_t rs, rt, rd;
+        uint32_t cop0, cop2d, cop2c;
+    } m_pgxpOperands;
+    // Calls into the PGXP function of an instruction, once it ran, with the same arguments the interpreter uses.
+    // Result is the value an instruction with a load delay is loading into $rt.
+    using PGXPHandler = void (*)(const PGXPOperands& before, const PCSX::psxRegisters& regs, uint32_t code,
+                                 uint32_t result);
+
+    // With fastmem, loads and stores to non-constant addresses are single accesses to the host mirror of the
+    // guest address space. The ones which fault, because they hit I/O, or RAM with compiled code in it, get
+    // patched into a jump to a slow path going through the Memory object. See fastmem_x64.cc
+    uint8_t* m_fastmemBase = nullptr;  // nullptr when fastmem is off
+    struct FastmemAccess {
+        const uint8_t* code;    // The host access, which gets overwritten by a jump to the slow path
+        const uint8_t* resume;  // Where the slow path returns to
+        int size;
+        bool store;
+        bool signExtend;
+        bool constValue;  // For stores, whether to write value instead of reg
+        Reg32 reg;        // Destination of loads, source of stores
+        uint32_t value;
+        uint8_t* guard = nullptr;  // For guarded RAM stores, the end of the jcc rel32 to point at the slow path
+    };
+    std::vector<FastmemAccess> m_fastmemPending;  // Accesses of the block being compiled, still missing a slow path
+    std::unordered_map<const uint8_t*, const uint8_t*> m_fastmemSlowPaths;  // Host access -> its slow path
+    // Accesses patched while the cache was isolated, with their original bytes, to undo once it isn't anymore
+    std::vector<std::pair<uint8_t*, std::array<uint8_t, 5>>> m_fastmemIsolatedPatches;
+
     enum class RegState { Unknown, Constant };
     enum class LoadingMode { DoNotLoad, Load };
     enum class LoadDelayDependencyType { NoDependency, DependencyInsideBlock, DependencyAcrossBlocks };
@@ -191,6 +271,7 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
     void alloc_rt_rs_wb_rd(uint32_t code);
 
     void flushRegs();
+    void writebackRegs();
     void spillRegisterCache();
     unsigned int m_allocatedRegisters = 0;  // how many registers have been allocated in this block?
 
@@ -198,9 +279,14 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
     void handleKernelCall();
     void emitDispatcher();
     void uncompileAll();
+    void syncDebugState();
 
   public:
-    DynaRecCPU() : R3000Acpu("Dynarec (x86-64)") {}
+    DynaRecCPU() : R3000Acpu("Dynarec (x86-64)"), m_listener(PCSX::g_system->m_eventBus) {
+        // Breakpoints are typically edited from the UI, which runs on vsync while the CPU is still in Execute()
+        m_listener.listen<PCSX::Events::GPU::VSync>([this](const auto& event) { syncDebugState(); });
+        m_listener.listen<PCSX::Events::Memory::SetLuts>([this](const auto& event) { restoreFastmemPatches(); });
+    }
 
     virtual bool Implemented() final { return true; }
     virtual bool Init() final;
@@ -208,7 +294,9 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
     virtual void Shutdown() final;
     virtual bool isDynarec() final { return true; }
     virtual void Execute() final {
-        ZoneScoped;         // Tell the Tracy profiler to do its thing
+        ZoneScoped;  // Tell the Tracy profiler to do its thing
+        syncDebugState();
+        if (m_fastmemBase) bindFastmem();
         (*m_dispatcher)();  // Jump to assembly dispatcher
     }
     // For the GUI dynarec disassembly widget
@@ -229,14 +317,19 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
         memset(m_regs.iCacheAddr, 0xff, sizeof(m_regs.iCacheAddr));
         memset(m_regs.iCacheCode, 0xff, sizeof(m_regs.iCacheCode));
         m_invalidateBlocks();
+        if (m_fastmemBase) PCSX::g_emulator->m_mem->getFastMem().unprotectCode();
     }
 
     virtual void SetPGXPMode(uint32_t pgxpMode) final {
-        if (pgxpMode != 0) {
-            throw std::runtime_error("PGXP not supported in x64 JIT");
-        }
+        if (pgxpMode == m_pgxpMode) return;
+        m_pgxpMode = pgxpMode;
+        uncompileAll();
     }
 
+    // Called from the fault handler, with the faulting address and the host pc. If this was a fastmem access,
+    // patches it into a jump to its slow path, points the pc there, and returns true.
+    bool handleFastmemFault(const void* address, uintptr_t& pc);
+
     void dumpBuffer() const {
         std::ofstream file("DynarecOutput.dump", std::ios::binary);  // Make a file for our dump
         file.write(gen.getCode<const char*>(), gen.getSize());       // Write the code buffer to the dump
@@ -282,6 +375,9 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
         }
     }
 
+    // Whether pointerWrite gave a pointer to RAM for this address, rather than to the scratchpad or an I/O register
+    static bool isRAMPointer(uint32_t address) { return ((address >> 16) & 0x1fff) != 0x1f80; }
+
     // Stores a value of "size" bits from "source" to the given pointer
     // Tries to use base pointer relative addressing, otherwise uses movabs
     template <int size, typename T>
@@ -351,9 +447,42 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
     void callMemoryFunc(T func) {
         void* object = PCSX::g_emulator->m_mem.get();
         prepareForCall();
-        emitMemberFunctionCall(func, object);
+        if (!m_watchpoints) {
+            emitMemberFunctionCall(func, object);
+            return;
+        }
+
+        // Go through the accessors which let the debugger see the access. These can pause emulation.
+        m_blockMayPause = true;
+        loadAddress(arg1.cvt64(), object);
+        if constexpr (std::is_same_v<T, decltype(&PCSX::Memory::read8)>) {
+            gen.callFunc(watchedRead8Wrapper);
+        } else if constexpr (std::is_same_v<T, decltype(&PCSX::Memory::read16)>) {
+            gen.callFunc(watchedRead16Wrapper);
+        } else if constexpr (std::is_same_v<T, decltype(&PCSX::Memory::read32)>) {
+            gen.callFunc(watchedRead32Wrapper);
+        } else if (func == &PCSX::Memory::write8) {
+            gen.callFunc(watchedWrite8Wrapper);
+        } else if (func == &PCSX::Memory::write16) {
+            gen.callFunc(watchedWrite16Wrapper);
+        } else {
+            gen.callFunc(watchedWrite32Wrapper);
+        }
     }
 
+    // Used by SWL and SWR to write back the merged word
+    void callWrite32Wrapper() {
+        if (m_watchpoints) {
+            m_blockMayPause = true;
+            call(watchedWrite32UnalignedWrapper);
+        } else {
+            call(write32Wrapper);
+        }
+    }
+
+    // Whether constant address accesses to this address must skip their inline fast path
+    bool isWatched(uint32_t address) { return m_watchpoints && PCSX::g_emulator->m_debug->isWatched(address); }
+
     template <typename T>
     void callGTEFunc(T func) {
         void* object = PCSX::g_emulator->m_gte.get();
@@ -363,6 +492,11 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
 
     static void exceptionWrapper(DynaRecCPU* that, int32_t e, int32_t bd) { that->exception(e, bd); }
     static void recErrorWrapper(DynaRecCPU* that) { that->error(); }
+    static bool blockBreakpointWrapper(DynaRecCPU* that) { return that->checkBlockBreakpoint(); }
+    static void breakpointWrapper(DynaRecCPU* that, uint32_t pc) { that->checkBreakpoint(pc); }
+    static void pgxpWrapper(DynaRecCPU* that, uint32_t code, PGXPHandler handler, const uint32_t* result) {
+        handler(that->m_pgxpOperands, that->m_regs, code, *result);
+    }
 
     static void signalShellReached(DynaRecCPU* that);
     static DynarecCallback recRecompileWrapper(DynaRecCPU* that, bool fullLoadDelayEmulation) {
@@ -374,9 +508,23 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
 
     DynarecCallback* getBlockPointer(uint32_t pc);
     DynarecCallback recompile(uint32_t pc, bool fullLoadDelayEmulation, bool align = true);
+    bool checkBlockBreakpoint();
+    void checkBreakpoint(uint32_t pc);
+    void emitBreakpointCheck();
+    PGXPHandler pgxpHandler(uint32_t code);
+    void emitPGXPSave(uint32_t code);
+    void emitPGXPCall(PGXPHandler handler, uint32_t code);
+    void initFastmem();
+    void bindFastmem();
+    bool useFastmem() const { return m_fastmemBase && !m_watchpoints; }
+    void emitFastmemLoad(int size, bool signExtend, Reg32 dest);
+    void emitFastmemStore(int size, uint32_t code);
+    void emitRAMStore(int size, uint32_t code, uint32_t address, const void* pointer);
+    void emitFastmemSlowPaths();
+    void restoreFastmemPatches();
     void error();
     void flushCache();
-    void handleLinking();
+    const uint8_t* handleLinking();
     void handleShellReached();
     void emitBlockLookup();
 
@@ -384,6 +532,10 @@ class DynaRecCPU final : public PCSX::R3000Acpu {
     RecompilerProfiler<10000000> m_profiler;
 
     void makeSymbols();
+    // Entries for the host profilers, which are written as code gets emitted if enabled in the debug settings
+    PerfMap m_perfMap;
+    void addPerfMapStubs(const uint8_t* end);
+    void addPerfMapBlock(uint32_t pc, const uint8_t* start, const uint8_t* end);
     bool startProfiling(uint32_t pc);
     void endProfiling();
     void dumpProfileData();
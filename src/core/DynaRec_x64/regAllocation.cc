@@ -67,6 +67,18 @@ void DynaRecCPU::flushRegs() {
     m_allocatedRegisters = 0;
 }
 
+// Write back all guest registers, while keeping them allocated and keeping track of constants.
+// Used before calling C++ code which needs to look at the registers, without changing them.
+void DynaRecCPU::writebackRegs() {
+    for (auto i = 1; i < 32; i++) {
+        if (m_gprs[i].isConst()) {
+            gen.mov(dword[contextPointer + GPR_OFFSET(i)], m_gprs[i].val);
+        } else if (m_gprs[i].isAllocated() && m_gprs[i].writeback) {
+            gen.mov(dword[contextPointer + GPR_OFFSET(i)], m_gprs[i].allocatedReg);
+        }
+    }
+}
+
 // Spill the volatile allocated registers into guest registers in preparation for a call to a C++ function
 void DynaRecCPU::prepareForCall() {
     if (m_allocatedRegisters > ALLOCATEABLE_NON_VOLATILE_COUNT) {  // Check if there's any allocated volatiles to flush
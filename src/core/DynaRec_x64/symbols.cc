@@ -22,6 +22,7 @@
 #if defined(DYNAREC_X86_64)
 #include <array>
 #include <cstring>
+#include <utility>
 
 #include "fmt/format.h"
 
@@ -94,6 +95,13 @@ void DynaRecCPU::makeSymbols() {
 
     REGISTER_FUNCTION(read32Wrapper, "read32_wrapper");
     REGISTER_FUNCTION(write32Wrapper, "write32_wrapper");
+    REGISTER_FUNCTION(watchedRead8Wrapper, "watched_read8");
+    REGISTER_FUNCTION(watchedRead16Wrapper, "watched_read16");
+    REGISTER_FUNCTION(watchedRead32Wrapper, "watched_read32");
+    REGISTER_FUNCTION(watchedWrite8Wrapper, "watched_write8");
+    REGISTER_FUNCTION(watchedWrite16Wrapper, "watched_write16");
+    REGISTER_FUNCTION(watchedWrite32Wrapper, "watched_write32");
+    REGISTER_FUNCTION(watchedWrite32UnalignedWrapper, "watched_write32_unaligned");
 
     REGISTER_CLASS_FUNCTION(PCSX::Memory::read8, "read8");
     REGISTER_CLASS_FUNCTION(PCSX::Memory::read16, "read16");
@@ -108,6 +116,9 @@ void DynaRecCPU::makeSymbols() {
     REGISTER_FUNCTION(SPU_writeRegisterWrapper, "spu_write_register");
     REGISTER_FUNCTION(recErrorWrapper, "recompiler_error_wrapper");
     REGISTER_FUNCTION(recRecompileWrapper, "recompiler_compile_wrapper");
+    REGISTER_FUNCTION(blockBreakpointWrapper, "block_breakpoint_check");
+    REGISTER_FUNCTION(breakpointWrapper, "breakpoint_check");
+    REGISTER_FUNCTION(pgxpWrapper, "pgxp_wrapper");
 
     m_symbols += fmt::format("{} dispatcher_entry\n", (void*)m_dispatcher);
     m_symbols += fmt::format("{} return_from_block\n", (void*)m_returnFromBlock);
@@ -115,6 +126,39 @@ void DynaRecCPU::makeSymbols() {
     m_symbols += fmt::format("{} invalid_block_handler\n", (void*)m_invalidBlock);
 }
 
+// The stubs are emitted back to back by emitDispatcher, so each one runs until the next one starts.
+// The C++ helpers they call, such as recRecompileWrapper, are part of our binary and already known to the profilers.
+void DynaRecCPU::addPerfMapStubs(const uint8_t* end) {
+    const std::array<std::pair<DynarecCallback, const char*>, 7> stubs = {{
+        {m_dispatcher, "pcsx_dispatcher_entry"},
+        {m_returnFromBlock, "pcsx_return_from_block"},
+        {m_uncompiledBlock, "pcsx_uncompiled_block_handler"},
+        {m_invalidBlock, "pcsx_invalid_block_handler"},
+        {m_invalidateBlocks, "pcsx_invalidate_blocks"},
+        {m_loadDelayHandler, "pcsx_load_delay_handler"},
+        {m_needFullLoadDelays, "pcsx_need_full_load_delays"},
+    }};
+
+    for (size_t i = 0; i < stubs.size(); i++) {
+        const auto start = (const uint8_t*)stubs[i].first;
+        const auto next = i + 1 < stubs.size() ? (const uint8_t*)stubs[i + 1].first : end;
+        m_perfMap.addCode(start, next - start, stubs[i].second);
+    }
+}
+
+// Blocks are named after their guest PC, followed by the guest symbol they're in, if any.
+void DynaRecCPU::addPerfMapBlock(uint32_t pc, const uint8_t* start, const uint8_t* end) {
+    std::string name = fmt::format("pcsx_block_{:08x}", pc);
+    const auto& symbols = PCSX::R3000Acpu::m_symbols;
+    auto symbol = symbols.upper_bound(pc);
+    if (symbol != symbols.begin()) {
+        --symbol;
+        const uint32_t offset = pc - symbol->first;
+        name += offset ? fmt::format(" {}+0x{:x}", symbol->second, offset) : fmt::format(" {}", symbol->second);
+    }
+    m_perfMap.addCode(start, end - start, name);
+}
+
 #undef REGISTER_VARIABLE
 #undef REGISTER_FUNCTION
 #endif  // DYNAREC_X86_64
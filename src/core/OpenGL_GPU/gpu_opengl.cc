@@ -29,6 +29,7 @@
 #include "core/system.h"
 #include "fmt/format.h"
 #include "gui/gui.h"
+#include "support/instrumentation.h"
 #include "tracy/Tracy.hpp"
 
 std::unique_ptr<PCSX::GPU> PCSX::GPU::getOpenGL() { return std::unique_ptr<PCSX::GPU>(new PCSX::OpenGL_GPU()); }
@@ -899,6 +900,7 @@ void PCSX::OpenGL_GPU::write0(DrawingOffset *prim) {
 }
 
 void PCSX::OpenGL_GPU::write0(FastFill *prim) {
+    PCSX_INSTRUMENT(Rasterizer);
     renderBatch();
     const auto colour = prim->color;
     const float r = float(colour & 0xff) / 255.f;
@@ -912,6 +914,7 @@ void PCSX::OpenGL_GPU::write0(FastFill *prim) {
 }
 
 void PCSX::OpenGL_GPU::write0(BlitVramVram *prim) {
+    PCSX_INSTRUMENT(Rasterizer);
     renderBatch();
     OpenGL::disableScissor();  // We disable scissor testing because it affects glBlitFramebuffer
 
@@ -935,6 +938,7 @@ void PCSX::OpenGL_GPU::write0(BlitVramVram *prim) {
 template <PCSX::GPU::Shading shading, PCSX::GPU::Shape shape, PCSX::GPU::Textured textured, PCSX::GPU::Blend blend,
           PCSX::GPU::Modulation modulation>
 void PCSX::OpenGL_GPU::polyExec(Poly<shading, shape, textured, blend, modulation> *prim) {
+    PCSX_INSTRUMENT(Rasterizer);
     if constexpr (blend == Blend::Off) {
         setTransparency<Transparency::Opaque>();
     } else if constexpr (blend == Blend::Semi) {
@@ -963,6 +967,7 @@ void PCSX::OpenGL_GPU::polyExec(Poly<shading, shape, textured, blend, modulation
 
 template <PCSX::GPU::Shading shading, PCSX::GPU::LineType lineType, PCSX::GPU::Blend blend>
 void PCSX::OpenGL_GPU::lineExec(Line<shading, lineType, blend> *prim) {
+    PCSX_INSTRUMENT(Rasterizer);
     auto count = prim->colors.size();
 
     if constexpr (blend == Blend::Off) {
@@ -985,6 +990,7 @@ void PCSX::OpenGL_GPU::lineExec(Line<shading, lineType, blend> *prim) {
 
 template <PCSX::GPU::Size size, PCSX::GPU::Textured textured, PCSX::GPU::Blend blend, PCSX::GPU::Modulation modulation>
 void PCSX::OpenGL_GPU::rectExec(Rect<size, textured, blend, modulation> *prim) {
+    PCSX_INSTRUMENT(Rasterizer);
     if constexpr (blend == Blend::Off) {
         setTransparency<Transparency::Opaque>();
     } else if constexpr (blend == Blend::Semi) {
@@ -149,6 +149,21 @@ class CDRomImpl : public PCSX::CDRom {
 
     struct PCSX::CdrStat cdr_stat;
 
+    // Accelerated CD mode; see acceleratedSeekCycles and acceleratedSectorCycles.
+    uint32_t accelerateSeek(uint32_t cycles) {
+        int speedup = PCSX::g_emulator->settings.get<PCSX::Emulator::SettingCDSpeedup>();
+        uint32_t accelerated = acceleratedSeekCycles(cycles, speedup);
+        m_acceleratedCycles += cycles - accelerated;
+        return accelerated;
+    }
+    uint32_t accelerateSector(uint32_t cycles) {
+        if (!m_acceleratedRead || (m_mode & MODE_STRSND)) return cycles;
+        int speedup = PCSX::g_emulator->settings.get<PCSX::Emulator::SettingCDSpeedup>();
+        uint32_t accelerated = acceleratedSectorCycles(cycles, speedup);
+        m_acceleratedCycles += cycles - accelerated;
+        return accelerated;
+    }
+
     static const uint32_t H_SPUirqAddr = 0x1f801da4;
     static const uint32_t H_SPUctrl = 0x1f801daa;
 
@@ -324,7 +339,7 @@ class CDRomImpl : public PCSX::CDRom {
                     // and is only cleared by CdlGetStat
 
                     m_driveState = DRIVESTATE_RESCAN_CD;
-                    scheduleCDLidIRQ(cdReadTime * 105);
+                    scheduleCDLidIRQ(accelerateSeek(cdReadTime * 105));
                     break;
                 }
 
@@ -338,14 +353,14 @@ class CDRomImpl : public PCSX::CDRom {
 
                 // this is very long on real hardware, over 6 seconds
                 // make it a bit faster here...
-                scheduleCDLidIRQ(cdReadTime * 150);
+                scheduleCDLidIRQ(accelerateSeek(cdReadTime * 150));
                 break;
 
             case DRIVESTATE_PREPARE_CD:
                 m_statP |= STATUS_SEEK;
 
                 m_driveState = DRIVESTATE_STANDBY;
-                scheduleCDLidIRQ(cdReadTime * 26);
+                scheduleCDLidIRQ(accelerateSeek(cdReadTime * 26));
                 break;
         }
     }
@@ -548,7 +563,7 @@ class CDRomImpl : public PCSX::CDRom {
         m_setSectorPlay++;
 
         if (m_locationChanged) {
-            scheduleCDPlayIRQ(cdReadTime * 30);
+            scheduleCDPlayIRQ(accelerateSeek(cdReadTime * 30));
             m_locationChanged = false;
         } else {
             scheduleCDPlayIRQ(cdReadTime);
@@ -688,7 +703,7 @@ class CDRomImpl : public PCSX::CDRom {
                     error = ERROR_INVALIDARG;
                     goto set_error;
                 }
-                AddIrqQueue(CdlStandby + 0x100, cdReadTime * 125 / 2);
+                AddIrqQueue(CdlStandby + 0x100, accelerateSeek(cdReadTime * 125 / 2));
                 start_rotating = 1;
                 break;
 
@@ -707,7 +722,7 @@ class CDRomImpl : public PCSX::CDRom {
                 StopReading();
 
                 delay = 0x800;
-                if (m_driveState == DRIVESTATE_STANDBY) delay = cdReadTime * 30 / 2;
+                if (m_driveState == DRIVESTATE_STANDBY) delay = accelerateSeek(cdReadTime * 30 / 2);
 
                 m_driveState = DRIVESTATE_STOPPED;
                 AddIrqQueue(CdlStop + 0x100, delay);
@@ -813,7 +828,7 @@ class CDRomImpl : public PCSX::CDRom {
 
             case CdlReadT:  // SetSession?
                 // really long
-                AddIrqQueue(CdlReadT + 0x100, cdReadTime * 290 / 4);
+                AddIrqQueue(CdlReadT + 0x100, accelerateSeek(cdReadTime * 290 / 4));
                 start_rotating = 1;
                 break;
 
@@ -869,7 +884,7 @@ class CDRomImpl : public PCSX::CDRom {
                 Rockman X5 = 0.5-4x
                 - fix capcom logo
                 */
-                scheduleCDPlayIRQ(m_seeked == SEEK_DONE ? 0x800 : cdReadTime * 4);
+                scheduleCDPlayIRQ(m_seeked == SEEK_DONE ? 0x800 : accelerateSeek(cdReadTime * 4));
                 m_seeked = SEEK_PENDING;
                 start_rotating = 1;
                 break;
@@ -943,7 +958,7 @@ class CDRomImpl : public PCSX::CDRom {
                 break;
 
             case CdlReadToc:
-                AddIrqQueue(CdlReadToc + 0x100, cdReadTime * 180 / 4);
+                AddIrqQueue(CdlReadToc + 0x100, accelerateSeek(cdReadTime * 180 / 4));
                 no_busy_error = 1;
                 start_rotating = 1;
                 break;
@@ -970,6 +985,7 @@ class CDRomImpl : public PCSX::CDRom {
 
                 m_reading = 1;
                 m_firstSector = 1;
+                m_acceleratedRead = irq == CdlReadN;
 
                 // Fighting Force 2 - update m_subq time immediately
                 // - fixes new game
@@ -1010,12 +1026,12 @@ class CDRomImpl : public PCSX::CDRom {
                     // - fix cutscene speech (startup)
 
                     // ??? - use more accurate seek time later
-                    scheduleCDReadIRQ((m_mode & 0x80) ? (cdReadTime) : cdReadTime * 2);
+                    scheduleCDReadIRQ(accelerateSector((m_mode & 0x80) ? (cdReadTime) : cdReadTime * 2));
                 } else {
                     m_statP |= STATUS_READ;
                     m_statP &= ~STATUS_SEEK;
 
-                    scheduleCDReadIRQ((m_mode & 0x80) ? (cdReadTime) : cdReadTime * 2);
+                    scheduleCDReadIRQ(accelerateSector((m_mode & 0x80) ? (cdReadTime) : cdReadTime * 2));
                 }
 
                 m_result[0] = m_statP;
@@ -1179,10 +1195,10 @@ class CDRomImpl : public PCSX::CDRom {
 
         uint32_t delay = (m_mode & MODE_SPEED) ? (cdReadTime / 2) : cdReadTime;
         if (m_locationChanged) {
-            scheduleCDReadIRQ(delay * 30);
+            scheduleCDReadIRQ(accelerateSeek(delay * 30));
             m_locationChanged = false;
         } else {
-            scheduleCDReadIRQ(delay);
+            scheduleCDReadIRQ(accelerateSector(delay));
         }
 
         /*
@@ -1463,8 +1479,7 @@ class CDRomImpl : public PCSX::CDRom {
                     memFile->write<uint8_t>(m_transfer[m_transferIndex++]);
                     adjustTransferIndex();
                 }
-                if (PCSX::g_emulator->settings.get<PCSX::Emulator::SettingDebugSettings>()
-                        .get<PCSX::Emulator::DebugSettings::Debug>()) {
+                if (PCSX::g_emulator->m_mem->getBusConfig().debug) {
                     PCSX::g_emulator->m_debug->checkDMAwrite(3, madr, cdsize);
                 }
                 PCSX::g_emulator->m_cpu->Clear(madr, cdsize / 4);
@@ -1496,6 +1511,7 @@ class CDRomImpl : public PCSX::CDRom {
     void getCdInfo(void) { m_setSectorEnd = m_iso->getTD(0); }
 
     void reset() final {
+        reportAcceleration();
         m_reg1Mode = 0;
         m_cmdProcess = 0;
         m_ctrl = 0;
@@ -1550,6 +1566,7 @@ class CDRomImpl : public PCSX::CDRom {
         m_subq.absolute[1] = 0;
         m_subq.absolute[2] = 0;
         m_trackChanged = false;
+        m_acceleratedRead = false;
 
         m_curTrack = 1;
         m_file = 1;
@@ -1661,14 +1678,28 @@ class CDRomImpl : public PCSX::CDRom {
 }  // namespace
 
 PCSX::CDRom *PCSX::CDRom::factory() { return new CDRomImpl; }
+
+std::shared_ptr<PCSX::ISO9660Reader> PCSX::CDRom::getIsoReader() {
+    if (!m_isoReader) m_isoReader = std::make_shared<ISO9660Reader>(m_iso);
+    return m_isoReader;
+}
+
+void PCSX::CDRom::reportAcceleration() {
+    if (m_acceleratedCycles == 0) return;
+    g_system->printf(_("CD-ROM: accelerated mode saved %llu cycles (%.2fs of emulated time)\n"),
+                     static_cast<unsigned long long>(m_acceleratedCycles),
+                     double(m_acceleratedCycles) / g_emulator->m_psxClockSpeed);
+    m_acceleratedCycles = 0;
+}
+
 void PCSX::CDRom::check() {
     m_cdromId.clear();
     m_cdromLabel.clear();
-    ISO9660Reader reader(m_iso);
-    if (reader.failed()) return;
-    IO<File> systemcnf(reader.open("SYSTEM.CNF;1"));
+    auto reader = getIsoReader();
+    if (reader->failed()) return;
+    IO<File> systemcnf(reader->open("SYSTEM.CNF;1"));
     std::string exename;
-    m_cdromLabel = StringsHelpers::trim(reader.getLabel());
+    m_cdromLabel = StringsHelpers::trim(reader->getLabel());
 
     if (!systemcnf->failed()) {
         while (!systemcnf->eof()) {
@@ -1698,7 +1729,7 @@ void PCSX::CDRom::check() {
             break;
         }
     } else {
-        IO<File> psxexe(reader.open("PSX.EXE;1"));
+        IO<File> psxexe(reader->open("PSX.EXE;1"));
         if (!psxexe->failed()) {
             m_cdromId = "SLUS99999";
             exename = "PSX.EXE;1";
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -34,6 +35,8 @@
 
 namespace PCSX {
 
+class ISO9660Reader;
+
 namespace Widgets {
 class IsoBrowser;
 }
@@ -57,12 +60,43 @@ class CDRom {
     std::shared_ptr<CDRIso> getIso() { return m_iso; }
     void clearIso() {
         m_iso.reset();
+        m_isoReader.reset();
         g_system->m_eventBus->signal(Events::IsoMounted{});
     }
     void setIso(CDRIso* iso) {
         m_iso.reset(iso);
+        m_isoReader.reset();
         g_system->m_eventBus->signal(Events::IsoMounted{});
     }
+    // Cycles shaved off the CD-ROM delays by the accelerated mode since the last
+    // reset; reportAcceleration logs them and starts over.
+    uint64_t getAcceleratedCycles() const { return m_acceleratedCycles; }
+    void reportAcceleration();
+
+    // Accelerated CD mode. Mechanical latencies, such as seeks, spin ups and the
+    // slowest command responses, get divided by the speedup, which is 1 for the
+    // real drive speed, up to 16, or 0 for instant. They never go under a regular
+    // command acknowledge, unless they already were that short.
+    static uint32_t acceleratedSeekCycles(uint32_t cycles, int speedup) {
+        if (speedup == 1) return cycles;
+        uint32_t floor = std::min(cycles, c_acceleratedFloor);
+        if (speedup <= 0) return floor;
+        return std::max(cycles / std::min(speedup, c_maxSpeedup), floor);
+    }
+    // The sectors of ReadN commands get delivered faster too, but even instant
+    // mode still has to hand them over one at a time, so they cap at 16x. ReadS,
+    // XA and CDDA keep their real cadence, since games pace their playback on it,
+    // which is for the caller to check.
+    static uint32_t acceleratedSectorCycles(uint32_t cycles, int speedup) {
+        if (speedup == 1) return cycles;
+        if ((speedup <= 0) || (speedup > c_maxSpeedup)) speedup = c_maxSpeedup;
+        return cycles / speedup;
+    }
+    static constexpr int c_maxSpeedup = 16;
+    static constexpr uint32_t c_acceleratedFloor = 0x800;
+    // Filesystem reader for the current disc, kept around along with its
+    // directory index until the disc gets swapped.
+    std::shared_ptr<ISO9660Reader> getIsoReader();
 
     const std::string& getCDRomID() { return m_cdromId; }
     const std::string& getCDRomLabel() { return m_cdromLabel; }
@@ -158,13 +192,17 @@ class CDRom {
         uint8_t absolute[3];
     } m_subq;
     bool m_trackChanged;
+    // Only plain ReadN commands get their sectors delivered faster in accelerated mode.
+    bool m_acceleratedRead = false;
     // end savestate
+    uint64_t m_acceleratedCycles = 0;
     friend SaveStates::SaveState SaveStates::constructSaveState();
 
   private:
     friend class Widgets::IsoBrowser;
     std::string m_cdromId;
     std::string m_cdromLabel;
+    std::shared_ptr<ISO9660Reader> m_isoReader;
 };
 
 }  // namespace PCSX
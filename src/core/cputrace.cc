@@ -0,0 +1,172 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/cputrace.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "core/disr3000a.h"
+#include "fmt/format.h"
+
+bool PCSX::CPUTrace::start(const std::filesystem::path& filename, const Triggers& triggers) {
+    stop();
+    m_file.setFile(new PosixFile(filename, FileOps::TRUNCATE));
+    if (m_file->failed()) {
+        m_file.reset();
+        return false;
+    }
+    FileHeader header;
+    memcpy(header.magic, FileHeader::c_magic, sizeof(header.magic));
+    header.recordSize = sizeof(Record);
+    header.reserved = 0;
+    m_file->write(&header, sizeof(header));
+
+    if (!m_ring) m_ring.reset(new Record[c_ringSize]);
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+    m_cachedTail = 0;
+    m_dropped = 0;
+    m_triggers = triggers;
+    bool waiting = (triggers.startPC != c_noTrigger) || (triggers.startCycle != c_noTrigger);
+    m_state = waiting ? State::WAITING : State::RECORDING;
+    m_stopping.store(false, std::memory_order_relaxed);
+    m_flusher = std::thread([this]() { flusherMain(); });
+    return true;
+}
+
+void PCSX::CPUTrace::stop() {
+    if (!m_flusher.joinable()) return;
+    m_state = State::DONE;
+    m_stopping.store(true, std::memory_order_release);
+    m_flusher.join();
+    m_file->close();
+    m_file.reset();
+}
+
+void PCSX::CPUTrace::flusherMain() {
+    while (true) {
+        bool stopping = m_stopping.load(std::memory_order_acquire);
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        if (head == tail) {
+            if (stopping) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        // Drain up to the end of the ring at most, the rest comes next loop.
+        size_t first = tail & (c_ringSize - 1);
+        size_t count = std::min<uint64_t>(head - tail, c_ringSize - first);
+        m_file->write(&m_ring[first], count * sizeof(Record));
+        m_tail.store(tail + count, std::memory_order_release);
+    }
+}
+
+uint8_t PCSX::CPUTrace::immediateDestination(uint32_t code) {
+    const uint8_t rt = (code >> 16) & 0x1f;
+    const uint8_t rd = (code >> 11) & 0x1f;
+    switch (code >> 26) {
+        case 0x00: {
+            const uint32_t funct = code & 0x3f;
+            // shifts, jalr, mfhi, mflo, and the three operands alu ops
+            if ((funct < 0x08) || (funct == 0x09) || (funct == 0x10) || (funct == 0x12) || (funct >= 0x20)) return rd;
+            return 0;
+        }
+        case 0x01:
+            // bltzal, bgezal
+            return ((rt & 0x1e) == 0x10) ? 31 : 0;
+        case 0x03:
+            // jal
+            return 31;
+        case 0x08:
+        case 0x09:
+        case 0x0a:
+        case 0x0b:
+        case 0x0c:
+        case 0x0d:
+        case 0x0e:
+        case 0x0f:
+            // immediate alu ops and lui
+            return rt;
+    }
+    return 0;
+}
+
+bool PCSX::CPUTrace::memoryAccess(uint32_t code, const uint32_t* gpr, uint32_t& address, uint8_t& flags) {
+    const uint32_t op = code >> 26;
+    switch (op) {
+        case 0x20:
+        case 0x21:
+        case 0x22:
+        case 0x23:
+        case 0x24:
+        case 0x25:
+        case 0x26:
+        case 0x32:
+            flags = MEM_READ;
+            break;
+        case 0x28:
+        case 0x29:
+        case 0x2a:
+        case 0x2b:
+        case 0x2e:
+        case 0x3a:
+            flags = MEM_WRITE;
+            break;
+        default:
+            return false;
+    }
+    address = gpr[(code >> 21) & 0x1f] + static_cast<int16_t>(code & 0xffff);
+    return true;
+}
+
+bool PCSX::CPUTrace::decode(IO<File> in, std::ostream& out) {
+    FileHeader header;
+    if (in->read(&header, sizeof(header)) != ssize_t(sizeof(header))) return false;
+    if (memcmp(header.magic, FileHeader::c_magic, sizeof(header.magic)) != 0) return false;
+    if (header.recordSize != sizeof(Record)) return false;
+
+    constexpr size_t c_chunk = 4096;
+    auto records = std::make_unique<Record[]>(c_chunk);
+    while (true) {
+        ssize_t r = in->read(records.get(), c_chunk * sizeof(Record));
+        if (r <= 0) break;
+        size_t count = r / sizeof(Record);
+        for (size_t i = 0; i < count; i++) {
+            const auto& record = records[i];
+            if (record.dropped) out << fmt::format("*** {} instructions dropped ***\n", record.dropped);
+            std::string line = fmt::format("{:08x} {}", record.cycle,
+                                           Disasm::asString(record.code, 0, record.pc, nullptr, false));
+            if (record.flags & IN_ISR) line += " [isr]";
+            if (record.reg) {
+                line += fmt::format(" ; ${}={:08x}", Disasm::s_disRNameGPR[record.reg], record.regValue);
+            }
+            if (record.flags & MEM_READ) {
+                line += fmt::format(" ; [{:08x}]", record.memAddress);
+            } else if (record.flags & MEM_WRITE) {
+                line += fmt::format(" ; [{:08x}]<-{:08x}", record.memAddress, record.memValue);
+            }
+            out << line << "\n";
+        }
+        if (count * sizeof(Record) != size_t(r)) break;
+    }
+    return true;
+}
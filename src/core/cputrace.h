@@ -0,0 +1,148 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <ostream>
+#include <thread>
+
+#include "support/file.h"
+
+namespace PCSX {
+
+// Binary execution trace of the CPU. The emulation thread is the only producer,
+// appending fixed size records into a ring buffer without taking any lock,
+// while a background thread drains it into a file. The file is decoded and
+// disassembled offline, using `pcsx-redux -decodetrace file`.
+class CPUTrace {
+  public:
+    struct Record {
+        uint32_t pc;
+        uint32_t code;
+        uint32_t cycle;
+        // Value written into reg by this instruction; for loads, this is
+        // the value which lands in the register after the delay slot.
+        uint32_t regValue;
+        uint32_t memAddress;
+        uint32_t memValue;
+        // Amount of records lost to a full ring buffer right before this one.
+        uint32_t dropped;
+        uint8_t reg;
+        uint8_t flags;
+        uint16_t reserved;
+    };
+    static_assert(sizeof(Record) == 32);
+    enum : uint8_t {
+        MEM_READ = 1,
+        MEM_WRITE = 2,
+        IN_ISR = 4,
+    };
+
+    struct FileHeader {
+        static constexpr char c_magic[8] = {'P', 'C', 'S', 'X', 'T', 'R', 'C', '1'};
+        char magic[8];
+        uint32_t recordSize;
+        uint32_t reserved;
+    };
+
+    // Tracing starts at the first instruction hitting either start trigger,
+    // and ends before the first one hitting either stop trigger. A disabled
+    // start trigger means recording right away.
+    static constexpr uint32_t c_noTrigger = 0xffffffff;
+    struct Triggers {
+        uint32_t startPC = c_noTrigger;
+        uint32_t stopPC = c_noTrigger;
+        uint32_t startCycle = c_noTrigger;
+        uint32_t stopCycle = c_noTrigger;
+    };
+
+    ~CPUTrace() { stop(); }
+    bool start(const std::filesystem::path& filename, const Triggers& triggers);
+    void stop();
+    bool started() const { return m_flusher.joinable(); }
+
+    bool inWindow(uint32_t pc, uint32_t cycle) {
+        switch (m_state) {
+            case State::WAITING:
+                if ((pc != m_triggers.startPC) && !reached(cycle, m_triggers.startCycle)) return false;
+                m_state = State::RECORDING;
+                [[fallthrough]];
+            case State::RECORDING:
+                if ((pc == m_triggers.stopPC) || reached(cycle, m_triggers.stopCycle)) {
+                    m_state = State::DONE;
+                    return false;
+                }
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void push(Record& record) {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        if ((head - m_cachedTail) >= c_ringSize) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if ((head - m_cachedTail) >= c_ringSize) {
+                m_dropped++;
+                return;
+            }
+        }
+        record.dropped = m_dropped;
+        m_dropped = 0;
+        m_ring[head & (c_ringSize - 1)] = record;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    // Returns the register an instruction writes to right away, or 0 if it
+    // doesn't write any, or only does so through the load delay slot.
+    static uint8_t immediateDestination(uint32_t code);
+    // Returns true if the instruction is a load or store, and fills in the
+    // flags and address it'll use, given the current register values.
+    static bool memoryAccess(uint32_t code, const uint32_t* gpr, uint32_t& address, uint8_t& flags);
+
+    static bool decode(IO<File> in, std::ostream& out);
+
+  private:
+    static constexpr size_t c_ringSize = 1 << 18;
+    enum class State { WAITING, RECORDING, DONE };
+
+    static bool reached(uint32_t cycle, uint32_t target) {
+        return (target != c_noTrigger) && (static_cast<int32_t>(cycle - target) >= 0);
+    }
+    void flusherMain();
+
+    std::unique_ptr<Record[]> m_ring;
+    IO<File> m_file;
+    std::thread m_flusher;
+    std::atomic<bool> m_stopping = false;
+    Triggers m_triggers;
+    State m_state = State::DONE;
+    // Only touched by the emulation thread.
+    uint64_t m_cachedTail = 0;
+    uint32_t m_dropped = 0;
+    alignas(64) std::atomic<uint64_t> m_head = 0;
+    alignas(64) std::atomic<uint64_t> m_tail = 0;
+};
+
+}  // namespace PCSX
@@ -43,7 +43,7 @@ enum {
 uint32_t PCSX::Debug::normalizeAddress(uint32_t address) {
     uint32_t base = (address >> 20) & 0xffc;
     uint32_t real = address & 0x7fffff;
-    const bool ramExpansion = PCSX::g_emulator->settings.get<PCSX::Emulator::Setting8MB>();
+    const bool ramExpansion = PCSX::g_emulator->m_mem->getBusConfig().ramExpansion;
     if (!ramExpansion && ((base == 0x000) || (base == 0x800) || (base == 0xa00))) {
         return address & ~0x00600000;
     }
@@ -244,8 +244,13 @@ void PCSX::Debug::checkBP(uint32_t address, BreakpointType type, uint32_t width,
         }
     }
 
-    auto end = m_breakpoints.end();
+    triggerBreakpoints(address, type, width, cause);
+}
+
+void PCSX::Debug::triggerBreakpoints(uint32_t address, BreakpointType type, uint32_t width, const char* cause) {
     uint32_t normalizedAddress = normalizeAddress(address & ~0xe0000000);
+    if (!mayHaveBreakpoint(normalizedAddress, type, width)) return;
+    auto end = m_breakpoints.end();
 
     BreakpointTemporaryListType torun;
     for (auto it = m_breakpoints.find(normalizedAddress, normalizedAddress + width - 1); it != end; it++) {
@@ -254,11 +259,41 @@ void PCSX::Debug::checkBP(uint32_t address, BreakpointType type, uint32_t width,
         torun.push_back(bp);
     }
 
+    bool deleted = false;
     while (!torun.empty()) {
         auto it = torun.begin();
         auto bp = &*it;
         torun.erase(it);
-        if (!triggerBP(bp, address, width, cause)) delete bp;
+        if (!triggerBP(bp, address, width, cause)) {
+            delete bp;
+            deleted = true;
+        }
+    }
+    if (deleted) breakpointsChanged();
+}
+
+bool PCSX::Debug::hasExecBreakpoint(uint32_t address) {
+    uint32_t normalizedAddress = normalizeAddress(address & ~0xe0000000);
+    if (!mayHaveBreakpoint(normalizedAddress, BreakpointType::Exec, 4)) return false;
+    auto end = m_breakpoints.end();
+    for (auto it = m_breakpoints.find(normalizedAddress, normalizedAddress + 3); it != end; it++) {
+        if (it->type() == BreakpointType::Exec) return true;
+    }
+    return false;
+}
+
+void PCSX::Debug::breakpointsChanged() {
+    m_breakpointsVersion++;
+    m_coarseMap.reset();
+    for (auto& map : m_fineMaps) map.reset();
+    m_watchpointCount = 0;
+    for (auto& bp : m_breakpoints) {
+        if (bp.type() != BreakpointType::Exec) m_watchpointCount++;
+        const uint32_t low = bp.getLow() & 0x1fffffff;
+        const uint32_t high = bp.getHigh() & 0x1fffffff;
+        auto& fine = m_fineMaps[unsigned(bp.type())];
+        for (uint32_t i = low >> c_coarseShift; i <= (high >> c_coarseShift); i++) m_coarseMap.set(i);
+        for (uint32_t i = low >> c_fineShift; i <= (high >> c_fineShift); i++) fine.set(i);
     }
 }
 
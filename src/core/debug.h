@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <bitset>
 #include <functional>
 #include <string>
 
@@ -45,8 +46,27 @@ class Debug {
         checkBP(address, BreakpointType::Write, len, cause.c_str());
     }
 
+    // Hooks for the dynarecs, which compile breakpoints and watchpoints into their blocks
+    // instead of going through process(). They only trigger the user breakpoints, and
+    // never touch the CPU state, as they can be called from the middle of a block.
+    bool hasExecBreakpoint(uint32_t address);
+    bool hasWatchpoints() const { return m_watchpointCount != 0; }
+    bool isWatched(uint32_t address) {
+        uint32_t normalizedAddress = normalizeAddress(address & ~0xe0000000);
+        return mayHaveBreakpoint(normalizedAddress, BreakpointType::Read, 4) ||
+               mayHaveBreakpoint(normalizedAddress, BreakpointType::Write, 4);
+    }
+    // Bumped every time a breakpoint is added or removed, so compiled code knows when to go stale.
+    uint32_t breakpointsVersion() const { return m_breakpointsVersion; }
+    void checkExecBreakpoint(uint32_t pc) { triggerBreakpoints(pc, BreakpointType::Exec, 4, ""); }
+    void checkWatchpoint(uint32_t address, BreakpointType type, unsigned width) {
+        triggerBreakpoints(address, type, width, "");
+    }
+
   private:
     void checkBP(uint32_t address, BreakpointType type, uint32_t width, const char* cause = "");
+    void triggerBreakpoints(uint32_t address, BreakpointType type, uint32_t width, const char* cause);
+    void breakpointsChanged();
 
   public:
     // call this if PC is being set, like when the emulation is being reset, or when doing fastboot
@@ -137,7 +157,9 @@ class Debug {
         }) {
         uint32_t base = address & 0xe0000000;
         address &= ~0xe0000000;
-        return &*m_breakpoints.insert(address, address + width - 1, new Breakpoint(type, source, invoker, base));
+        auto bp = &*m_breakpoints.insert(address, address + width - 1, new Breakpoint(type, source, invoker, base));
+        breakpointsChanged();
+        return bp;
     }
     inline Breakpoint* addBreakpoint(
         uint32_t address, BreakpointType type, unsigned width, const std::string& source, std::string label,
@@ -147,19 +169,51 @@ class Debug {
         }) {
         uint32_t base = address & 0xe0000000;
         address &= ~0xe0000000;
-        return &*m_breakpoints.insert(address, address + width - 1, new Breakpoint(type, source, invoker, base, label));
+        auto bp =
+            &*m_breakpoints.insert(address, address + width - 1, new Breakpoint(type, source, invoker, base, label));
+        breakpointsChanged();
+        return bp;
     }
     const BreakpointTreeType& getTree() { return m_breakpoints; }
     const Breakpoint* lastBP() { return m_lastBP; }
     void removeBreakpoint(const Breakpoint* bp) {
         if (m_lastBP == bp) m_lastBP = nullptr;
         delete const_cast<Breakpoint*>(bp);
+        breakpointsChanged();
+    }
+    // Removes all the breakpoints held by an owner's list, such as a gdb client or a Lua wrapper.
+    // Breakpoints must never be deleted directly, or compiled code wouldn't know they are gone.
+    void removeBreakpoints(BreakpointUserListType& list) {
+        if (list.empty()) return;
+        if (m_lastBP && list.isLinked(m_lastBP)) m_lastBP = nullptr;
+        list.destroyAll();
+        breakpointsChanged();
     }
 
   private:
     bool triggerBP(Breakpoint* bp, uint32_t address, unsigned width, const char* reason = "");
     BreakpointTreeType m_breakpoints;
 
+    // Bitmaps over the 512MB physical address space, so that checking an address with no
+    // breakpoint nearby doesn't need to search the tree. The coarse one has a bit per 64KB
+    // for any kind of breakpoint, and the fine ones a bit per 256 bytes for each type.
+    // A set bit only means there may be a breakpoint there.
+    static constexpr unsigned c_coarseShift = 16;
+    static constexpr unsigned c_fineShift = 8;
+    std::bitset<(0x20000000 >> c_coarseShift)> m_coarseMap;
+    std::bitset<(0x20000000 >> c_fineShift)> m_fineMaps[3];
+    bool mayHaveBreakpoint(uint32_t normalizedAddress, BreakpointType type, uint32_t width) {
+        // Wide ranges only come from DMA, and aren't worth the trouble.
+        if (width > (1 << c_fineShift)) return true;
+        const uint32_t first = normalizedAddress;
+        const uint32_t last = (normalizedAddress + width - 1) & 0x1fffffff;
+        if (!m_coarseMap[first >> c_coarseShift] && !m_coarseMap[last >> c_coarseShift]) return false;
+        const auto& fine = m_fineMaps[unsigned(type)];
+        return fine[first >> c_fineShift] || fine[last >> c_fineShift];
+    }
+    unsigned m_watchpointCount = 0;
+    uint32_t m_breakpointsVersion = 0;
+
     uint8_t m_mainMemoryMap[0x00800000] = {0};
     uint8_t m_biosMemoryMap[0x00080000] = {0};
     uint8_t m_scratchPadMap[0x00000400] = {0};
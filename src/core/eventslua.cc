@@ -22,6 +22,7 @@
 #include "core/logger.h"
 #include "core/system.h"
 #include "support/eventbus.h"
+#include "support/instrumentation.h"
 
 namespace {
 
@@ -46,6 +47,17 @@ void pushEvent(PCSX::Lua L, const PCSX::Events::ExecutionFlow::Reset& e) {
     L.settable();
 }
 
+template <>
+void pushEvent(PCSX::Lua L, const PCSX::Events::ExecutionFlow::SaveStateSaved& e) {
+    L.newtable();
+    L.push("filename");
+    L.push(e.filename);
+    L.settable();
+    L.push("success");
+    L.push(e.success);
+    L.settable();
+}
+
 template <>
 void pushEvent(PCSX::Lua L, const PCSX::Events::GUI::JumpToPC& e) {
     L.newtable();
@@ -112,6 +124,7 @@ void createListener(PCSX::Lua L) {
         L.getfield("callback");
         pushEvent(L, e);
         try {
+            PCSX_INSTRUMENT(Lua);
             L.pcall(1);
         } catch (std::exception& e) {
             PCSX::g_system->log(PCSX::LogClass::LUA, "Error in event listener: %s", e.what());
@@ -183,6 +196,8 @@ void PCSX::LuaBindings::open_events(Lua L) {
             auto name = L.tostring(1);
             if (name == "Quitting") {
                 createListener<Events::Quitting>(L);
+            } else if (name == "SettingsChanged") {
+                createListener<Events::SettingsChanged>(L);
             } else if (name == "IsoMounted") {
                 createListener<Events::IsoMounted>(L);
             } else if (name == "GPU::Vsync") {
@@ -197,6 +212,8 @@ void PCSX::LuaBindings::open_events(Lua L) {
                 createListener<Events::ExecutionFlow::Reset>(L);
             } else if (name == "ExecutionFlow::SaveStateLoaded") {
                 createListener<Events::ExecutionFlow::SaveStateLoaded>(L);
+            } else if (name == "ExecutionFlow::SaveStateSaved") {
+                createListener<Events::ExecutionFlow::SaveStateSaved>(L);
             } else if (name == "GUI::JumpToPC") {
                 createListener<Events::GUI::JumpToPC>(L);
             } else if (name == "GUI::JumpToMemory") {
@@ -0,0 +1,140 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/fastmem.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+static int createBacking(size_t size) {
+#if defined(__linux__)
+    int fd = memfd_create("pcsx-redux-fastmem", MFD_CLOEXEC);
+#else
+    const std::string name = "/pcsx-redux-fastmem-" + std::to_string(getpid());
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd >= 0) shm_unlink(name.c_str());
+#endif
+    if (fd < 0) return -1;
+    if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool PCSX::FastMem::init() {
+    if (sysconf(_SC_PAGESIZE) != (1 << c_pageShift)) return false;
+    m_fd = createBacking(c_wramSize + c_hardSize);
+    if (m_fd < 0) return false;
+
+    void* wram = mmap(nullptr, c_wramSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    void* hard = mmap(nullptr, c_hardSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, c_wramSize);
+    void* base = mmap(nullptr, c_arenaSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if ((wram == MAP_FAILED) || (hard == MAP_FAILED) || (base == MAP_FAILED)) {
+        if (wram != MAP_FAILED) munmap(wram, c_wramSize);
+        if (hard != MAP_FAILED) munmap(hard, c_hardSize);
+        if (base != MAP_FAILED) munmap(base, c_arenaSize);
+        close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+    m_wram = static_cast<uint8_t*>(wram);
+    m_hard = static_cast<uint8_t*>(hard);
+    m_base = static_cast<uint8_t*>(base);
+
+    // The scratchpad is the first KB of the hardware area, and the rest of its
+    // page is unused; the hardware registers themselves start on the next one.
+    for (auto segment : {0x1f800000u, 0x9f800000u, 0xbf800000u}) {
+        mmap(m_base + segment, 1 << c_pageShift, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, m_fd, c_wramSize);
+    }
+    m_ramSize = 0;
+    setLayout(0x00200000, true);
+    return true;
+}
+
+PCSX::FastMem::~FastMem() {
+    if (!m_base) return;
+    munmap(m_base, c_arenaSize);
+    munmap(m_wram, c_wramSize);
+    munmap(m_hard, c_hardSize);
+    close(m_fd);
+}
+
+void PCSX::FastMem::setLayout(uint32_t ramSize, bool writable) {
+    if (!m_base) return;
+    if (ramSize != m_ramSize) {
+        for (auto segment : c_segments) {
+            for (uint32_t mirror = 0; mirror < c_wramSize; mirror += ramSize) {
+                mmap(m_base + segment + mirror, ramSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, m_fd, 0);
+            }
+        }
+        // Page numbers depend on the size of the mirrors.
+        const uint32_t mask = (ramSize >> c_pageShift) - 1;
+        const auto codePages = m_codePages;
+        m_codePages.reset();
+        for (uint32_t page = 0; page < codePages.size(); page++) {
+            if (codePages.test(page)) m_codePages.set(page & mask);
+        }
+        m_ramSize = ramSize;
+    } else if (writable == m_writable) {
+        return;
+    }
+    m_writable = writable;
+    applyProtection();
+}
+
+void PCSX::FastMem::unprotectCode() {
+    if (m_codePages.none()) return;
+    m_codePages.reset();
+    if (m_writable) applyProtection();
+}
+
+void PCSX::FastMem::protectPage(uint32_t page) {
+    for (auto segment : c_segments) {
+        for (uint32_t mirror = 0; mirror < c_wramSize; mirror += m_ramSize) {
+            mprotect(m_base + segment + mirror + (page << c_pageShift), 1 << c_pageShift, PROT_READ);
+        }
+    }
+}
+
+void PCSX::FastMem::applyProtection() {
+    const int prot = m_writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    for (auto segment : c_segments) mprotect(m_base + segment, c_wramSize, prot);
+    if (!m_writable) return;
+    for (uint32_t page = 0; page < (m_ramSize >> c_pageShift); page++) {
+        if (m_codePages.test(page)) protectPage(page);
+    }
+}
+
+#else
+
+bool PCSX::FastMem::init() { return false; }
+PCSX::FastMem::~FastMem() {}
+void PCSX::FastMem::setLayout(uint32_t ramSize, bool writable) {}
+void PCSX::FastMem::unprotectCode() {}
+void PCSX::FastMem::protectPage(uint32_t page) {}
+void PCSX::FastMem::applyProtection() {}
+
+#endif
@@ -0,0 +1,85 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <bitset>
+
+namespace PCSX {
+
+// Host mirror of the whole 32-bit guest address space, for the dynarec to turn
+// loads and stores into plain host memory accesses at base + guest address.
+// Main RAM is mapped along with its mirrors in KUSEG, KSEG0 and KSEG1, and so
+// is the page holding the scratchpad. Everything else is left inaccessible, so
+// that accesses to it fault, and the dynarec can send them the slow way.
+//
+// RAM and the hardware registers area are allocated from here as well, so the
+// regular pointers in Memory see the very same pages as the mirrors. Only
+// available on POSIX systems with 4KB pages; init() returns false otherwise.
+class FastMem {
+  public:
+    ~FastMem();
+    bool init();
+    bool enabled() const { return m_base != nullptr; }
+
+    uint8_t* getBase() { return m_base; }
+    uint8_t* getWRAM() { return m_wram; }
+    uint8_t* getHard() { return m_hard; }
+    bool contains(const void* address) const {
+        auto p = reinterpret_cast<const uint8_t*>(address);
+        return (p >= m_base) && (p < m_base + c_arenaSize);
+    }
+
+    // Maps RAM in as ramSize bytes repeated over its 8MB window. Mirrors are
+    // made read only when the CPU can't write to RAM, for instance while the
+    // cache is isolated, so that stores go through the regular handlers.
+    void setLayout(uint32_t ramSize, bool writable);
+
+    // Write protects the mirrors of the 4KB page holding this RAM offset, so
+    // that stores to pages with compiled code fault and the code gets cleared.
+    void protectCode(uint32_t ramOffset) {
+        const uint32_t page = (ramOffset & (m_ramSize - 1)) >> c_pageShift;
+        if (m_codePages.test(page)) return;
+        m_codePages.set(page);
+        if (m_writable) protectPage(page);
+    }
+    void unprotectCode();
+
+  private:
+    static constexpr uint64_t c_arenaSize = 0x100000000ULL;
+    static constexpr uint32_t c_wramSize = 0x00800000;
+    static constexpr uint32_t c_hardSize = 0x00010000;
+    static constexpr uint32_t c_pageShift = 12;
+    static constexpr uint32_t c_segments[3] = {0x00000000, 0x80000000, 0xa0000000};
+
+    void protectPage(uint32_t page);
+    void applyProtection();
+
+    uint8_t* m_base = nullptr;
+    uint8_t* m_wram = nullptr;
+    uint8_t* m_hard = nullptr;
+    int m_fd = -1;
+    uint32_t m_ramSize = 0x00200000;
+    bool m_writable = true;
+    std::bitset<(c_wramSize >> c_pageShift)> m_codePages;
+};
+
+}  // namespace PCSX
@@ -145,9 +145,98 @@ static int fromHexChar(char c) {
     return -1;
 }
 
+uint8_t PCSX::GdbClient::checksum(const uint8_t* data, size_t size) {
+    // The checksum is the sum of all the bytes modulo 256. Instead of going
+    // byte by byte, we add 8 bytes at a time into four 16-bits lanes. Each
+    // iteration adds at most 2 * 255 to each lane, so we need to fold the
+    // lanes every 128 words to avoid overflowing them.
+    constexpr uint64_t mask = 0x00ff00ff00ff00ffULL;
+    uint32_t sum = 0;
+    while (size >= 8) {
+        uint64_t lanes = 0;
+        size_t words = std::min(size / 8, size_t(128));
+        for (size_t i = 0; i < words; i++) {
+            uint64_t w;
+            memcpy(&w, data, sizeof(w));
+            lanes += (w & mask) + ((w >> 8) & mask);
+            data += 8;
+        }
+        size -= words * 8;
+        sum += uint32_t(lanes & 0xffff) + uint32_t((lanes >> 16) & 0xffff) + uint32_t((lanes >> 32) & 0xffff) +
+               uint32_t(lanes >> 48);
+    }
+    while (size--) sum += *data++;
+    return sum & 0xff;
+}
+
+void PCSX::GdbClient::escapeBinary(std::string& out, const uint8_t* data, size_t size) {
+    out.reserve(out.size() + size + size / 8);
+    for (size_t i = 0; i < size; i++) {
+        uint8_t c = data[i];
+        switch (c) {
+            case '#':
+            case '$':
+            case '}':
+            case '*':
+                out += '}';
+                out += char(c ^ 0x20);
+                break;
+            default:
+                out += char(c);
+                break;
+        }
+    }
+}
+
+PCSX::GdbClient::WriteRequest* PCSX::GdbClient::getPendingRequest() {
+    if (m_pending) return m_pending;
+    if (m_freeRequests.empty()) {
+        m_pending = new WriteRequest();
+    } else {
+        m_pending = m_freeRequests.back();
+        m_freeRequests.pop_back();
+    }
+    return m_pending;
+}
+
+void PCSX::GdbClient::queuePacket(Slice&& payload) {
+    if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::GdbServerTrace>()) {
+        std::string msg((const char*)payload.data(), payload.size());
+        g_system->log(LogClass::GDB, "GDB <-- PCSX %s\n", msg.c_str());
+    }
+    auto req = getPendingRequest();
+    uint8_t chksum = checksum(payload.data<uint8_t>(), payload.size());
+    char after[3] = {'#', toHex[chksum >> 4], toHex[chksum & 0x0f]};
+    req->m_slices.emplace_back("$");
+    req->m_slices.emplace_back(std::move(payload));
+    req->m_slices.emplace_back().copy(after, 3);
+    if (!m_corked) flush();
+}
+
+void PCSX::GdbClient::queueRaw(Slice&& data) {
+    if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::GdbServerTrace>()) {
+        std::string msg((const char*)data.data(), data.size());
+        g_system->log(LogClass::GDB, "GDB <-- PCSX %s\n", msg.c_str());
+    }
+    getPendingRequest()->m_slices.emplace_back(std::move(data));
+    if (!m_corked) flush();
+}
+
+void PCSX::GdbClient::flush() {
+    auto req = m_pending;
+    if (!req) return;
+    m_pending = nullptr;
+    if (m_status != OPEN) {
+        recycle(req);
+        return;
+    }
+    req->enqueue(this);
+}
+
 void PCSX::GdbClient::processData(const Slice& slice) {
     const char* ptr = reinterpret_cast<const char*>(slice.data());
     auto size = slice.size();
+    m_corked = true;
     while (size) {
         if (m_passthrough) {  // passthrough
             Slice passthrough;
@@ -216,6 +305,8 @@ void PCSX::GdbClient::processData(const Slice& slice) {
                 break;
         }
     }
+    m_corked = false;
+    flush();
 }
 
 static std::pair<uint32_t, bool> parseHexNumber(const char* str) {
@@ -395,6 +486,23 @@ void PCSX::GdbClient::writePaged(const std::string& out, const std::string& curs
     }
 }
 
+void PCSX::GdbClient::writeBinaryPaged(const uint8_t* data, size_t size, const std::string& cursorStr) {
+    auto [off, len] = parseCursor(cursorStr);
+    std::string reply;
+    if (off >= size) {
+        write("l");
+        return;
+    }
+    // The reply can grow up to twice the requested length when escaping, so
+    // cap the chunk to what fits in a packet.
+    len = std::min(len, uint64_t(PACKET_SIZE / 2));
+    bool last = len >= (size - off);
+    if (last) len = size - off;
+    reply += last ? 'l' : 'm';
+    escapeBinary(reply, data + off, len);
+    write(std::move(reply));
+}
+
 void PCSX::GdbClient::writeEscaped(const std::string& out) {
     std::string escaped;
     escaped.reserve(out.length() * 2 + 1);
@@ -477,6 +585,7 @@ void PCSX::GdbClient::processCommand() {
     static const auto qXferFeatures = "qXfer:features:read:target.xml:"sv;
     static const auto qXferThreads = "qXfer:threads:read::"sv;
     static const auto qXferMemMap = "qXfer:memory-map:read::"sv;
+    static const auto qXferRam = "qXfer:ram:read::"sv;
     static const auto qSymbol = "qSymbol:"sv;
     if (m_cmd == "!") {
         // extended mode?
@@ -559,20 +668,46 @@ void PCSX::GdbClient::processCommand() {
             i++;
         }
         write("OK");
+    } else if (m_cmd[0] == 'X') {
+        // write memory, binary
+        auto colon = m_cmd.find(':');
+        if (colon == std::string::npos) {
+            write("E00");
+            return;
+        }
+        auto [off, len] = parseCursor(m_cmd.substr(1, colon - 1));
+        if ((m_cmd.length() - colon - 1) < len) {
+            write("E00");
+            return;
+        }
+        IO<File> memFile = g_emulator->m_mem->getMemoryAsFile();
+        memFile->writeAt(m_cmd.data() + colon + 1, len, off);
+        write("OK");
     } else if (m_cmd[0] == 'm') {
         // read memory
         auto [off, len] = parseCursor(m_cmd.substr(1));
-        startStream();
+        len = std::min(len, uint64_t(PACKET_SIZE / 2));
+        std::vector<uint8_t> buffer(len);
         IO<File> memFile = g_emulator->m_mem->getMemoryAsFile();
-        memFile->rSeek(off);
-        while (len--) {
-            uint8_t v = memFile->read<uint8_t>();
-            char s[3] = {0, 0, 0};
-            s[0] = toHex[v >> 4];
-            s[1] = toHex[(v & 0x0f)];
-            stream(s);
+        memFile->readAt(buffer.data(), len, off);
+        std::string reply;
+        reply.resize(len * 2);
+        for (size_t i = 0; i < len; i++) {
+            uint8_t v = buffer[i];
+            reply[i * 2 + 0] = toHex[v >> 4];
+            reply[i * 2 + 1] = toHex[v & 0x0f];
         }
-        stopStream();
+        write(std::move(reply));
+    } else if (m_cmd[0] == 'x') {
+        // read memory, binary
+        auto [off, len] = parseCursor(m_cmd.substr(1));
+        len = std::min(len, uint64_t(PACKET_SIZE / 2));
+        std::vector<uint8_t> buffer(len);
+        IO<File> memFile = g_emulator->m_mem->getMemoryAsFile();
+        memFile->readAt(buffer.data(), len, off);
+        std::string reply = "b";
+        escapeBinary(reply, buffer.data(), len);
+        write(std::move(reply));
     } else if ((m_cmd[0] == 'z') || (m_cmd[0] == 'Z')) {
         // insert or remove breakpoint
         enum class Action {
@@ -667,7 +802,9 @@ void PCSX::GdbClient::processCommand() {
                 multiprocess = true;
             }
         }
-        std::string answer = "PacketSize=47ff;qXfer:threads:read+;QStartNoAckMode+";
+        // qXfer:ram is our own extension, see below; gdb ignores the features it doesn't know about.
+        std::string answer = fmt::format(
+            "PacketSize={:x};qXfer:threads:read+;qXfer:ram:read+;QStartNoAckMode+;binary-upload+", PACKET_SIZE);
         if (multiprocess) {
             answer += ";multiprocess+";
         }
@@ -696,6 +833,14 @@ void PCSX::GdbClient::processCommand() {
     } else if (StringsHelpers::startsWith(m_cmd, qXferFeatures) &&
                g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::GdbManifest>()) {
         writePaged(targetXML, m_cmd.substr(qXferFeatures.length()));
+    } else if (StringsHelpers::startsWith(m_cmd, qXferRam)) {
+        // This is a PCSX extension, and not an object from the gdb protocol: stock
+        // gdb will never ask for it, and reads memory through the 'm' and 'x' packets.
+        // It is meant for custom clients and scripts, e.g. through gdb's
+        // "maint packet qXfer:ram:read::offset,length", which want a bulk transfer of
+        // the main RAM, as raw binary, without going through the memory lookup tables.
+        size_t size = g_emulator->m_mem->getBusConfig().ramSize;
+        writeBinaryPaged(g_emulator->m_mem->m_wram, size, m_cmd.substr(qXferRam.length()));
     } else if (StringsHelpers::startsWith(m_cmd, qXferThreads)) {
         writePaged("<threads><thread id=\"p1.t1\" core=\"0\" name=\"MainThread\"/></threads>",
                    m_cmd.substr(qXferThreads.length()));
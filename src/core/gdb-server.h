@@ -23,6 +23,7 @@
 
 #include <cstdarg>
 #include <string>
+#include <vector>
 
 #include "core/debug.h"
 #include "core/psxemulator.h"
@@ -38,7 +39,9 @@ class GdbClient : public Intrusive::List<GdbClient>::Node {
     GdbClient(uv_tcp_t* srv);
     ~GdbClient() {
         assert(m_requests.size() == 0);
-        m_breakpoints.destroyAll();
+        g_emulator->m_debug->removeBreakpoints(m_breakpoints);
+        delete m_pending;
+        for (auto req : m_freeRequests) delete req;
     }
     typedef Intrusive::List<GdbClient> ListType;
 
@@ -57,34 +60,37 @@ class GdbClient : public Intrusive::List<GdbClient>::Node {
     }
 
   private:
+    // All the outgoing packets are framed into a pending WriteRequest, which
+    // gets flushed as a single vectored uv_write. While we are processing
+    // incoming data, the client is corked, so that all the replies to a batch
+    // of commands coalesce into the same write.
     void write(const Slice& slice) {
-        auto* req = new WriteRequest();
-        req->m_slice = slice;
-        req->enqueue(this);
+        Slice copy = slice;
+        queuePacket(std::move(copy));
     }
+    void write(Slice&& slice) { queuePacket(std::move(slice)); }
     void write(const std::string& msg) {
-        auto* req = new WriteRequest();
         assert(msg.size() <= std::numeric_limits<uint32_t>::max());
-        req->m_slice.copy(msg);
-        req->enqueue(this);
+        Slice slice;
+        slice.copy(msg);
+        queuePacket(std::move(slice));
     }
     void write(std::string&& msg) {
-        auto* req = new WriteRequest();
         assert(msg.size() <= std::numeric_limits<uint32_t>::max());
-        req->m_slice.acquire(std::move(msg));
-        req->enqueue(this);
+        Slice slice;
+        slice.acquire(std::move(msg));
+        queuePacket(std::move(slice));
     }
     template <size_t L>
     void write(const char (&str)[L]) {
-        auto* req = new WriteRequest();
         static_assert((L - 1) <= std::numeric_limits<uint32_t>::max());
-        req->m_slice.borrow(str, L - 1);
-        req->enqueue(this);
+        Slice slice;
+        slice.borrow(str, L - 1);
+        queuePacket(std::move(slice));
     }
     void writef(const char* fmt, ...) {
         va_list a;
         va_start(a, fmt);
-        auto* req = new WriteRequest();
         size_t len;
         char* msg;
 #ifdef _WIN32
@@ -94,94 +100,79 @@ class GdbClient : public Intrusive::List<GdbClient>::Node {
 #else
         len = vasprintf(&msg, fmt, a);
 #endif
-        req->m_slice.acquire(msg, len);
-        req->enqueue(this);
+        Slice slice;
+        slice.acquire(msg, len);
+        queuePacket(std::move(slice));
         va_end(a);
     }
     void writePaged(const std::string& out, const std::string& cursorStr);
+    void writeBinaryPaged(const uint8_t* data, size_t size, const std::string& cursorStr);
     void writeEscaped(const std::string& out);
     void sendAck() {
-        auto* req = new WriteRequest();
-        req->m_slice.copy("+", 1);
-        req->enqueueRaw(this);
+        Slice slice;
+        slice.borrow("+", 1);
+        queueRaw(std::move(slice));
     }
 
-    void startStream() {
-        m_crc = 0;
-        auto* req = new WriteRequest();
-        req->m_slice.copy("$", 1);
-        req->enqueueRaw(this);
-    }
+    void startStream() { m_stream.clear(); }
+    void stream(const std::string& data) { m_stream += data; }
+    void stopStream() { write(std::move(m_stream)); }
 
-    void stream(const std::string& data) {
-        for (int i = 0; i < data.length(); i++) {
-            m_crc += data[i];
-        }
-        auto* req = new WriteRequest();
-        req->m_slice.copy(data.data(), data.size());
-        req->enqueueRaw(this);
-    }
-
-    void stopStream() {
-        auto* req = new WriteRequest();
-        char end[3] = {'#'};
-        end[1] = toHex[m_crc >> 4];
-        end[2] = toHex[m_crc & 0x0f];
-        req->m_slice.copy(end, 3);
-        req->enqueueRaw(this);
-    }
+    static void escapeBinary(std::string& out, const uint8_t* data, size_t size);
+    static uint8_t checksum(const uint8_t* data, size_t size);
+    void queuePacket(Slice&& payload);
+    void queueRaw(Slice&& data);
+    void flush();
+    struct WriteRequest;
+    WriteRequest* getPendingRequest();
 
     static const char toHex[];
     struct WriteRequest : public Intrusive::HashTable<uintptr_t, WriteRequest>::Node {
         void enqueue(GdbClient* client) {
-            if (g_emulator->settings.get<Emulator::SettingDebugSettings>()
-                    .get<Emulator::DebugSettings::GdbServerTrace>()) {
-                std::string msg((const char*)m_slice.data(), m_slice.size());
-                g_system->log(LogClass::GDB, "GDB <-- PCSX %s\n", msg.c_str());
+            // The buffers are only computed now, as the slices vector may
+            // have been reallocated while packets were being queued, and
+            // inlined slices hold their data within themselves.
+            m_bufs.resize(m_slices.size());
+            for (size_t i = 0; i < m_slices.size(); i++) {
+                m_bufs[i].base = static_cast<char*>(const_cast<void*>(m_slices[i].data()));
+                m_bufs[i].len = m_slices[i].size();
             }
-            m_bufs[0].base = &m_before;
-            m_bufs[0].len = 1;
-            m_bufs[1].base = static_cast<char*>(const_cast<void*>(m_slice.data()));
-            m_bufs[1].len = m_slice.size();
-            m_bufs[2].base = m_after;
-            m_bufs[2].len = 3;
-            uint8_t chksum = 0;
-            auto data = m_bufs[1].base;
-            auto len = m_bufs[1].len;
-            for (int i = 0; i < len; i++) {
-                chksum += *data++;
-            }
-            m_after[1] = toHex[chksum >> 4];
-            m_after[2] = toHex[chksum & 0x0f];
             client->m_requests.insert(reinterpret_cast<uintptr_t>(&m_req), this);
-            uv_write(&m_req, reinterpret_cast<uv_stream_t*>(&client->m_tcp), m_bufs, 3, writeCB);
+            uv_write(&m_req, reinterpret_cast<uv_stream_t*>(&client->m_tcp), m_bufs.data(), m_bufs.size(), writeCB);
         }
-        void enqueueRaw(GdbClient* client) {
-            if (g_emulator->settings.get<Emulator::SettingDebugSettings>()
-                    .get<Emulator::DebugSettings::GdbServerTrace>()) {
-                std::string msg((const char*)m_slice.data(), m_slice.size());
-                g_system->log(LogClass::GDB, "GDB <-- PCSX %s\n", msg.c_str());
-            }
-            m_bufs[0].base = static_cast<char*>(const_cast<void*>(m_slice.data()));
-            m_bufs[0].len = m_slice.size();
-            client->m_requests.insert(reinterpret_cast<uintptr_t>(&m_req), this);
-            uv_write(&m_req, reinterpret_cast<uv_stream_t*>(&client->m_tcp), m_bufs, 1, writeCB);
+        void clear() {
+            m_slices.clear();
+            m_bufs.clear();
         }
         static void writeCB(uv_write_t* request, int status) {
             GdbClient* client = static_cast<GdbClient*>(request->handle->data);
             auto self = client->m_requests.find(reinterpret_cast<uintptr_t>(request));
-            delete &*self;
+            WriteRequest* req = &*self;
+            req->unlink();
+            client->recycle(req);
             if (status != 0) client->close();
         }
         uv_write_t m_req;
-        char m_before = '$';
-        char m_after[3] = {'#'};
-        uv_buf_t m_bufs[3];
-        Slice m_slice;
+        std::vector<uv_buf_t> m_bufs;
+        std::vector<Slice> m_slices;
     };
+    void recycle(WriteRequest* req) {
+        req->clear();
+        if (m_freeRequests.size() >= MAX_FREE_REQUESTS) {
+            delete req;
+        } else {
+            m_freeRequests.push_back(req);
+        }
+    }
     friend struct WriteRequest;
     Intrusive::HashTable<uintptr_t, WriteRequest> m_requests;
-    static constexpr size_t BUFFER_SIZE = 256;
+    std::vector<WriteRequest*> m_freeRequests;
+    WriteRequest* m_pending = nullptr;
+    bool m_corked = false;
+    std::string m_stream;
+    static constexpr size_t MAX_FREE_REQUESTS = 8;
+    static constexpr size_t PACKET_SIZE = 0x40000;
+    static constexpr size_t BUFFER_SIZE = 16384;
     static void allocTrampoline(uv_handle_t* handle, size_t suggestedSize, uv_buf_t* buf) {
         GdbClient* client = static_cast<GdbClient*>(handle->data);
         client->alloc(suggestedSize, buf);
@@ -26,6 +26,7 @@
 #include "core/psxhw.h"
 #include "imgui/imgui.h"
 #include "magic_enum/include/magic_enum/magic_enum_all.hpp"
+#include "support/instrumentation.h"
 
 #define GPUSTATUS_READYFORVRAM 0x08000000
 #define GPUSTATUS_IDLE 0x04000000  // CMD ready
@@ -468,6 +469,7 @@ uint32_t PCSX::GPU::readStatus() {
 }
 
 void PCSX::GPU::dma(uint32_t madr, uint32_t bcr, uint32_t chcr) {  // GPU
+    PCSX_INSTRUMENT(GPU);
     uint32_t *ptr;
     uint32_t size, bs;
 
@@ -483,7 +485,7 @@ void PCSX::GPU::dma(uint32_t madr, uint32_t bcr, uint32_t chcr) {  // GPU
             size = (bcr >> 16) * (bcr & 0xffff);
             directDMARead(ptr, size, madr);
             g_emulator->m_cpu->Clear(madr, size);
-            if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>()) {
+            if (g_emulator->m_mem->getBusConfig().debug) {
                 g_emulator->m_debug->checkDMAwrite(2, madr, size * 4);
             }
 #if 1
@@ -505,10 +507,9 @@ void PCSX::GPU::dma(uint32_t madr, uint32_t bcr, uint32_t chcr) {  // GPU
                 PSXDMA_LOG("*** DMA2 GPU - mem2vram *** NULL Pointer!!!\n");
                 break;
             }
-            if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>()) {
+            if (g_emulator->m_mem->getBusConfig().debug) {
                 g_emulator->m_debug->checkDMAread(2, madr, size * 4);
             }
-            pgxpMemory(PGXP_ConvertAddress(madr), PGXP_GetMem());
             directDMAWrite(ptr, size, madr);
 
 #if 0
@@ -623,6 +624,7 @@ void PCSX::GPU::writeStatus(uint32_t value) {
 uint32_t PCSX::GPU::readData() { return m_readFifo.asA<File>()->read<uint32_t>(); }
 
 void PCSX::GPU::writeData(uint32_t value) {
+    PCSX_INSTRUMENT(GPU);
     Buffer buf(value);
     m_processor->processWrite(buf, Logged::Origin::DATAWRITE, value, 1);
 }
@@ -644,7 +646,7 @@ void PCSX::GPU::chainedDMAWrite(const uint32_t *memory, uint32_t hwAddr) {
 
     s_usedAddr[0] = s_usedAddr[1] = s_usedAddr[2] = 0xffffff;
 
-    const bool ramExpansion = PCSX::g_emulator->settings.get<PCSX::Emulator::Setting8MB>();
+    const bool ramExpansion = PCSX::g_emulator->m_mem->getBusConfig().ramExpansion;
 
     do {
         addr &= ramExpansion ? 0x7ffffc : 0x1ffffc;
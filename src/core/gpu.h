@@ -96,10 +96,8 @@ class GPU {
     virtual void addVertex(short sx, short sy, int64_t fx, int64_t fy, int64_t fz) {
         throw std::runtime_error("Not yet implemented");
     }
-    virtual void pgxpMemory(unsigned int addr, unsigned char *pVRAM) {}
-    virtual void pgxpCacheVertex(short sx, short sy, const unsigned char *_pVertex) {
-        throw std::runtime_error("Not yet implemented");
-    }
+    // None of the GPUs consume the cached PGXP vertices yet.
+    virtual void pgxpCacheVertex(short sx, short sy, const unsigned char *_pVertex) {}
 
     virtual void setDither(int setting) = 0;
     void reset() {
@@ -41,6 +41,16 @@ IsoReader* createIsoReader(LuaIso* wrapper);
 void deleteIsoReader(IsoReader* isoReader);
 bool isReaderFailed(IsoReader* reader);
 LuaFile* readerOpen(IsoReader* reader, const char* path);
+typedef struct {
+    const char* path;
+    uint32_t lba;
+    uint32_t size;
+    uint16_t xaAttribs;
+    bool directory;
+} IsoEntryInfo;
+uint32_t readerEntriesCount(IsoReader* reader);
+bool readerGetEntry(IsoReader* reader, uint32_t index, IsoEntryInfo* info);
+uint32_t readerExtractAll(IsoReader* reader, const char* path, uint32_t threads);
 LuaFile* fileisoOpen(LuaIso* wrapper, uint32_t lba, uint32_t size, enum SectorMode mode);
 
 typedef struct { char opaque[?]; } ISO9660Builder;
@@ -48,6 +58,7 @@ ISO9660Builder* createIsoBuilder(LuaFile* out);
 void deleteIsoBuilder(ISO9660Builder* builder);
 void isoBuilderWriteLicense(ISO9660Builder* builder, LuaFile*);
 void isoBuilderWriteSector(ISO9660Builder* builder, const uint8_t* sectorData, enum SectorMode mode);
+void isoBuilderFlush(ISO9660Builder* builder);
 void isoBuilderClose(ISO9660Builder* builder);
 
 ]]
@@ -58,6 +69,24 @@ local function createIsoReaderWrapper(isoReader)
     local reader = {
         _wrapper = ffi.gc(isoReader, C.deleteIsoReader),
         open = function(self, fname) return Support.File._createFileWrapper(C.readerOpen(self._wrapper, fname)) end,
+        listAll = function(self)
+            local info = ffi.new('IsoEntryInfo')
+            local entries = {}
+            for i = 0, C.readerEntriesCount(self._wrapper) - 1 do
+                C.readerGetEntry(self._wrapper, i, info)
+                entries[#entries + 1] = {
+                    path = ffi.string(info.path),
+                    lba = info.lba,
+                    size = info.size,
+                    xaAttribs = info.xaAttribs,
+                    directory = info.directory,
+                }
+            end
+            return entries
+        end,
+        extractAll = function(self, path, threads)
+            return C.readerExtractAll(self._wrapper, path, threads or 0)
+        end,
     }
     return reader
 end
@@ -97,6 +126,7 @@ local function createIsoBuilderWrapper(wrapper)
             if Support.isLuaBuffer(sectorData) then sectorData = sectorData.data end
             C.isoBuilderWriteSector(self._wrapper, sectorData, mode)
         end,
+        flush = function(self) C.isoBuilderFlush(self._wrapper) end,
         close = function(self) C.isoBuilderClose(self._wrapper) end,
     }
     return iso
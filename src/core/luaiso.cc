@@ -53,6 +53,29 @@ bool isReaderFailed(PCSX::ISO9660Reader* reader) { return reader->failed(); }
 PCSX::LuaFFI::LuaFile* readerOpen(PCSX::ISO9660Reader* reader, const char* path) {
     return new PCSX::LuaFFI::LuaFile(reader->open(path));
 }
+struct IsoEntryInfo {
+    const char* path;
+    uint32_t lba;
+    uint32_t size;
+    uint16_t xaAttribs;
+    bool directory;
+};
+
+uint32_t readerEntriesCount(PCSX::ISO9660Reader* reader) { return reader->listAll().size(); }
+bool readerGetEntry(PCSX::ISO9660Reader* reader, uint32_t index, IsoEntryInfo* info) {
+    auto& entries = reader->listAll();
+    if (index >= entries.size()) return false;
+    auto& entry = entries[index];
+    info->path = entry.path.c_str();
+    info->lba = entry.lba;
+    info->size = entry.size;
+    info->xaAttribs = entry.xaAttribs;
+    info->directory = entry.directory;
+    return true;
+}
+uint32_t readerExtractAll(PCSX::ISO9660Reader* reader, const char* path, uint32_t threads) {
+    return reader->extractAll(path, threads);
+}
 PCSX::LuaFFI::LuaFile* fileisoOpen(LuaIso* wrapper, uint32_t lba, uint32_t size, PCSX::SectorMode mode) {
     return new PCSX::LuaFFI::LuaFile(new PCSX::CDRIsoFile(wrapper->iso, lba, size, mode));
 }
@@ -67,6 +90,7 @@ void isoBuilderWriteLicense(PCSX::ISO9660Builder* builder, PCSX::LuaFFI::LuaFile
 void isoBuilderWriteSector(PCSX::ISO9660Builder* builder, const uint8_t* sectorData, PCSX::SectorMode mode) {
     builder->writeSector(sectorData, mode);
 }
+void isoBuilderFlush(PCSX::ISO9660Builder* builder) { builder->flush(); }
 void isoBuilderClose(PCSX::ISO9660Builder* builder) { builder->close(); }
 
 }  // namespace
@@ -96,12 +120,16 @@ static void registerAllSymbols(PCSX::Lua L) {
     REGISTER(L, deleteIsoReader);
     REGISTER(L, isReaderFailed);
     REGISTER(L, readerOpen);
+    REGISTER(L, readerEntriesCount);
+    REGISTER(L, readerGetEntry);
+    REGISTER(L, readerExtractAll);
     REGISTER(L, fileisoOpen);
 
     REGISTER(L, createIsoBuilder);
     REGISTER(L, deleteIsoBuilder);
     REGISTER(L, isoBuilderWriteLicense);
     REGISTER(L, isoBuilderWriteSector);
+    REGISTER(L, isoBuilderFlush);
     REGISTER(L, isoBuilderClose);
 
     L.settable();
@@ -22,6 +22,7 @@
 
 #include "core/debug.h"
 #include "core/psxemulator.h"
+#include "support/instrumentation.h"
 
 #define AAN_CONST_BITS 12
 #define AAN_PRESCALE_BITS 16
@@ -395,6 +396,7 @@ uint32_t PCSX::MDEC::read1(void) {
 }
 
 void PCSX::MDEC::dma0(uint32_t adr, uint32_t bcr, uint32_t chcr) {
+    PCSX_INSTRUMENT(MDEC);
     int cmd = mdec.reg0;
     int size;
 
@@ -406,7 +408,7 @@ void PCSX::MDEC::dma0(uint32_t adr, uint32_t bcr, uint32_t chcr) {
     mdec.reg1 |= MDEC1_STP;
 
     size = (bcr >> 16) * (bcr & 0xffff);
-    if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>()) {
+    if (g_emulator->m_mem->getBusConfig().debug) {
         g_emulator->m_debug->checkDMAread(0, adr, size * 4);
     }
 
@@ -468,6 +470,7 @@ void PCSX::MDEC::mdec0Interrupt() {
 #define SIZE_OF_16B_BLOCK (16 * 16 * 2)
 
 void PCSX::MDEC::dma1(uint32_t adr, uint32_t bcr, uint32_t chcr) {
+    PCSX_INSTRUMENT(MDEC);
     int blk[DSIZE2 * 6];
     uint8_t *image;
     int size;
@@ -480,7 +483,7 @@ void PCSX::MDEC::dma1(uint32_t adr, uint32_t bcr, uint32_t chcr) {
     size *= 4;
     /* I guess the memory speed is limitating */
     dmacnt = size;
-    if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>()) {
+    if (g_emulator->m_mem->getBusConfig().debug) {
         g_emulator->m_debug->checkDMAwrite(1, adr, size);
     }
 
@@ -0,0 +1,346 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/memory-scanner.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_AMD64) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MEMORY_SCANNER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+using ScanType = PCSX::MemoryScanner::ScanType;
+using ValueType = PCSX::MemoryScanner::ValueType;
+
+// Spawning threads costs more than scanning small chunks of memory.
+constexpr size_t c_minWordsPerThread = 2048;
+
+struct Job {
+    const uint8_t* mem;
+    const uint8_t* old;
+    uint64_t* bits;
+    uint32_t slots;
+    int64_t value;
+    bool first;
+};
+
+using ScanFunction = size_t (*)(const Job& job, size_t begin, size_t end);
+
+constexpr bool isDelta(ScanType scan) {
+    return (scan == ScanType::Changed) || (scan == ScanType::Unchanged) || (scan == ScanType::Increased) ||
+           (scan == ScanType::Decreased);
+}
+
+template <typename T, ScanType scan>
+bool matches(T current, T old, T value) {
+    if constexpr (scan == ScanType::ExactValue) return current == value;
+    if constexpr (scan == ScanType::GreaterThan) return current > value;
+    if constexpr (scan == ScanType::LessThan) return current < value;
+    if constexpr (scan == ScanType::Changed) return current != old;
+    if constexpr (scan == ScanType::Unchanged) return current == old;
+    if constexpr (scan == ScanType::Increased) return current > old;
+    if constexpr (scan == ScanType::Decreased) return current < old;
+    return true;
+}
+
+template <typename T, ScanType scan>
+uint64_t scalarWord(const uint8_t* current, const uint8_t* old, T value, unsigned count) {
+    uint64_t bits = 0;
+    for (unsigned i = 0; i < count; i++) {
+        T c, o = 0;
+        memcpy(&c, current + i * sizeof(T), sizeof(T));
+        if constexpr (isDelta(scan)) memcpy(&o, old + i * sizeof(T), sizeof(T));
+        bits |= uint64_t(matches<T, scan>(c, o, value)) << i;
+    }
+    return bits;
+}
+
+#ifdef MEMORY_SCANNER_SSE2
+template <typename T>
+struct Lanes {
+    static constexpr unsigned c_count = 16 / sizeof(T);
+
+    static __m128i set1(T value) {
+        if constexpr (sizeof(T) == 1) return _mm_set1_epi8(static_cast<char>(value));
+        if constexpr (sizeof(T) == 2) return _mm_set1_epi16(static_cast<short>(value));
+        if constexpr (sizeof(T) == 4) return _mm_set1_epi32(static_cast<int>(value));
+    }
+    static __m128i eq(__m128i a, __m128i b) {
+        if constexpr (sizeof(T) == 1) return _mm_cmpeq_epi8(a, b);
+        if constexpr (sizeof(T) == 2) return _mm_cmpeq_epi16(a, b);
+        if constexpr (sizeof(T) == 4) return _mm_cmpeq_epi32(a, b);
+    }
+    static __m128i gt(__m128i a, __m128i b) {
+        // SSE2 only has signed comparisons; flipping the sign bits
+        // turns them into unsigned ones.
+        if constexpr (std::is_unsigned_v<T>) {
+            const __m128i bias = set1(static_cast<T>(T(1) << (sizeof(T) * 8 - 1)));
+            a = _mm_xor_si128(a, bias);
+            b = _mm_xor_si128(b, bias);
+        }
+        if constexpr (sizeof(T) == 1) return _mm_cmpgt_epi8(a, b);
+        if constexpr (sizeof(T) == 2) return _mm_cmpgt_epi16(a, b);
+        if constexpr (sizeof(T) == 4) return _mm_cmpgt_epi32(a, b);
+    }
+    // One bit per lane.
+    static unsigned mask(__m128i m) {
+        if constexpr (sizeof(T) == 1) return _mm_movemask_epi8(m);
+        if constexpr (sizeof(T) == 2) return _mm_movemask_epi8(_mm_packs_epi16(m, _mm_setzero_si128()));
+        if constexpr (sizeof(T) == 4) return _mm_movemask_ps(_mm_castsi128_ps(m));
+    }
+};
+
+template <typename T, ScanType scan>
+uint64_t simdWord(const uint8_t* current, const uint8_t* old, T value) {
+    using L = Lanes<T>;
+    const __m128i v = L::set1(value);
+    uint64_t bits = 0;
+    for (unsigned i = 0; i < 64; i += L::c_count) {
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + i * sizeof(T)));
+        __m128i o = _mm_setzero_si128();
+        if constexpr (isDelta(scan)) o = _mm_loadu_si128(reinterpret_cast<const __m128i*>(old + i * sizeof(T)));
+        __m128i m;
+        if constexpr (scan == ScanType::ExactValue) m = L::eq(c, v);
+        if constexpr (scan == ScanType::GreaterThan) m = L::gt(c, v);
+        if constexpr (scan == ScanType::LessThan) m = L::gt(v, c);
+        if constexpr ((scan == ScanType::Changed) || (scan == ScanType::Unchanged)) m = L::eq(c, o);
+        if constexpr (scan == ScanType::Increased) m = L::gt(c, o);
+        if constexpr (scan == ScanType::Decreased) m = L::gt(o, c);
+        bits |= uint64_t(L::mask(m)) << i;
+    }
+    if constexpr (scan == ScanType::Changed) bits = ~bits;
+    return bits;
+}
+#endif
+
+template <typename T, ScanType scan>
+uint64_t matchWord(const uint8_t* current, const uint8_t* old, T value, unsigned count) {
+#ifdef MEMORY_SCANNER_SSE2
+    if (count == 64) return simdWord<T, scan>(current, old, value);
+#endif
+    return scalarWord<T, scan>(current, old, value, count);
+}
+
+template <typename T, ScanType scan>
+size_t scanWords(const Job& job, size_t begin, size_t end) {
+    const T value = static_cast<T>(job.value);
+    size_t count = 0;
+    for (size_t w = begin; w < end; w++) {
+        uint64_t bits = job.first ? ~uint64_t(0) : job.bits[w];
+        if (!bits) continue;
+        const unsigned slots = std::min<size_t>(64, job.slots - w * 64);
+        const size_t offset = w * 64 * sizeof(T);
+        if constexpr (scan != ScanType::UnknownInitialValue) {
+            bits &= matchWord<T, scan>(job.mem + offset, job.old + offset, value, slots);
+        } else if (slots < 64) {
+            bits &= (uint64_t(1) << slots) - 1;
+        }
+        job.bits[w] = bits;
+        count += std::popcount(bits);
+    }
+    return count;
+}
+
+template <typename T>
+ScanFunction pickFunction(ScanType scan) {
+    switch (scan) {
+        case ScanType::ExactValue:
+            return scanWords<T, ScanType::ExactValue>;
+        case ScanType::GreaterThan:
+            return scanWords<T, ScanType::GreaterThan>;
+        case ScanType::LessThan:
+            return scanWords<T, ScanType::LessThan>;
+        case ScanType::Changed:
+            return scanWords<T, ScanType::Changed>;
+        case ScanType::Unchanged:
+            return scanWords<T, ScanType::Unchanged>;
+        case ScanType::Increased:
+            return scanWords<T, ScanType::Increased>;
+        case ScanType::Decreased:
+            return scanWords<T, ScanType::Decreased>;
+        case ScanType::UnknownInitialValue:
+            return scanWords<T, ScanType::UnknownInitialValue>;
+    }
+    return nullptr;
+}
+
+ScanFunction pickFunction(ValueType type, ScanType scan) {
+    switch (type) {
+        case ValueType::Char:
+            return pickFunction<int8_t>(scan);
+        case ValueType::Uchar:
+            return pickFunction<uint8_t>(scan);
+        case ValueType::Short:
+            return pickFunction<int16_t>(scan);
+        case ValueType::Ushort:
+            return pickFunction<uint16_t>(scan);
+        case ValueType::Int:
+            return pickFunction<int32_t>(scan);
+        case ValueType::Uint:
+            return pickFunction<uint32_t>(scan);
+    }
+    return nullptr;
+}
+
+template <typename T>
+int64_t readAs(const uint8_t* mem, uint32_t offset) {
+    T value;
+    memcpy(&value, mem + offset, sizeof(T));
+    return value;
+}
+
+}  // namespace
+
+unsigned PCSX::MemoryScanner::stride(ValueType type) {
+    switch (type) {
+        case ValueType::Char:
+        case ValueType::Uchar:
+            return 1;
+        case ValueType::Short:
+        case ValueType::Ushort:
+            return 2;
+        case ValueType::Int:
+        case ValueType::Uint:
+            return 4;
+    }
+    return 1;
+}
+
+int64_t PCSX::MemoryScanner::truncate(ValueType type, int64_t value) {
+    switch (type) {
+        case ValueType::Char:
+            return static_cast<int8_t>(value);
+        case ValueType::Uchar:
+            return static_cast<uint8_t>(value);
+        case ValueType::Short:
+            return static_cast<int16_t>(value);
+        case ValueType::Ushort:
+            return static_cast<uint16_t>(value);
+        case ValueType::Int:
+            return static_cast<int32_t>(value);
+        case ValueType::Uint:
+            return static_cast<uint32_t>(value);
+    }
+    return value;
+}
+
+int64_t PCSX::MemoryScanner::read(ValueType type, const uint8_t* mem, uint32_t offset) {
+    switch (type) {
+        case ValueType::Char:
+            return readAs<int8_t>(mem, offset);
+        case ValueType::Uchar:
+            return readAs<uint8_t>(mem, offset);
+        case ValueType::Short:
+            return readAs<int16_t>(mem, offset);
+        case ValueType::Ushort:
+            return readAs<uint16_t>(mem, offset);
+        case ValueType::Int:
+            return readAs<int32_t>(mem, offset);
+        case ValueType::Uint:
+            return readAs<uint32_t>(mem, offset);
+    }
+    return 0;
+}
+
+void PCSX::MemoryScanner::firstScan(const uint8_t* mem, uint32_t size, ValueType type, ScanType scan,
+                                    int64_t value) {
+    m_type = type;
+    m_slots = size / stride(type);
+    m_snapshot.clear();
+    m_bits.assign((m_slots + 63) / 64, 0);
+    runScan(mem, scan, value, true);
+    m_snapshot.assign(mem, mem + size);
+}
+
+void PCSX::MemoryScanner::nextScan(const uint8_t* mem, ScanType scan, int64_t value) {
+    if (m_count == 0) return;
+    runScan(mem, scan, value, false);
+    memcpy(m_snapshot.data(), mem, m_snapshot.size());
+}
+
+void PCSX::MemoryScanner::reset() {
+    m_snapshot.clear();
+    m_bits.clear();
+    m_ranks.clear();
+    m_slots = 0;
+    m_count = 0;
+}
+
+void PCSX::MemoryScanner::runScan(const uint8_t* mem, ScanType scan, int64_t value, bool first) {
+    const size_t words = m_bits.size();
+    // The first scan has no snapshot to compare against, and a second
+    // scan for unknown values can't tell anything more.
+    if ((first && isDelta(scan)) || (!first && (scan == ScanType::UnknownInitialValue))) {
+        std::fill(m_bits.begin(), m_bits.end(), 0);
+        m_ranks.assign(words, 0);
+        m_count = 0;
+        return;
+    }
+
+    Job job = {mem, m_snapshot.data(), m_bits.data(), m_slots, value, first};
+    ScanFunction function = pickFunction(m_type, scan);
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::clamp<size_t>((words + c_minWordsPerThread - 1) / c_minWordsPerThread, 1, threads);
+    const size_t perThread = (words + threads - 1) / threads;
+    std::vector<size_t> counts(threads);
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            counts[t] = function(job, std::min(words, t * perThread), std::min(words, (t + 1) * perThread));
+        });
+    }
+    counts[0] = function(job, 0, std::min(words, perThread));
+    for (auto& worker : workers) worker.join();
+
+    m_ranks.resize(words);
+    uint32_t rank = 0;
+    for (size_t w = 0; w < words; w++) {
+        m_ranks[w] = rank;
+        rank += std::popcount(m_bits[w]);
+    }
+    m_count = std::accumulate(counts.begin(), counts.end(), size_t(0));
+}
+
+uint32_t PCSX::MemoryScanner::candidate(size_t index) const {
+    assert(index < m_count);
+    // The last word with fewer candidates before it than the index holds it.
+    auto it = std::upper_bound(m_ranks.begin(), m_ranks.end(), static_cast<uint32_t>(index));
+    const size_t w = std::distance(m_ranks.begin(), it) - 1;
+    uint64_t bits = m_bits[w];
+    for (size_t n = index - m_ranks[w]; n != 0; n--) bits &= bits - 1;
+    return (w * 64 + std::countr_zero(bits)) * stride(m_type);
+}
+
+bool PCSX::MemoryScanner::isCandidate(uint32_t offset) const {
+    const unsigned s = stride(m_type);
+    if ((offset % s) != 0) return false;
+    const uint32_t slot = offset / s;
+    if (slot >= m_slots) return false;
+    return (m_bits[slot / 64] >> (slot % 64)) & 1;
+}
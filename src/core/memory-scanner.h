@@ -0,0 +1,85 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace PCSX {
+
+// Delta-over-time memory search, in the vein of the usual cheat finders.
+// Candidates are the aligned slots of the selected value type, and are kept
+// as a bitmap holding one bit per slot. Every scan compares the memory
+// against a value, or against the snapshot taken at the previous scan,
+// 64 slots at a time, and splits the work across threads. Words of the
+// bitmap without any candidate left are skipped altogether.
+class MemoryScanner {
+  public:
+    enum class ValueType { Char, Uchar, Short, Ushort, Int, Uint };
+    enum class ScanType {
+        ExactValue,
+        GreaterThan,
+        LessThan,
+        Changed,
+        Unchanged,
+        Increased,
+        Decreased,
+        UnknownInitialValue,
+    };
+
+    static unsigned stride(ValueType type);
+    // Truncates the value to the type, then sign or zero extends it back.
+    static int64_t truncate(ValueType type, int64_t value);
+    static int64_t read(ValueType type, const uint8_t* mem, uint32_t offset);
+
+    // Considers every slot of the memory anew. The delta scans have nothing
+    // to compare against yet, and won't yield any candidate.
+    void firstScan(const uint8_t* mem, uint32_t size, ValueType type, ScanType scan, int64_t value);
+    // Narrows down the current candidates. The memory needs to be as
+    // large as it was during the first scan.
+    void nextScan(const uint8_t* mem, ScanType scan, int64_t value);
+    void reset();
+
+    ValueType valueType() const { return m_type; }
+    uint32_t memorySize() const { return m_snapshot.size(); }
+    size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+    // Offset of the index-th candidate, in increasing order.
+    uint32_t candidate(size_t index) const;
+    bool isCandidate(uint32_t offset) const;
+    // The value at this offset when the last scan happened.
+    int64_t scannedValue(uint32_t offset) const { return read(m_type, m_snapshot.data(), offset); }
+
+  private:
+    void runScan(const uint8_t* mem, ScanType scan, int64_t value, bool first);
+
+    ValueType m_type = ValueType::Short;
+    std::vector<uint8_t> m_snapshot;
+    std::vector<uint64_t> m_bits;
+    // Amount of candidates found in the words before each word of the
+    // bitmap, so the candidates can be indexed without walking it.
+    std::vector<uint32_t> m_ranks;
+    uint32_t m_slots = 0;
+    size_t m_count = 0;
+};
+
+}  // namespace PCSX
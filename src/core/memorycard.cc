@@ -19,8 +19,70 @@
 
 #include "core/memorycard.h"
 
+#include <stdio.h>
+#include <sys/stat.h>
+#include <zlib.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <filesystem>
+#include <memory>
+
 #include "core/sio.h"
 #include "support/sjis_conv.h"
+#include "support/uvfile.h"
+
+namespace {
+
+// The flushes are queued on the uv thread, which then hands the actual blocking
+// file operations over to the libuv thread pool, so neither the emulation thread
+// nor the uv loop gets stalled by the disk.
+class MemoryCardWriter : public PCSX::UvThreadOp {
+  public:
+    static void post(std::function<void()> &&job) {
+        struct Work {
+            uv_work_t req;
+            std::function<void()> job;
+        };
+        auto work = new Work();
+        work->req.data = work;
+        work->job = std::move(job);
+        request([work](uv_loop_t *loop) {
+            uv_queue_work(
+                loop, &work->req, [](uv_work_t *req) { reinterpret_cast<Work *>(req->data)->job(); },
+                [](uv_work_t *req, int status) { delete reinterpret_cast<Work *>(req->data); });
+        });
+    }
+
+  private:
+    virtual bool canCache() const override { return false; }
+};
+
+bool syncFile(FILE *f) {
+    if (fflush(f) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+// Journal layout: magic, frame count, then for each frame its index followed by
+// its 128 bytes, and finally a crc32 of everything that precedes it. A journal
+// with a bad crc is a torn write, and is discarded without touching the card.
+constexpr char c_journalMagic[8] = {'P', 'C', 'S', 'X', 'M', 'C', 'J', '1'};
+
+std::filesystem::path journalPath(const PCSX::u8string &path) {
+    auto ret = std::filesystem::path(path);
+    ret += ".journal";
+    return ret;
+}
+
+}  // namespace
 
 void PCSX::MemoryCard::acknowledge() { m_sio->acknowledge(); }
 
@@ -245,7 +307,8 @@ uint8_t PCSX::MemoryCard::tickWriteCommand(uint8_t value) {
             m_directoryFlag = Flags::DirectoryRead;
             data_out = Responses::GoodReadWrite;
             memcpy(&m_mcdData[m_sector * 128], &m_tempBuffer, c_sectorSize);
-            m_savedToDisk = false;
+            if (m_dirtyFrames.none()) m_firstDirty = std::chrono::steady_clock::now();
+            m_dirtyFrames.set(m_sector);
             break;
     }
 
@@ -342,6 +405,8 @@ void PCSX::MemoryCard::loadMcd(PCSX::u8string mcd) {
     size_t bytesRead;
 
     m_directoryFlag = Flags::DirectoryUnread;
+    discardFlush();
+    m_headerSize = 0;
 
     FILE *f = fopen(fname, "rb");
     if (f == nullptr) {
@@ -383,10 +448,166 @@ void PCSX::MemoryCard::loadMcd(PCSX::u8string mcd) {
         fclose(f);
         if (bytesRead != c_cardSize) {
             throw std::runtime_error(_("Error reading memory card."));
-        } else {
-            m_savedToDisk = true;
         }
+        m_headerSize = detectHeaderSize(fname);
+        if (replayJournal(mcd, m_headerSize, data)) {
+            PCSX::g_system->printf(_("Recovered interrupted writes to memory card %s\n"), fname);
+        }
+    }
+}
+
+PCSX::u8string PCSX::MemoryCard::resolvePath(PCSX::u8string mcd) {
+    if (std::filesystem::path(mcd).is_relative()) {
+        mcd = (g_system->getPersistentDir() / mcd).u8string();
+    }
+    return mcd;
+}
+
+size_t PCSX::MemoryCard::detectHeaderSize(const char *fname) {
+    struct stat buf;
+    if (stat(fname, &buf) == -1) return 0;
+    if (buf.st_size == c_cardSize + 64) return 64;
+    if (buf.st_size == c_cardSize + 3904) return 3904;
+    return 0;
+}
+
+void PCSX::MemoryCard::flush(PCSX::u8string path, bool wait) {
+    if (flushInFlight()) {
+        if (!wait) return;
+        waitFlush();
+    }
+    reapFlush();
+    if (m_dirtyFrames.none()) return;
+
+    auto frames = std::make_shared<std::vector<DirtyFrame>>();
+    frames->reserve(m_dirtyFrames.count());
+    for (uint32_t i = 0; i < c_frameCount; i++) {
+        if (!m_dirtyFrames.test(i)) continue;
+        auto &frame = frames->emplace_back();
+        frame.index = i;
+        memcpy(frame.data, m_mcdData + i * c_sectorSize, c_sectorSize);
+    }
+    // The frames move over to the in-flight set rather than being forgotten:
+    // the SIO may dirty them again while the write is running, and if the
+    // write fails, reapFlush puts them back for the next attempt.
+    m_flushingFrames = m_dirtyFrames;
+    m_dirtyFrames.reset();
+
+    auto done = std::make_shared<std::promise<bool>>();
+    m_flushDone = done->get_future().share();
+    m_flushPath = resolvePath(path);
+    MemoryCardWriter::post([path = m_flushPath, headerSize = m_headerSize, frames, done]() {
+        done->set_value(writeFrames(path, headerSize, *frames));
+    });
+    if (wait) {
+        waitFlush();
+        reapFlush();
+    }
+}
+
+void PCSX::MemoryCard::reapFlush() {
+    if (!m_flushDone.valid() || flushInFlight()) return;
+    bool success = m_flushDone.get();
+    m_flushDone = {};
+    if (success) {
+        if (m_writeFailures != 0) {
+            PCSX::g_system->printf(_("Memory card %s written again\n"),
+                                   reinterpret_cast<const char *>(m_flushPath.c_str()));
+        }
+        m_writeFailures = 0;
+    } else {
+        // A missing or read-only card keeps failing, so don't flood the log
+        // with it, and back off the retries.
+        if (m_writeFailures == 0) {
+            PCSX::g_system->printf(_("Failed to write memory card %s, will retry\n"),
+                                   reinterpret_cast<const char *>(m_flushPath.c_str()));
+        }
+        m_writeFailures++;
+        m_firstDirty = std::chrono::steady_clock::now();
+        m_dirtyFrames |= m_flushingFrames;
+    }
+    m_flushingFrames.reset();
+}
+
+bool PCSX::MemoryCard::writeFrames(const PCSX::u8string &path, size_t headerSize,
+                                   const std::vector<DirtyFrame> &frames) {
+    auto jPath = journalPath(path);
+    FILE *j = fopen(jPath.string().c_str(), "wb");
+    if (!j) return false;
+    uint32_t count = frames.size();
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, reinterpret_cast<const Bytef *>(c_journalMagic), sizeof(c_journalMagic));
+    crc = crc32(crc, reinterpret_cast<const Bytef *>(&count), sizeof(count));
+    bool ok = fwrite(c_journalMagic, sizeof(c_journalMagic), 1, j) == 1;
+    ok = ok && (fwrite(&count, sizeof(count), 1, j) == 1);
+    for (auto &frame : frames) {
+        crc = crc32(crc, reinterpret_cast<const Bytef *>(&frame), sizeof(frame));
+        ok = ok && (fwrite(&frame, sizeof(frame), 1, j) == 1);
+    }
+    uint32_t crcValue = crc;
+    ok = ok && (fwrite(&crcValue, sizeof(crcValue), 1, j) == 1);
+    ok = syncFile(j) && ok;
+    fclose(j);
+    std::error_code ec;
+    if (!ok) {
+        // A partial journal would be discarded as torn on the next load anyway.
+        std::filesystem::remove(jPath, ec);
+        return false;
+    }
+
+    // The journal is now safely on disk; whatever happens while patching the
+    // card itself can be replayed from it on the next load, so the journal
+    // is only removed once the card is known to be fully written.
+    FILE *f = fopen(reinterpret_cast<const char *>(path.c_str()), "r+b");
+    if (!f) return false;
+    for (auto &frame : frames) {
+        ok = ok && (fseek(f, headerSize + frame.index * c_sectorSize, SEEK_SET) == 0);
+        ok = ok && (fwrite(frame.data, c_sectorSize, 1, f) == 1);
+    }
+    ok = syncFile(f) && ok;
+    fclose(f);
+    if (!ok) return false;
+    std::filesystem::remove(jPath, ec);
+    return true;
+}
+
+bool PCSX::MemoryCard::replayJournal(const PCSX::u8string &path, size_t headerSize, char *data) {
+    auto jPath = journalPath(path);
+    std::error_code ec;
+    if (!std::filesystem::exists(jPath, ec)) return false;
+    FILE *j = fopen(jPath.string().c_str(), "rb");
+    if (!j) return false;
+
+    std::vector<DirtyFrame> frames;
+    char magic[sizeof(c_journalMagic)];
+    uint32_t count = 0;
+    uint32_t storedCrc = 0;
+    bool valid = (fread(magic, sizeof(magic), 1, j) == 1) && (memcmp(magic, c_journalMagic, sizeof(magic)) == 0) &&
+                 (fread(&count, sizeof(count), 1, j) == 1) && (count <= c_frameCount);
+    if (valid) {
+        frames.resize(count);
+        valid = (count == 0) || (fread(frames.data(), sizeof(DirtyFrame), count, j) == count);
+    }
+    valid = valid && (fread(&storedCrc, sizeof(storedCrc), 1, j) == 1);
+    fclose(j);
+    if (valid) {
+        uLong crc = crc32(0L, Z_NULL, 0);
+        crc = crc32(crc, reinterpret_cast<const Bytef *>(magic), sizeof(magic));
+        crc = crc32(crc, reinterpret_cast<const Bytef *>(&count), sizeof(count));
+        crc = crc32(crc, reinterpret_cast<const Bytef *>(frames.data()), count * sizeof(DirtyFrame));
+        for (auto &frame : frames) {
+            if (frame.index >= c_frameCount) valid = false;
+        }
+        valid = valid && (uint32_t(crc) == storedCrc);
     }
+    if (!valid) {
+        // Torn journal: the card itself was never touched.
+        std::filesystem::remove(jPath, ec);
+        return false;
+    }
+
+    for (auto &frame : frames) memcpy(data + frame.index * c_sectorSize, frame.data, c_sectorSize);
+    return writeFrames(path, headerSize, frames);
 }
 
 void PCSX::MemoryCard::saveMcd(PCSX::u8string mcd, const char *data, uint32_t adr, size_t size) {
@@ -413,7 +634,6 @@ void PCSX::MemoryCard::saveMcd(PCSX::u8string mcd, const char *data, uint32_t ad
 
         fwrite(data + adr, 1, size, f);
         fclose(f);
-        m_savedToDisk = true;
         PCSX::g_system->printf(_("Saving memory card %s\n"), fname);
     } else {
         // try to create it again if we can't open it
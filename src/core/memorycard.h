@@ -21,6 +21,12 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <future>
+#include <vector>
+
 #include "core/sstate.h"
 
 namespace PCSX {
@@ -43,19 +49,34 @@ class MemoryCard {
     }
 
     // File system / data manipulation
+    // Only the frames written by the SIO since the last flush are persisted,
+    // and the writes are coalesced: nothing is flushed until c_flushWindow
+    // has elapsed since the first frame got dirty. After failed writes, that
+    // window doubles with each failure, up to c_maxRetryBackoff doublings.
     void commit(const PCSX::u8string path) {
-        if (!m_savedToDisk) {
-            saveMcd(path);
-        }
+        reapFlush();
+        if (m_dirtyFrames.none()) return;
+        const auto window = c_flushWindow * (1 << std::min(m_writeFailures, c_maxRetryBackoff));
+        if ((std::chrono::steady_clock::now() - m_firstDirty) < window) return;
+        flush(path);
     }
+    // Writes the dirty frames through the journal on the uv thread. If
+    // a previous flush is still in flight, this is postponed, unless wait
+    // is set, in which case this blocks until everything is on disk.
+    // Frames whose write failed are marked dirty again, and retried on
+    // a later commit. Only the first of consecutive failures is logged.
+    void flush(PCSX::u8string path, bool wait = false);
     void createMcd(PCSX::u8string mcd);
-    bool dataChanged() { return !m_savedToDisk; }
+    bool dataChanged() { return m_dirtyFrames.any() || m_flushingFrames.any(); }
     void disablePocketstation() { m_pocketstationEnabled = false; };
     void enablePocketstation() { m_pocketstationEnabled = true; };
     char *getMcdData() { return m_mcdData; }
     void loadMcd(PCSX::u8string mcd);
     void saveMcd(PCSX::u8string mcd, const char *data, uint32_t adr, size_t size);
-    void saveMcd(PCSX::u8string mcd) { saveMcd(mcd, m_mcdData, 0, c_cardSize); }
+    void saveMcd(PCSX::u8string mcd) {
+        discardFlush();
+        saveMcd(mcd, m_mcdData, 0, c_cardSize);
+    }
 
   private:
     enum Commands : uint8_t {
@@ -100,6 +121,34 @@ class MemoryCard {
     static constexpr size_t c_sectorSize = 8 * 16;
     static constexpr size_t c_blockSize = 8192;
     static constexpr size_t c_cardSize = 1024 * c_sectorSize;
+    static constexpr size_t c_frameCount = c_cardSize / c_sectorSize;
+    static constexpr std::chrono::milliseconds c_flushWindow{250};
+    static constexpr unsigned c_maxRetryBackoff = 7;  // Retries at most every 32s
+
+    struct DirtyFrame {
+        uint32_t index;
+        uint8_t data[c_sectorSize];
+    };
+    static PCSX::u8string resolvePath(PCSX::u8string mcd);
+    static bool writeFrames(const PCSX::u8string &path, size_t headerSize, const std::vector<DirtyFrame> &frames);
+    static bool replayJournal(const PCSX::u8string &path, size_t headerSize, char *data);
+    static size_t detectHeaderSize(const char *fname);
+    bool flushInFlight() {
+        return m_flushDone.valid() && (m_flushDone.wait_for(std::chrono::seconds(0)) != std::future_status::ready);
+    }
+    void waitFlush() {
+        if (m_flushDone.valid()) m_flushDone.wait();
+    }
+    // Collects the result of a completed flush: the frames it carried are
+    // only considered clean once the write has succeeded.
+    void reapFlush();
+    void discardFlush() {
+        waitFlush();
+        m_flushDone = {};
+        m_flushingFrames.reset();
+        m_dirtyFrames.reset();
+        m_writeFailures = 0;
+    }
 
     // State machine / handlers
     uint8_t transceive(uint8_t value);
@@ -112,7 +161,13 @@ class MemoryCard {
 
     char m_mcdData[c_cardSize];
     uint8_t m_tempBuffer[c_sectorSize];
-    bool m_savedToDisk = false;
+    std::bitset<c_frameCount> m_dirtyFrames;
+    std::bitset<c_frameCount> m_flushingFrames;
+    std::chrono::steady_clock::time_point m_firstDirty;
+    std::shared_future<bool> m_flushDone;
+    PCSX::u8string m_flushPath;
+    unsigned m_writeFailures = 0;  // Consecutive failed flushes
+    size_t m_headerSize = 0;
 
     uint8_t m_checksumIn = 0, m_checksumOut = 0;
     uint16_t m_commandTicks = 0;
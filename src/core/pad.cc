@@ -205,7 +205,7 @@ class PadsImpl : public PCSX::Pads {
     unsigned m_selectedPadForConfig = 0;
 };
 
-static PadsImpl* s_pads = nullptr;
+static thread_local PadsImpl* s_pads = nullptr;
 
 static ImGuiKey GlfwKeyToImGuiKey(int key) {
     switch (key) {
@@ -45,6 +45,8 @@ typedef struct {
     psxCP2Data CP2D;
     psxCP2Ctrl CP2C;
     uint32_t pc;
+    uint32_t code;
+    uint32_t cycle;
 } psxRegisters;
 
 enum BreakpointType { Exec, Read, Write };
@@ -85,14 +87,56 @@ LuaScreenShot takeScreenShot();
 LuaSlice* createSaveState();
 void loadSaveStateFromSlice(LuaSlice*);
 void loadSaveStateFromFile(LuaFile*);
+bool saveMappedSaveState(const char* filename);
+bool loadMappedSaveState(const char* filename);
 
 LuaFile* getMemoryAsFile();
 
+void startProfiler(uint32_t period);
+void stopProfiler();
+void clearProfiler();
+bool profilerRunning();
+uint64_t getProfilerSampleCount();
+LuaSlice* getProfilerCollapsedStacks();
+
+void enableInstrumentation();
+void disableInstrumentation();
+bool instrumentationEnabled();
+unsigned getInstrumentationScopeCount();
+const char* getInstrumentationScopeName(unsigned scope);
+double getInstrumentationMicroseconds(unsigned scope);
+uint64_t getInstrumentationCalls(unsigned scope);
+
+void memoryScannerFirstScan(unsigned type, unsigned scan, int64_t value);
+void memoryScannerNextScan(unsigned scan, int64_t value);
+void memoryScannerReset();
+uint32_t memoryScannerCount();
+uint32_t memoryScannerCandidate(uint32_t index);
+int64_t memoryScannerValue(uint32_t index, bool scanned);
+
 void quit(int code);
 ]]
 
 local C = ffi.load 'PCSX'
 
+local memoryScannerValueTypes = { Char = 0, Uchar = 1, Short = 2, Ushort = 3, Int = 4, Uint = 5 }
+local memoryScannerScanTypes = {
+    ExactValue = 0,
+    GreaterThan = 1,
+    LessThan = 2,
+    Changed = 3,
+    Unchanged = 4,
+    Increased = 5,
+    Decreased = 6,
+    UnknownInitialValue = 7,
+}
+
+local function memoryScannerScanType(name, caller)
+    local scan = memoryScannerScanTypes[name]
+    if scan == nil then error('PCSX.MemoryScanner.' .. caller .. ': invalid scan type ' .. tostring(name)) end
+    return scan
+end
+
 local function removeBreakpoint(bp)
     C.removeBreakpoint(ffi.gc(bp._wrapper, nil))
     bp._wrapper = ffi.cast('Breakpoint*', 0)
@@ -219,7 +263,72 @@ PCSX = {
             error('loadSaveState: requires a Slice or File as input')
         end
     end,
+    saveMappedSaveState = function(filename)
+        if type(filename) ~= 'string' then error('saveMappedSaveState: requires a filename as input') end
+        return C.saveMappedSaveState(filename)
+    end,
+    loadMappedSaveState = function(filename)
+        if type(filename) ~= 'string' then error('loadMappedSaveState: requires a filename as input') end
+        return C.loadMappedSaveState(filename)
+    end,
     getMemoryAsFile = function() return Support.File._createFileWrapper(C.getMemoryAsFile()) end,
+    Profiler = {
+        start = function(period)
+            if period == nil then period = 0 end
+            if type(period) ~= 'number' then error('PCSX.Profiler.start: period needs to be a number of cycles') end
+            C.startProfiler(period)
+        end,
+        stop = function() C.stopProfiler() end,
+        clear = function() C.clearProfiler() end,
+        isRunning = function() return C.profilerRunning() end,
+        getSampleCount = function() return tonumber(C.getProfilerSampleCount()) end,
+        getCollapsedStacks = function() return Support.File._createSliceWrapper(C.getProfilerCollapsedStacks()) end,
+    },
+    Instrumentation = {
+        enable = function() C.enableInstrumentation() end,
+        disable = function() C.disableInstrumentation() end,
+        isEnabled = function() return C.instrumentationEnabled() end,
+        getLastFrame = function()
+            local count = C.getInstrumentationScopeCount()
+            local frame = { microseconds = C.getInstrumentationMicroseconds(count), scopes = {} }
+            for i = 0, count - 1 do
+                local microseconds = C.getInstrumentationMicroseconds(i)
+                frame.scopes[i + 1] = {
+                    name = ffi.string(C.getInstrumentationScopeName(i)),
+                    microseconds = microseconds,
+                    percent = frame.microseconds > 0 and microseconds * 100 / frame.microseconds or 0,
+                    calls = tonumber(C.getInstrumentationCalls(i)),
+                }
+            end
+            return frame
+        end,
+    },
+    MemoryScanner = {
+        firstScan = function(valueType, scanType, value)
+            local type = memoryScannerValueTypes[valueType]
+            if type == nil then error('PCSX.MemoryScanner.firstScan: invalid value type ' .. tostring(valueType)) end
+            C.memoryScannerFirstScan(type, memoryScannerScanType(scanType, 'firstScan'), value or 0)
+        end,
+        nextScan = function(scanType, value)
+            C.memoryScannerNextScan(memoryScannerScanType(scanType, 'nextScan'), value or 0)
+        end,
+        reset = function() C.memoryScannerReset() end,
+        getCount = function() return C.memoryScannerCount() end,
+        getCandidates = function(first, count)
+            first = first or 0
+            local last = C.memoryScannerCount()
+            if count ~= nil then last = math.min(last, first + count) end
+            local candidates = {}
+            for i = first, last - 1 do
+                candidates[#candidates + 1] = {
+                    address = C.memoryScannerCandidate(i),
+                    current = tonumber(C.memoryScannerValue(i, false)),
+                    scanned = tonumber(C.memoryScannerValue(i, true)),
+                }
+            end
+            return candidates
+        end,
+    },
     quit = function(code) C.quit(code or 0) end,
 }
 
@@ -21,12 +21,15 @@
 
 #include "core/debug.h"
 #include "core/gpu.h"
+#include "core/memory-scanner.h"
 #include "core/psxemulator.h"
 #include "core/psxmem.h"
 #include "core/r3000a.h"
+#include "core/sampling-profiler.h"
 #include "core/sstate.h"
 #include "lua/luafile.h"
 #include "lua/luawrapper.h"
+#include "support/instrumentation.h"
 
 namespace {
 
@@ -73,7 +76,7 @@ bool breakpointEnabled(LuaBreakpoint* wrapper) {
 }
 void removeBreakpoint(LuaBreakpoint* wrapper) {
     if (!wrapper) return;
-    wrapper->wrapper.destroyAll();
+    PCSX::g_emulator->m_debug->removeBreakpoints(wrapper->wrapper);
     delete wrapper;
 }
 void pauseEmulator() { PCSX::g_system->pause(); }
@@ -116,10 +119,73 @@ void loadSaveStateFromFile(PCSX::LuaFFI::LuaFile* file) {
     PCSX::SaveStates::load(data.asStringView());
 }
 
+bool saveMappedSaveState(const char* filename) { return PCSX::SaveStates::saveMapped(filename); }
+bool loadMappedSaveState(const char* filename) { return PCSX::SaveStates::loadMapped(filename); }
+
 PCSX::LuaFFI::LuaFile* getMemoryAsFile() {
     return new PCSX::LuaFFI::LuaFile(PCSX::g_emulator->m_mem->getMemoryAsFile());
 }
 
+void startProfiler(uint32_t period) { PCSX::g_emulator->m_samplingProfiler->start(period); }
+void stopProfiler() { PCSX::g_emulator->m_samplingProfiler->stop(); }
+void clearProfiler() { PCSX::g_emulator->m_samplingProfiler->clear(); }
+bool profilerRunning() { return PCSX::g_emulator->m_samplingProfiler->running(); }
+uint64_t getProfilerSampleCount() { return PCSX::g_emulator->m_samplingProfiler->samples(); }
+PCSX::Slice* getProfilerCollapsedStacks() {
+    std::ostringstream out;
+    PCSX::g_emulator->m_samplingProfiler->writeCollapsed(out, PCSX::g_emulator->m_cpu->m_symbols);
+    auto ret = new PCSX::Slice();
+    ret->acquire(out.str());
+    return ret;
+}
+
+void enableInstrumentation() { PCSX::g_emulator->m_instrumentation->enable(); }
+void disableInstrumentation() { PCSX::g_emulator->m_instrumentation->disable(); }
+bool instrumentationEnabled() { return PCSX::g_emulator->m_instrumentation->isEnabled(); }
+unsigned getInstrumentationScopeCount() { return PCSX::Instrumentation::c_scopeCount; }
+const char* getInstrumentationScopeName(unsigned scope) {
+    if (scope >= PCSX::Instrumentation::c_scopeCount) return nullptr;
+    return PCSX::Instrumentation::c_scopeNames[scope].data();
+}
+double getInstrumentationMicroseconds(unsigned scope) {
+    auto& frame = PCSX::g_emulator->m_instrumentation->lastFrame();
+    if (scope >= PCSX::Instrumentation::c_scopeCount) return frame.toMicroseconds(frame.totalTicks);
+    return frame.toMicroseconds(frame.ticks[scope]);
+}
+uint64_t getInstrumentationCalls(unsigned scope) {
+    if (scope >= PCSX::Instrumentation::c_scopeCount) return 0;
+    return PCSX::g_emulator->m_instrumentation->lastFrame().calls[scope];
+}
+
+void memoryScannerFirstScan(unsigned type, unsigned scan, int64_t value) {
+    using PCSX::MemoryScanner;
+    const auto valueType = static_cast<MemoryScanner::ValueType>(type);
+    const uint32_t size = 1024 * 1024 * (PCSX::g_emulator->settings.get<PCSX::Emulator::Setting8MB>() ? 8 : 2);
+    PCSX::g_emulator->m_memoryScanner->firstScan(PCSX::g_emulator->m_mem->m_wram, size, valueType,
+                                                 static_cast<MemoryScanner::ScanType>(scan),
+                                                 MemoryScanner::truncate(valueType, value));
+}
+void memoryScannerNextScan(unsigned scan, int64_t value) {
+    using PCSX::MemoryScanner;
+    auto& scanner = PCSX::g_emulator->m_memoryScanner;
+    scanner->nextScan(PCSX::g_emulator->m_mem->m_wram, static_cast<MemoryScanner::ScanType>(scan),
+                      MemoryScanner::truncate(scanner->valueType(), value));
+}
+void memoryScannerReset() { PCSX::g_emulator->m_memoryScanner->reset(); }
+uint32_t memoryScannerCount() { return PCSX::g_emulator->m_memoryScanner->size(); }
+uint32_t memoryScannerCandidate(uint32_t index) {
+    auto& scanner = PCSX::g_emulator->m_memoryScanner;
+    if (index >= scanner->size()) return 0;
+    return 0x80000000 + scanner->candidate(index);
+}
+int64_t memoryScannerValue(uint32_t index, bool scanned) {
+    auto& scanner = PCSX::g_emulator->m_memoryScanner;
+    if (index >= scanner->size()) return 0;
+    const uint32_t offset = scanner->candidate(index);
+    if (scanned) return scanner->scannedValue(offset);
+    return PCSX::MemoryScanner::read(scanner->valueType(), PCSX::g_emulator->m_mem->m_wram, offset);
+}
+
 void quit(int code) { PCSX::g_system->quit(code); }
 
 }  // namespace
@@ -162,7 +228,28 @@ static void registerAllSymbols(PCSX::Lua L) {
     REGISTER(L, createSaveState);
     REGISTER(L, loadSaveStateFromSlice);
     REGISTER(L, loadSaveStateFromFile);
+    REGISTER(L, saveMappedSaveState);
+    REGISTER(L, loadMappedSaveState);
     REGISTER(L, getMemoryAsFile);
+    REGISTER(L, startProfiler);
+    REGISTER(L, stopProfiler);
+    REGISTER(L, clearProfiler);
+    REGISTER(L, profilerRunning);
+    REGISTER(L, getProfilerSampleCount);
+    REGISTER(L, getProfilerCollapsedStacks);
+    REGISTER(L, enableInstrumentation);
+    REGISTER(L, disableInstrumentation);
+    REGISTER(L, instrumentationEnabled);
+    REGISTER(L, getInstrumentationScopeCount);
+    REGISTER(L, getInstrumentationScopeName);
+    REGISTER(L, getInstrumentationMicroseconds);
+    REGISTER(L, getInstrumentationCalls);
+    REGISTER(L, memoryScannerFirstScan);
+    REGISTER(L, memoryScannerNextScan);
+    REGISTER(L, memoryScannerReset);
+    REGISTER(L, memoryScannerCount);
+    REGISTER(L, memoryScannerCandidate);
+    REGISTER(L, memoryScannerValue);
     REGISTER(L, quit);
     L.settable();
     L.pop();
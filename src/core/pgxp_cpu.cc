@@ -5,13 +5,13 @@
 #include "core/pgxp_mem.h"
 #include "core/pgxp_value.h"
 
-// CPU registers
-static PGXP_value s_CPU_reg_mem[34];
+// CPU registers, tracked separately by each emulation thread.
+static thread_local PGXP_value s_CPU_reg_mem[34];
 // PGXP_value CPU_Hi, CPU_Lo;
-static PGXP_value s_CP0_reg_mem[32];
+static thread_local PGXP_value s_CP0_reg_mem[32];
 
-PGXP_value* const g_CPU_reg = s_CPU_reg_mem;
-PGXP_value* const g_CP0_reg = s_CP0_reg_mem;
+thread_local PGXP_value* g_CPU_reg = nullptr;
+thread_local PGXP_value* g_CP0_reg = nullptr;
 
 // Instruction register decoding
 #define op(_instr) (_instr >> 26)           // The op part of the instruction register
@@ -23,6 +23,8 @@ PGXP_value* const g_CP0_reg = s_CP0_reg_mem;
 #define imm(_instr) (_instr & 0xFFFF)       // The immediate part of the instruction register
 
 void PGXP_InitCPU() {
+    g_CPU_reg = s_CPU_reg_mem;
+    g_CP0_reg = s_CP0_reg_mem;
     memset(s_CPU_reg_mem, 0, sizeof(s_CPU_reg_mem));
     memset(s_CP0_reg_mem, 0, sizeof(s_CP0_reg_mem));
 }
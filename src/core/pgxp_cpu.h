@@ -33,8 +33,9 @@
 struct PGXP_value_Tag;
 typedef struct PGXP_value_Tag PGXP_value;
 
-extern PGXP_value* const g_CPU_reg;
-extern PGXP_value* const g_CP0_reg;
+// Bound to the calling thread's registers by PGXP_InitCPU.
+extern thread_local PGXP_value* g_CPU_reg;
+extern thread_local PGXP_value* g_CP0_reg;
 #define CPU_Hi g_CPU_reg[33]
 #define CPU_Lo g_CPU_reg[34]
 
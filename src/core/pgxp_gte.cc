@@ -43,14 +43,16 @@
 #define min(a, b) ((a) < (b) ? (a) : (b))
 #endif
 
-// GTE registers
-static PGXP_value s_GTE_data_reg_mem[32];
-static PGXP_value s_GTE_ctrl_reg_mem[32];
+// GTE registers, tracked separately by each emulation thread.
+static thread_local PGXP_value s_GTE_data_reg_mem[32];
+static thread_local PGXP_value s_GTE_ctrl_reg_mem[32];
 
-PGXP_value* g_GTE_data_reg = s_GTE_data_reg_mem;
-PGXP_value* g_GTE_ctrl_reg = s_GTE_ctrl_reg_mem;
+thread_local PGXP_value* g_GTE_data_reg = nullptr;
+thread_local PGXP_value* g_GTE_ctrl_reg = nullptr;
 
 void PGXP_InitGTE() {
+    g_GTE_data_reg = s_GTE_data_reg_mem;
+    g_GTE_ctrl_reg = s_GTE_ctrl_reg_mem;
     memset(s_GTE_data_reg_mem, 0, sizeof(s_GTE_data_reg_mem));
     memset(s_GTE_ctrl_reg_mem, 0, sizeof(s_GTE_ctrl_reg_mem));
 }
@@ -77,7 +79,7 @@ void PGXP_InitGTE() {
 #define SXYP (g_GTE_data_reg[15])
 
 void PGXP_pushSXYZ2f(float _x, float _y, float _z, unsigned int _v) {
-    static unsigned int uCount = 0;
+    static thread_local unsigned int uCount = 0;
     low_value temp;
     // push values down FIFO
     SXY0 = SXY1;
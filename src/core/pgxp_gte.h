@@ -33,8 +33,9 @@
 struct PGXP_value_Tag;
 typedef struct PGXP_value_Tag PGXP_value;
 
-extern PGXP_value* g_GTE_data_reg;
-extern PGXP_value* g_GTE_ctrl_reg;
+// Bound to the calling thread's registers by PGXP_InitGTE.
+extern thread_local PGXP_value* g_GTE_data_reg;
+extern thread_local PGXP_value* g_GTE_ctrl_reg;
 
 void PGXP_InitGTE();
 
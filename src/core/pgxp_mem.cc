@@ -1,25 +1,58 @@
 #include "core/pgxp_mem.h"
 
+#include <memory>
+#include <vector>
+
 #include "core/pgxp_cpu.h"
 #include "core/pgxp_gte.h"
 #include "core/pgxp_value.h"
 
-static PGXP_value s_mem[3 * 2048 * 1024 / 4];  // mirror 2MB in 32-bit words * 3
-static const uint32_t s_userMemOffset = 0;
-static const uint32_t s_scratchOffset = 2048 * 1024 / 4;
-static const uint32_t s_registerOffset = 2 * 2048 * 1024 / 4;
-static const uint32_t s_invalidAddress = 3 * 2048 * 1024 / 4;
+// The shadow memory is split into pages of 4KB of guest memory, which only get
+// allocated the first time a value carrying precision data or flags gets stored
+// there. A page is released as soon as the guest overwrites all of these values
+// with regular ones, so untouched or non-geometry memory costs nothing.
+static constexpr uint32_t c_pageShift = 10;
+static constexpr uint32_t c_pageWords = 1 << c_pageShift;
+struct ShadowPage {
+    PGXP_value values[c_pageWords] = {};
+    unsigned validCount = 0;
+};
+
+// Whether a value holds anything a blank one doesn't, and needs its page to stay around.
+static bool HasData(const PGXP_value& value) {
+    return (value.flags != 0) || (value.gFlags != 0) || (value.lFlags != 0) || (value.hFlags != 0);
+}
 
-void PGXP_InitMem() { memset(s_mem, 0, sizeof(s_mem)); }
+// Each emulation thread gets its own shadow memory.
+static thread_local std::vector<std::unique_ptr<ShadowPage>> s_pages;
+static thread_local size_t s_residentPages = 0;
+static const PGXP_value s_blank = {};
+
+// Offsets are in 32-bit words; the user memory size depends on the 8MB setting.
+static thread_local uint32_t s_ramMask = 0x1fffff;
+static const uint32_t s_userMemOffset = 0;
+static thread_local uint32_t s_scratchOffset = 0;
+static thread_local uint32_t s_registerOffset = 0;
+static thread_local uint32_t s_invalidAddress = 0;
+
+void PGXP_InitMem(uint32_t ramSize) {
+    s_ramMask = ramSize - 1;
+    s_scratchOffset = ramSize >> 2;
+    s_registerOffset = s_scratchOffset + c_pageWords;
+    s_invalidAddress = s_registerOffset + (0x10000 >> 2);
+    s_pages.clear();
+    s_pages.resize(s_invalidAddress >> c_pageShift);
+    s_residentPages = 0;
+}
 
 void PGXP_Init() {
-    PGXP_InitMem();
+    PGXP_InitMem(PCSX::g_emulator->settings.get<PCSX::Emulator::Setting8MB>() ? 0x800000 : 0x200000);
     PGXP_InitCPU();
     PGXP_InitGTE();
 }
 
-uint8_t* PGXP_GetMem() {
-    return (uint8_t*)(s_mem);  // PCSX::g_emulator->config().PGXP_GTE ? (char*)(s_mem) : NULL;
+size_t PGXP_GetMemUsage() {
+    return s_pages.capacity() * sizeof(s_pages[0]) + s_residentPages * sizeof(ShadowPage);
 }
 
 /*  Playstation Memory Map (from Playstation doc by Joshua Walker)
@@ -79,7 +112,7 @@ uint32_t PGXP_ConvertAddress(uint32_t addr) {
         case 0xa0:
         case 0x00:
             // RAM further mirrored over 8MB
-            paddr = ((paddr & 0x7FFFFF) % 0x200000) >> 2;
+            paddr = (paddr & s_ramMask) >> 2;
             paddr = s_userMemOffset + paddr;
             break;
         default:
@@ -107,20 +140,54 @@ uint32_t PGXP_ConvertAddress(uint32_t addr) {
     return paddr;
 }
 
-PGXP_value* PGXP_GetPtr(uint32_t addr) {
-    addr = PGXP_ConvertAddress(addr);
+static ShadowPage* GetPage(uint32_t offset, bool allocate) {
+    auto& page = s_pages[offset >> c_pageShift];
+    if (!page && allocate) {
+        page = std::make_unique<ShadowPage>();
+        s_residentPages++;
+    }
+    return page.get();
+}
+
+// To be called after having modified a value in place, with its validity beforehand.
+// Releases the page when it doesn't hold any data anymore.
+static void UpdateValidity(uint32_t offset, bool wasValid) {
+    auto& page = s_pages[offset >> c_pageShift];
+    bool isValid = HasData(page->values[offset & (c_pageWords - 1)]);
+    if (wasValid == isValid) return;
+    if (isValid) {
+        page->validCount++;
+    } else if (--page->validCount == 0) {
+        page.reset();
+        s_residentPages--;
+    }
+}
 
-    if (addr != s_invalidAddress) return &s_mem[addr];
-    return NULL;
+static PGXP_value* LookUp(uint32_t offset) {
+    if (offset >= s_invalidAddress) return NULL;
+    ShadowPage* page = GetPage(offset, false);
+    // Untouched memory reads as zeroes, without any precision data.
+    if (!page) return const_cast<PGXP_value*>(&s_blank);
+    return &page->values[offset & (c_pageWords - 1)];
 }
 
+PGXP_value* PGXP_GetPtr(uint32_t addr) { return LookUp(PGXP_ConvertAddress(addr)); }
+
 PGXP_value* PGXP_ReadMem(uint32_t addr) { return PGXP_GetPtr(addr); }
 
 void ValidateAndCopyMem(PGXP_value* dest, uint32_t addr, uint32_t value) {
-    PGXP_value* pMem = PGXP_GetPtr(addr);
+    uint32_t offset = PGXP_ConvertAddress(addr);
+    PGXP_value* pMem = LookUp(offset);
+    if (pMem == &s_blank) {
+        *dest = s_blank;
+        dest->value = value;
+        return;
+    }
     if (pMem != NULL) {
+        bool wasValid = HasData(*pMem);
         Validate(pMem, value);
         *dest = *pMem;
+        UpdateValidity(offset, wasValid);
         return;
     }
 
@@ -130,8 +197,10 @@ void ValidateAndCopyMem(PGXP_value* dest, uint32_t addr, uint32_t value) {
 void ValidateAndCopyMem16(PGXP_value* dest, uint32_t addr, uint32_t value, int sign) {
     uint32_t validMask = 0;
     psx_value val, mask;
-    PGXP_value* pMem = PGXP_GetPtr(addr);
+    uint32_t offset = PGXP_ConvertAddress(addr);
+    PGXP_value* pMem = LookUp(offset);
     if (pMem != NULL) {
+        bool wasValid = HasData(*pMem);
         mask.d = val.d = 0;
         // determine if high or low word
         if ((addr % 4) == 2) {
@@ -145,8 +214,13 @@ void ValidateAndCopyMem16(PGXP_value* dest, uint32_t addr, uint32_t value, int s
         }
 
         // validate and copy whole value
-        MaskValidate(pMem, val.d, mask.d, validMask);
-        *dest = *pMem;
+        if (pMem != &s_blank) {
+            MaskValidate(pMem, val.d, mask.d, validMask);
+            *dest = *pMem;
+            UpdateValidity(offset, wasValid);
+        } else {
+            *dest = s_blank;
+        }
 
         // if high word then shift
         if ((addr % 4) == 2) {
@@ -166,17 +240,34 @@ void ValidateAndCopyMem16(PGXP_value* dest, uint32_t addr, uint32_t value, int s
     *dest = PGXP_value_invalid_address;
 }
 
+// Returns the value to write into, or NULL when the write can be skipped altogether:
+// storing a value without any precision data or flags into untouched memory changes nothing.
+static PGXP_value* GetWritePtr(uint32_t offset, bool precise) {
+    if (offset >= s_invalidAddress) return NULL;
+    ShadowPage* page = GetPage(offset, precise);
+    if (!page) return NULL;
+    return &page->values[offset & (c_pageWords - 1)];
+}
+
 void WriteMem(PGXP_value* value, uint32_t addr) {
-    PGXP_value* pMem = PGXP_GetPtr(addr);
+    uint32_t offset = PGXP_ConvertAddress(addr);
+    PGXP_value* pMem = GetWritePtr(offset, HasData(*value));
 
-    if (pMem) *pMem = *value;
+    if (pMem) {
+        bool wasValid = HasData(*pMem);
+        *pMem = *value;
+        UpdateValidity(offset, wasValid);
+    }
 }
 
 void WriteMem16(PGXP_value* src, uint32_t addr) {
-    PGXP_value* dest = PGXP_GetPtr(addr);
+    uint32_t offset = PGXP_ConvertAddress(addr);
+    PGXP_value* dest = GetWritePtr(offset, (src->compFlags[0] != 0) || (src->compFlags[2] == VALID) ||
+                                               (src->lFlags != 0) || (src->gFlags != 0));
     psx_value* pVal = NULL;
 
     if (dest) {
+        bool wasValid = HasData(*dest);
         pVal = reinterpret_cast<psx_value*>(&dest->value);
         // determine if high or low word
         if ((addr % 4) == 2) {
@@ -199,5 +290,6 @@ void WriteMem16(PGXP_value* src, uint32_t addr) {
 
         // dest->valid = dest->valid && src->valid;
         dest->gFlags |= src->gFlags;  // inherit flags from both values (?)
+        UpdateValidity(offset, wasValid);
     }
 }
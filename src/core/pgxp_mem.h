@@ -28,10 +28,13 @@
 #ifndef _PGXP_MEM_H_
 #define _PGXP_MEM_H_
 
+#include <stddef.h>
+
 #include "core/psxemulator.h"
 
-void PGXP_Init();        // initialise memory
-uint8_t* PGXP_GetMem();  // return pointer to precision memory
+void PGXP_Init();                     // initialise memory
+void PGXP_InitMem(uint32_t ramSize);  // clear memory, sized for the given amount of RAM
+size_t PGXP_GetMemUsage();            // bytes currently allocated for precision memory
 uint32_t PGXP_ConvertAddress(uint32_t addr);
 
 struct PGXP_value_Tag;
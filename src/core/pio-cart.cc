@@ -57,7 +57,7 @@ void PCSX::PIOCart::setLuts() {
 uint8_t PCSX::PIOCart::read8(uint32_t address) {
     uint32_t hwadd = address & 0x1fffffff;
 
-    if (g_emulator->settings.get<Emulator::SettingPIOConnected>().value) {
+    if (g_emulator->m_mem->getBusConfig().pioConnected) {
         return m_pal.read8(hwadd);
     } else {
         return 0xff;
@@ -66,7 +66,7 @@ uint8_t PCSX::PIOCart::read8(uint32_t address) {
 
 void PCSX::PIOCart::write8(uint32_t address, uint8_t value) {
     uint32_t hwadd = address & 0x1fffffff;
-    if (g_emulator->settings.get<Emulator::SettingPIOConnected>().value) {
+    if (g_emulator->m_mem->getBusConfig().pioConnected) {
         m_pal.write8(hwadd, value);
     }
 }
@@ -23,11 +23,14 @@
 
 #include "core/psxcounters.h"
 
+#include <algorithm>
+
 #include "core/debug.h"
 #include "core/gpu.h"
 #include "core/sio1.h"
 #include "fmt/printf.h"
 #include "spu/interface.h"
+#include "support/instrumentation.h"
 
 template <typename... Args>
 void verboseLog(int32_t level, const char *str, const Args &... args) {
@@ -159,8 +162,19 @@ void PCSX::Counters::update() {
         int32_t framesDiff = target - newFrames;
         if (framesDiff > 0) {
             g_emulator->m_cpu->m_regs.previousCycles = cycle;
-            g_emulator->m_spu->waitForGoal(target);
             m_audioFrames = target;
+            int32_t throttle = audioThrottleFrames(framesDiff, g_emulator->m_spu->getFrameCount());
+            if (throttle > 0) {
+                // This only paces the emulation: the wait never lasts longer than it
+                // takes to play the frames we're ahead by, so late audio callbacks,
+                // or a device that stopped altogether, can't turn into a stall. Any
+                // remaining lead simply gets throttled again on the next update.
+                PCSX_INSTRUMENT(Throttle);
+                auto start = std::chrono::steady_clock::now();
+                g_emulator->m_spu->waitForGoal(newFrames + throttle,
+                                               std::chrono::microseconds(int64_t(throttle) * 1000000 / 44100));
+                m_audioStall += std::chrono::steady_clock::now() - start;
+            }
         } else if (framesDiff < -2000000000) {
             m_audioFrames = newFrames;
         }
@@ -205,6 +219,7 @@ void PCSX::Counters::update() {
         if (m_hSyncCount == VBlankStart[PCSX::g_emulator->settings.get<PCSX::Emulator::SettingVideo>()]) {
             setIrq(0x01);
             PCSX::g_emulator->vsync();
+            rollAudioStallWindow();
         }
 
         if (m_hSyncCount >= m_HSyncTotal[PCSX::g_emulator->settings.get<PCSX::Emulator::SettingVideo>()]) {
@@ -213,6 +228,16 @@ void PCSX::Counters::update() {
     }
 }
 
+void PCSX::Counters::rollAudioStallWindow() {
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = now - m_audioStallWindowStart;
+    if (elapsed < std::chrono::seconds(1)) return;
+    m_audioStallPerSecond = std::chrono::duration<float, std::milli>(m_audioStall).count() /
+                            std::chrono::duration<float>(elapsed).count();
+    m_audioStall = {};
+    m_audioStallWindowStart = now;
+}
+
 void PCSX::Counters::writeCounter(uint32_t index, uint32_t value) {
     verboseLog(2, "[RCNT %i] writeCounter: %x\n", index, value);
 
@@ -296,14 +321,12 @@ uint32_t PCSX::Counters::readCounter(uint32_t index) {
          *RCNT implementation here is only 99% compatible. Assumed this since easities to fix (only PE2 known to be
          *affected).
          */
-        static uint32_t clast = 0xffff;
-        static uint32_t cylast = 0;
         uint32_t count1 = count;
         count /= PCSX::Emulator::BIAS;
-        verboseLog(4, "[RCNT %i] rcountpe2: %x %x %x (%u)\n", index, count, count1, clast,
-                   (PCSX::g_emulator->m_cpu->m_regs.cycle - cylast));
-        cylast = PCSX::g_emulator->m_cpu->m_regs.cycle;
-        clast = count;
+        verboseLog(4, "[RCNT %i] rcountpe2: %x %x %x (%u)\n", index, count, count1, m_pe2LastCount,
+                   (PCSX::g_emulator->m_cpu->m_regs.cycle - m_pe2LastCycle));
+        m_pe2LastCycle = PCSX::g_emulator->m_cpu->m_regs.cycle;
+        m_pe2LastCount = count;
     }
 
     verboseLog(2, "[RCNT %i] rcount: %x\n", index, count);
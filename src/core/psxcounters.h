@@ -19,6 +19,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+
 #include "core/psxemulator.h"
 #include "core/psxmem.h"
 #include "core/r3000a.h"
@@ -83,6 +86,20 @@ class Counters {
     uint32_t m_hSyncCount = 0;
     uint32_t m_audioFrames = 0;
     int32_t m_spuSyncCountdown = 0;
+    // Last values seen by the rcountpe2 debug log.
+    uint32_t m_pe2LastCount = 0xffff;
+    uint32_t m_pe2LastCycle = 0;
+
+    // The emulation may run ahead of the audio device by this many of its
+    // periods before getting throttled back. The slack never goes over half of
+    // the SPU's 2048 frames voice stream, or the stream would fill up, and drop
+    // audio, before the throttling kicks in with large device periods.
+    static const int32_t AudioSlackPeriods = 4;
+    static const int32_t MinAudioSlack = 512;
+    void rollAudioStallWindow();
+    std::chrono::steady_clock::duration m_audioStall{};
+    std::chrono::steady_clock::time_point m_audioStallWindowStart{};
+    float m_audioStallPerSecond = 0.0f;
 
     uint32_t m_HSyncTotal[PCSX::Emulator::PSX_TYPE_PAL + 1];  // 2
   public:
@@ -99,6 +116,21 @@ class Counters {
     uint32_t readMode(uint32_t index);
     uint32_t readTarget(uint32_t index);
 
+    // Given how many frames the emulation is ahead of the audio device, and the
+    // device's period, returns how many frames it should let the device play
+    // before going on: none while within the slack, and when beyond it, enough
+    // to fall back to half of it, so the next few callbacks' jitter is absorbed.
+    static constexpr int32_t MaxAudioSlack = 1024;
+    static constexpr int32_t audioThrottleFrames(int32_t framesAhead, uint32_t periodFrames) {
+        int32_t slack = std::clamp<int32_t>(AudioSlackPeriods * std::min<uint32_t>(periodFrames, MaxAudioSlack),
+                                            MinAudioSlack, MaxAudioSlack);
+        if (framesAhead <= slack) return 0;
+        return framesAhead - slack / 2;
+    }
+
+    // Milliseconds spent waiting on the audio device over the last second.
+    float getAudioStallPerSecond() const { return m_audioStallPerSecond; }
+
     void serialize(SaveStateWrapper *);
     void deserialize(const SaveStateWrapper *);
 };
@@ -41,8 +41,7 @@ void dma4(uint32_t madr, uint32_t bcr, uint32_t chcr) {  // SPU
             }
             size = (bcr >> 16) * (bcr & 0xffff) * 2;
             PCSX::g_emulator->m_spu->writeDMAMem(ptr, size);
-            if (PCSX::g_emulator->settings.get<PCSX::Emulator::SettingDebugSettings>()
-                    .get<PCSX::Emulator::DebugSettings::Debug>()) {
+            if (PCSX::g_emulator->m_mem->getBusConfig().debug) {
                 PCSX::g_emulator->m_debug->checkDMAread(4, madr, size * 2);
             }
 
@@ -61,8 +60,7 @@ void dma4(uint32_t madr, uint32_t bcr, uint32_t chcr) {  // SPU
             }
             size = (bcr >> 16) * (bcr & 0xffff) * 2;
             PCSX::g_emulator->m_spu->readDMAMem(ptr, size);
-            if (PCSX::g_emulator->settings.get<PCSX::Emulator::SettingDebugSettings>()
-                    .get<PCSX::Emulator::DebugSettings::Debug>()) {
+            if (PCSX::g_emulator->m_mem->getBusConfig().debug) {
                 PCSX::g_emulator->m_debug->checkDMAwrite(4, madr, size * 2);
             }
             PCSX::g_emulator->m_cpu->Clear(madr, size * 2);
@@ -105,8 +103,7 @@ void dma6(uint32_t madr, uint32_t bcr, uint32_t chcr) {
         }
         mem++;
         *mem = 0xffffff;
-        if (PCSX::g_emulator->settings.get<PCSX::Emulator::SettingDebugSettings>()
-                .get<PCSX::Emulator::DebugSettings::Debug>()) {
+        if (PCSX::g_emulator->m_mem->getBusConfig().debug) {
             PCSX::g_emulator->m_debug->checkDMAwrite(6, madr, size * 4);
         }
 
@@ -21,6 +21,7 @@
 
 #include "core/callstacks.h"
 #include "core/cdrom.h"
+#include "core/cputrace.h"
 #include "core/debug.h"
 #include "core/eventslua.h"
 #include "core/gdb-server.h"
@@ -29,10 +30,12 @@
 #include "core/gte.h"
 #include "core/luaiso.h"
 #include "core/mdec.h"
+#include "core/memory-scanner.h"
 #include "core/pad.h"
 #include "core/pcsxlua.h"
 #include "core/pio-cart.h"
 #include "core/r3000a.h"
+#include "core/sampling-profiler.h"
 #include "core/sio.h"
 #include "core/sio1-server.h"
 #include "core/sio1.h"
@@ -47,6 +50,7 @@ extern "C" {
 #include "luv/src/luv.h"
 }
 #include "spu/interface.h"
+#include "support/instrumentation.h"
 #include "supportpsx/adpcmlua.h"
 #include "supportpsx/assembler.h"
 #include "supportpsx/binlua.h"
@@ -57,16 +61,20 @@ PCSX::Emulator::Emulator()
     : m_callStacks(new PCSX::CallStacks),
       m_cdrom(PCSX::CDRom::factory()),
       m_counters(new PCSX::Counters()),
+      m_cpuTrace(new PCSX::CPUTrace()),
       m_debug(new PCSX::Debug()),
       m_gdbServer(new PCSX::GdbServer()),
       m_gpuLogger(new PCSX::GPULogger()),
       m_gte(new PCSX::GTE()),
       m_hw(new PCSX::HW()),
+      m_instrumentation(new PCSX::Instrumentation()),
       m_lua(new PCSX::Lua()),
       m_mdec(new PCSX::MDEC()),
       m_mem(new PCSX::Memory()),
+      m_memoryScanner(new PCSX::MemoryScanner()),
       m_pads(PCSX::Pads::factory()),
       m_pioCart(new PCSX::PIOCart),
+      m_samplingProfiler(new PCSX::SamplingProfiler()),
       m_sio(new PCSX::SIO()),
       m_sio1(new PCSX::SIO1()),
       m_sio1Server(new PCSX::SIO1Server()),
@@ -75,6 +83,7 @@ PCSX::Emulator::Emulator()
       m_webServer(new PCSX::WebServer()) {
     auto L = *m_lua;
     L.openlibs();
+    Instrumentation::setCurrent(m_instrumentation.get());
 }
 
 void PCSX::Emulator::setLua() {
@@ -117,6 +126,11 @@ void PCSX::Emulator::setLua() {
     L.settable();
     L.pop();
     L.pop();
+    L.push([](lua_State* L_) -> int {
+        g_system->m_eventBus->signal(Events::SettingsChanged{});
+        return 0;
+    });
+    L.setfield("SettingsChanged", LUA_REGISTRYINDEX);
 
     m_pads->setLua(L);
 
@@ -124,6 +138,7 @@ void PCSX::Emulator::setLua() {
 }
 
 PCSX::Emulator::~Emulator() {
+    if (Instrumentation::current() == m_instrumentation.get()) Instrumentation::setCurrent(nullptr);
     // TODO: move Lua to g_system.
     m_lua->close();
 }
@@ -155,7 +170,10 @@ void PCSX::Emulator::reset() {
 }
 
 void PCSX::Emulator::shutdown() {
+    m_cdrom->reportAcceleration();
+    m_sio->flushMcds();
     m_mem->shutdown();
+    m_cpuTrace->stop();
     m_cpu->psxShutdown();
 
     m_pads->shutdown();
@@ -163,8 +181,13 @@ void PCSX::Emulator::shutdown() {
 
 void PCSX::Emulator::vsync() {
     m_gpu->vblank();
+    m_sio->commitMcds();
     g_system->m_eventBus->signal<Events::GPU::VSync>({});
-    g_system->update(true);
+    {
+        PCSX_INSTRUMENT(Frontend);
+        g_system->update(true);
+    }
+    m_instrumentation->endFrame();
 
     if (m_config.RewindInterval > 0 && !(++m_rewind_counter % m_config.RewindInterval)) {
         // CreateRewindState();
@@ -173,4 +196,15 @@ void PCSX::Emulator::vsync() {
 
 void PCSX::Emulator::setPGXPMode(uint32_t pgxpMode) { m_cpu->psxSetPGXPMode(pgxpMode); }
 
-PCSX::Emulator* PCSX::g_emulator;
+thread_local PCSX::Emulator* PCSX::g_emulator = nullptr;
+
+PCSX::Emulator::ThreadBinding::ThreadBinding(Emulator* emulator, System* system)
+    : m_previousEmulator(g_emulator), m_previousSystem(g_system) {
+    g_emulator = emulator;
+    g_system = system;
+}
+
+PCSX::Emulator::ThreadBinding::~ThreadBinding() {
+    g_emulator = m_previousEmulator;
+    g_system = m_previousSystem;
+}
@@ -66,17 +66,21 @@ namespace PCSX {
 class CallStacks;
 class CDRom;
 class Counters;
+class CPUTrace;
 class Debug;
 class GdbServer;
 class GPU;
 class GPULogger;
 class GTE;
 class HW;
+class Instrumentation;
 class Lua;
 class MDEC;
 class Memory;
+class MemoryScanner;
 class Pads;
 class R3000Acpu;
+class SamplingProfiler;
 class SIO;
 class SPUInterface;
 class System;
@@ -87,7 +91,10 @@ class SIO1Client;
 class PIOCart;
 
 class Emulator;
-extern Emulator* g_emulator;
+// Both g_emulator and g_system are bound per thread, so that several emulators
+// can run side by side, each on its own thread. Threads spawned by the core
+// which need to reach back into it have to bind them using Emulator::ThreadBinding.
+extern thread_local Emulator* g_emulator;
 
 class Emulator {
   public:
@@ -96,11 +103,31 @@ class Emulator {
     Emulator(Emulator&&) = delete;
     Emulator(const Emulator&) = delete;
     Emulator& operator=(const Emulator&) = delete;
+
+    // Binds an emulator and its system to the calling thread for the lifetime
+    // of this object, restoring whatever was bound there before.
+    class ThreadBinding {
+      public:
+        ThreadBinding(Emulator* emulator, System* system);
+        ~ThreadBinding();
+        ThreadBinding(const ThreadBinding&) = delete;
+        ThreadBinding& operator=(const ThreadBinding&) = delete;
+
+      private:
+        Emulator* m_previousEmulator;
+        System* m_previousSystem;
+    };
+
     enum VideoType { PSX_TYPE_NTSC = 0, PSX_TYPE_PAL };    // PSX Types
     enum CDDAType { CDDA_DISABLED = 0, CDDA_ENABLED_LE };  // CDDA Types
     struct DebugSettings {
         typedef Setting<bool, TYPESTRING("Debug")> Debug;
         typedef Setting<bool, TYPESTRING("Trace")> Trace;
+        typedef SettingPath<TYPESTRING("TraceFile")> TraceFile;
+        typedef Setting<uint32_t, TYPESTRING("TraceStartPC"), 0xffffffff> TraceStartPC;
+        typedef Setting<uint32_t, TYPESTRING("TraceStopPC"), 0xffffffff> TraceStopPC;
+        typedef Setting<uint32_t, TYPESTRING("TraceStartCycle"), 0xffffffff> TraceStartCycle;
+        typedef Setting<uint32_t, TYPESTRING("TraceStopCycle"), 0xffffffff> TraceStopCycle;
         typedef Setting<bool, TYPESTRING("KernelLog")> KernelLog;
         typedef Setting<uint32_t, TYPESTRING("FirstChanceException"), 0x00001cf0> FirstChanceException;
         typedef Setting<bool, TYPESTRING("SkipISR")> SkipISR;
@@ -139,12 +166,15 @@ class Emulator {
             Raw,
         };
         typedef Setting<SIO1Mode, TYPESTRING("SIO1Mode"), SIO1Mode::Protobuf> SIO1ModeSetting;
-        typedef Settings<Debug, Trace, KernelLog, FirstChanceException, SkipISR, LoggingCDROM, GdbServer, GdbManifest,
-                         GdbLogSetting, GdbServerPort, GdbServerTrace, WebServer, WebServerPort, KernelCallA0_00_1f,
+        typedef Setting<bool, TYPESTRING("PerfMap"), false> PerfMap;
+        typedef Setting<bool, TYPESTRING("JitDump"), false> JitDump;
+        typedef Settings<Debug, Trace, TraceFile, TraceStartPC, TraceStopPC, TraceStartCycle, TraceStopCycle,
+                         KernelLog, FirstChanceException, SkipISR, LoggingCDROM, GdbServer, GdbManifest, GdbLogSetting,
+                         GdbServerPort, GdbServerTrace, WebServer, WebServerPort, KernelCallA0_00_1f,
                          KernelCallA0_20_3f, KernelCallA0_40_5f, KernelCallA0_60_7f, KernelCallA0_80_9f,
                          KernelCallA0_a0_bf, KernelCallB0_00_1f, KernelCallB0_20_3f, KernelCallB0_40_5f,
                          KernelCallC0_00_1f, PCdrv, PCdrvBase, SIO1Server, SIO1ServerPort, SIO1Client, SIO1ClientHost,
-                         SIO1ClientPort, SIO1ModeSetting>
+                         SIO1ClientPort, SIO1ModeSetting, PerfMap, JitDump>
             type;
     };
     typedef SettingNested<TYPESTRING("Debug"), DebugSettings::type> SettingDebugSettings;
@@ -166,7 +196,9 @@ class Emulator {
     typedef Setting<bool, TYPESTRING("Mcd1Inserted"), true> SettingMcd1Inserted;
     typedef Setting<bool, TYPESTRING("Mcd2Inserted"), true> SettingMcd2Inserted;
     typedef Setting<bool, TYPESTRING("Dynarec"), true> SettingDynarec;
+    typedef Setting<bool, TYPESTRING("CachedInterpreter"), false> SettingCachedInterpreter;
     typedef Setting<bool, TYPESTRING("8Megs"), false> Setting8MB;
+    typedef Setting<bool, TYPESTRING("Fastmem"), false> SettingFastmem;
     typedef Setting<int, TYPESTRING("GUITheme"), 0> SettingGUITheme;
     typedef Setting<int, TYPESTRING("Dither"), 1> SettingDither;
     typedef Setting<bool, TYPESTRING("UseCachedDithering"), false> SettingCachedDithering;
@@ -185,6 +217,10 @@ class Emulator {
     typedef SettingPath<TYPESTRING("EXP1Filepath")> SettingEXP1Filepath;
     typedef SettingPath<TYPESTRING("EXP1BrowsePath")> SettingEXP1BrowsePath;
     typedef Setting<bool, TYPESTRING("PIOConnected")> SettingPIOConnected;
+    // Divider applied to the CD-ROM mechanical delays; 1 is the real speed, 0 is instant.
+    typedef Setting<int, TYPESTRING("CDSpeedup"), 1> SettingCDSpeedup;
+    // Maps disc images in memory instead of reading them through the file API.
+    typedef Setting<bool, TYPESTRING("MmapDiscImages"), false> SettingMmapDiscImages;
 
     Settings<SettingMcd1, SettingMcd2, SettingBios, SettingPpfDir, SettingPsxExe, SettingXa, SettingSpuIrq,
              SettingBnWMdec, SettingScaler, SettingAutoVideo, SettingVideo, SettingFastBoot, SettingDebugSettings,
@@ -193,7 +229,7 @@ class Emulator {
              SettingGLErrorReportingSeverity, SettingFullCaching, SettingHardwareRenderer, SettingShownAutoUpdateConfig,
              SettingAutoUpdate, SettingMSAA, SettingLinearFiltering, SettingKioskMode, SettingMcd1Pocketstation,
              SettingMcd2Pocketstation, SettingBiosBrowsePath, SettingEXP1Filepath, SettingEXP1BrowsePath,
-             SettingPIOConnected>
+             SettingPIOConnected, SettingCachedInterpreter, SettingFastmem, SettingCDSpeedup, SettingMmapDiscImages>
         settings;
     class PcsxConfig {
       public:
@@ -239,18 +275,22 @@ class Emulator {
     std::unique_ptr<CallStacks> m_callStacks;
     std::unique_ptr<CDRom> m_cdrom;
     std::unique_ptr<Counters> m_counters;
+    std::unique_ptr<CPUTrace> m_cpuTrace;
     std::unique_ptr<Debug> m_debug;
     std::unique_ptr<GdbServer> m_gdbServer;
     std::unique_ptr<GPU> m_gpu;
     std::unique_ptr<GPULogger> m_gpuLogger;
     std::unique_ptr<GTE> m_gte;
     std::unique_ptr<HW> m_hw;
+    std::unique_ptr<Instrumentation> m_instrumentation;
     std::unique_ptr<Lua> m_lua;
     std::unique_ptr<MDEC> m_mdec;
     std::unique_ptr<Memory> m_mem;
+    std::unique_ptr<MemoryScanner> m_memoryScanner;
     std::unique_ptr<Pads> m_pads;
     std::unique_ptr<PIOCart> m_pioCart;
     std::unique_ptr<R3000Acpu> m_cpu;
+    std::unique_ptr<SamplingProfiler> m_samplingProfiler;
     std::unique_ptr<SIO> m_sio;
     std::unique_ptr<SIO1> m_sio1;
     std::unique_ptr<SIO1Server> m_sio1Server;
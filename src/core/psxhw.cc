@@ -31,6 +31,7 @@
 #include "core/sio1.h"
 #include "lua/luawrapper.h"
 #include "spu/interface.h"
+#include "support/instrumentation.h"
 
 static constexpr bool between(uint32_t val, uint32_t beg, uint32_t end) {
     return (beg > end) ? false : (val >= beg && val <= end - 3);
@@ -431,6 +432,7 @@ void PCSX::HW::write8(uint32_t add, uint32_t rawvalue) {
                 L.gettable();
                 if (L.isfunction()) {
                     try {
+                        PCSX_INSTRUMENT(Lua);
                         L.pcall();
                     } catch (...) {
                         g_system->pause();
@@ -17,9 +17,14 @@
  *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
  ***************************************************************************/
 
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <utility>
+
 #include "core/callstacks.h"
+#include "core/cputrace.h"
 #include "core/debug.h"
-#include "core/disr3000a.h"
 #include "core/gte.h"
 #include "core/pgxp_cpu.h"
 #include "core/pgxp_debug.h"
@@ -94,6 +99,11 @@ class InterpretedCPU final : public PCSX::R3000Acpu {
     virtual void Shutdown() override;
     virtual void SetPGXPMode(uint32_t pgxpMode) override;
     virtual bool isDynarec() override { return false; }
+    virtual void invalidateCache() override {
+        R3000Acpu::invalidateCache();
+        flushCachedCode();
+    }
+    void toggleTrace(bool enabled);
     void maybeCancelDelayedLoad(uint32_t index) {
         unsigned other = m_currentDelayedLoad ^ 1;
         if (m_delayedLoadInfo[other].index == index) m_delayedLoadInfo[other].active = false;
@@ -114,8 +124,80 @@ class InterpretedCPU final : public PCSX::R3000Acpu {
     cIntFunc_t *s_pPsxCP2 = NULL;
     cIntFunc_t *s_pPsxCP2BSC = NULL;
 
-    template <bool debug, bool trace>
+    // The cached interpreter decodes guest code a basic block at a time, into
+    // one entry per word holding the opcode and its final handler, so running
+    // it again skips the instruction fetch and the secondary dispatch tables.
+    // Entries are indexed by physical address, main RAM followed by the BIOS,
+    // and are wiped through Clear when the word they came from is written to.
+    struct CachedInstruction {
+        cIntFunc_t *handler;
+        uint32_t code;
+    };
+    static constexpr uint32_t c_cachedPageSize = 0x1000;
+    static constexpr uint32_t c_cachedPageEntries = c_cachedPageSize / 4;
+    static constexpr uint32_t c_cachedRAMSize = 0x800000;
+    static constexpr uint32_t c_cachedBIOSSize = 0x80000;
+    static constexpr uint32_t c_cachedPages = (c_cachedRAMSize + c_cachedBIOSSize) / c_cachedPageSize;
+    std::unique_ptr<std::unique_ptr<CachedInstruction[]>[]> m_cachedPages;
+    bool m_lastCached = false;
+
+    CachedInstruction *cachedEntry(uint32_t pc, bool allocate);
+    const CachedInstruction *fetchCached(uint32_t pc);
+    cIntFunc_t *resolveHandler(uint32_t code);
+    void flushCachedCode();
+
+    // execBlock gets instantiated for every combination of these, so that
+    // none of them are checked while running a block. Execute picks the
+    // instance matching the current settings before each block.
+    enum : unsigned {
+        EXEC_DEBUG = 1,
+        EXEC_TRACE = 2,
+        EXEC_CACHED = 4,
+        EXEC_RAM8M = 8,
+        EXEC_PGXP = 16,
+        EXEC_MODES = 32,
+    };
+    typedef void (InterpretedCPU::*execBlock_t)();
+    template <unsigned mode>
     void execBlock();
+    template <size_t... modes>
+    static constexpr std::array<execBlock_t, sizeof...(modes)> makeExecBlocks(std::index_sequence<modes...>) {
+        return {&InterpretedCPU::execBlock<modes>...};
+    }
+    static const std::array<execBlock_t, EXEC_MODES> s_execBlocks;
+    uint32_t m_pgxpMode = 0;
+
+    // Instruction fetch, which reads main RAM straight from the host memory
+    // instead of going through the generic accessors, with the mirroring
+    // known at compile time. Otherwise identical to readICache.
+    template <bool ram8M>
+    uint32_t fetch(uint32_t pc) {
+        constexpr uint32_t ramMask = ram8M ? 0x7fffff : 0x1fffff;
+        const uint32_t pcBank = pc >> 24;
+        const bool cachedBank = (pcBank == 0x00) || (pcBank == 0x80);
+        if ((!cachedBank && (pcBank != 0xa0)) || (pc & 0x800000)) return readICache(pc);
+
+        const uint8_t *ram = PCSX::g_emulator->m_mem->m_wram;
+        auto word = [ram](uint32_t address) {
+            return SWAP_LEu32(*reinterpret_cast<const uint32_t *>(ram + (address & ramMask)));
+        };
+        if (!cachedBank) return word(pc);
+
+        uint32_t pcOffset = pc & 0xffffff;
+        uint32_t pcCache = pc & 0xfff;
+        uint8_t *iAddr = m_regs.iCacheAddr;
+        uint8_t *iCode = m_regs.iCacheCode;
+        if (SWAP_LE32(*(uint32_t *)(iAddr + pcCache)) == pcOffset) return SWAP_LE32(*(uint32_t *)(iCode + pcCache));
+
+        pcOffset &= ~0xf;
+        pcCache &= ~0xf;
+        const uint32_t line = pc & ~0xf;
+        for (uint32_t i = 0; i < 0x10; i += 4) {
+            *(uint32_t *)(iAddr + pcCache + i) = SWAP_LE32(pcOffset + i);
+            *(uint32_t *)(iCode + pcCache + i) = word(line + i);
+        }
+        return word(pc);
+    }
     void doBranch(uint32_t target, bool fromLink);
 
     void MTC0(int reg, uint32_t val);
@@ -321,6 +403,12 @@ class InterpretedCPU final : public PCSX::R3000Acpu {
     void pgxpPsxMTC0(uint32_t code);
     void pgxpPsxCTC0(uint32_t code);
     void pgxpPsxRFE(uint32_t code);
+    // The value a load, or a move from a coprocessor, is putting into $rt once its delay slot is over.
+    uint32_t pgxpLoadedValue(uint32_t code) {
+        const auto &delayedLoad = m_delayedLoadInfo[m_currentDelayedLoad];
+        if (!_Rt_ || !delayedLoad.active || (delayedLoad.index != _Rt_)) return m_regs.GPR.r[_Rt_];
+        return (m_regs.GPR.r[_Rt_] & delayedLoad.mask) | delayedLoad.value;
+    }
 
     static const intFunc_t s_pgxpPsxBSC[64];
     static const intFunc_t s_pgxpPsxSPC[64];
@@ -351,8 +439,7 @@ void InterpretedCPU::psxADDI(uint32_t code) {
         }
     }
 
-    if (PCSX::g_emulator->settings.get<PCSX::Emulator::SettingDebugSettings>()
-            .get<PCSX::Emulator::DebugSettings::Debug>()) {
+    if (PCSX::g_emulator->m_mem->getBusConfig().debug) {
         bool overflow = ((rs ^ res) & (imm ^ res)) >> 31;  // fast signed overflow calculation algorithm
         if (overflow) {                                    // if an overflow occurs, throw an exception
             m_regs.pc -= 4;
@@ -445,8 +532,7 @@ void InterpretedCPU::psxADD(uint32_t code) {
         }
     }
 
-    if (PCSX::g_emulator->settings.get<PCSX::Emulator::SettingDebugSettings>()
-            .get<PCSX::Emulator::DebugSettings::Debug>()) {
+    if (PCSX::g_emulator->m_mem->getBusConfig().debug) {
         bool overflow = ((rs ^ res) & (rt ^ res)) >> 31;  // fast signed overflow calculation algorithm
         if (overflow) {                                   // if an overflow occurs, throw an exception
             m_regs.pc -= 4;
@@ -487,8 +573,7 @@ void InterpretedCPU::psxSUB(uint32_t code) {
         }
     }
 
-    if (PCSX::g_emulator->settings.get<PCSX::Emulator::SettingDebugSettings>()
-            .get<PCSX::Emulator::DebugSettings::Debug>()) {
+    if (PCSX::g_emulator->m_mem->getBusConfig().debug) {
         bool overflow = ((rs ^ res) & (~rt ^ res)) >> 31;  // fast signed overflow calculation algorithm
         if (overflow) {                                    // if an overflow occurs, throw an exception
             m_regs.pc -= 4;
@@ -1360,14 +1445,14 @@ PGXP_INT_FUNC_1_1(CPU, SW, 0, 2, m_regs.GPR.r[_Rt_], _oB_)
 PGXP_INT_FUNC_1_1(CPU, SWL, 0, 2, m_regs.GPR.r[_Rt_], _oB_)
 PGXP_INT_FUNC_1_1(CPU, SWR, 0, 2, m_regs.GPR.r[_Rt_], _oB_)
 
-// Rt = Mem[addr]
-PGXP_INT_FUNC_1_1(CPU, LWL, 0, 2, m_regs.GPR.r[_Rt_], _oB_)
-PGXP_INT_FUNC_1_1(CPU, LW, 0, 2, m_regs.GPR.r[_Rt_], _oB_)
-PGXP_INT_FUNC_1_1(CPU, LWR, 0, 2, m_regs.GPR.r[_Rt_], _oB_)
-PGXP_INT_FUNC_1_1(CPU, LH, 0, 2, m_regs.GPR.r[_Rt_], _oB_)
-PGXP_INT_FUNC_1_1(CPU, LHU, 0, 2, m_regs.GPR.r[_Rt_], _oB_)
-PGXP_INT_FUNC_1_1(CPU, LB, 0, 2, m_regs.GPR.r[_Rt_], _oB_)
-PGXP_INT_FUNC_1_1(CPU, LBU, 0, 2, m_regs.GPR.r[_Rt_], _oB_)
+// Rt = Mem[addr], once the load delay is over
+PGXP_INT_FUNC_1_1(CPU, LWL, 0, 2, pgxpLoadedValue(code), _oB_)
+PGXP_INT_FUNC_1_1(CPU, LW, 0, 2, pgxpLoadedValue(code), _oB_)
+PGXP_INT_FUNC_1_1(CPU, LWR, 0, 2, pgxpLoadedValue(code), _oB_)
+PGXP_INT_FUNC_1_1(CPU, LH, 0, 2, pgxpLoadedValue(code), _oB_)
+PGXP_INT_FUNC_1_1(CPU, LHU, 0, 2, pgxpLoadedValue(code), _oB_)
+PGXP_INT_FUNC_1_1(CPU, LB, 0, 2, pgxpLoadedValue(code), _oB_)
+PGXP_INT_FUNC_1_1(CPU, LBU, 0, 2, pgxpLoadedValue(code), _oB_)
 
 // Rd = Rt op Sa
 PGXP_INT_FUNC_1_1(CPU, SLL, !_Rd_, 2, m_regs.GPR.r[_Rd_], m_regs.GPR.r[_Rt_])
@@ -1385,8 +1470,8 @@ PGXP_INT_FUNC_1_1(CPU, MFLO, !_Rd_, 2, m_regs.GPR.r[_Rd_], m_regs.GPR.n.lo)
 PGXP_INT_FUNC_1_1(CPU, MTLO, 0, 2, m_regs.GPR.n.lo, m_regs.GPR.r[_Rd_])
 
 // COP2 (GTE)
-PGXP_INT_FUNC_1_1(GTE, MFC2, !_Rt_, 2, m_regs.GPR.r[_Rt_], m_regs.CP2D.r[_Rd_])
-PGXP_INT_FUNC_1_1(GTE, CFC2, !_Rt_, 2, m_regs.GPR.r[_Rt_], m_regs.CP2C.r[_Rd_])
+PGXP_INT_FUNC_1_1(GTE, MFC2, !_Rt_, 2, pgxpLoadedValue(code), m_regs.CP2D.r[_Rd_])
+PGXP_INT_FUNC_1_1(GTE, CFC2, !_Rt_, 2, pgxpLoadedValue(code), m_regs.CP2C.r[_Rd_])
 PGXP_INT_FUNC_1_1(GTE, MTC2, 0, 2, m_regs.CP2D.r[_Rd_], m_regs.GPR.r[_Rt_])
 PGXP_INT_FUNC_1_1(GTE, CTC2, 0, 2, m_regs.CP2C.r[_Rd_], m_regs.GPR.r[_Rt_])
 
@@ -1394,8 +1479,8 @@ PGXP_INT_FUNC_1_1(GTE, LWC2, 0, 2, m_regs.CP2D.r[_Rt_], _oB_)
 PGXP_INT_FUNC_1_1(GTE, SWC2, 0, 2, m_regs.CP2D.r[_Rt_], _oB_)
 
 // COP0
-PGXP_INT_FUNC_1_1(CP0, MFC0, !_Rd_, 2, m_regs.GPR.r[_Rt_], m_regs.CP0.r[_Rd_])
-PGXP_INT_FUNC_1_1(CP0, CFC0, !_Rd_, 2, m_regs.GPR.r[_Rt_], m_regs.CP0.r[_Rd_])
+PGXP_INT_FUNC_1_1(CP0, MFC0, !_Rd_, 2, pgxpLoadedValue(code), m_regs.CP0.r[_Rd_])
+PGXP_INT_FUNC_1_1(CP0, CFC0, !_Rd_, 2, pgxpLoadedValue(code), m_regs.CP0.r[_Rd_])
 PGXP_INT_FUNC_1_1(CP0, MTC0, !_Rt_, 2, m_regs.CP0.r[_Rd_], m_regs.GPR.r[_Rt_])
 PGXP_INT_FUNC_1_1(CP0, CTC0, !_Rt_, 2, m_regs.CP0.r[_Rd_], m_regs.GPR.r[_Rt_])
 PGXP_INT_FUNC(CP0, RFE)
@@ -1568,27 +1653,130 @@ void InterpretedCPU::Execute() {
                                 .get<PCSX::Emulator::DebugSettings::Trace>();
         const bool &skipISR = PCSX::g_emulator->settings.get<PCSX::Emulator::SettingDebugSettings>()
                                   .get<PCSX::Emulator::DebugSettings::SkipISR>();
-        if (debug) {
-            if (!trace || (skipISR && m_inISR)) {
-                execBlock<true, false>();
-            } else {
-                execBlock<true, true>();
-            }
+        const bool &cached = PCSX::g_emulator->settings.get<PCSX::Emulator::SettingCachedInterpreter>();
+        if (trace != PCSX::g_emulator->m_cpuTrace->started()) toggleTrace(trace);
+        // The cached interpreter doesn't go through the instruction cache
+        // emulation, so its contents are stale when switching back and forth.
+        if (cached != m_lastCached) {
+            R3000Acpu::invalidateCache();
+            m_lastCached = cached;
+        }
+        const bool tracing = trace && !(skipISR && m_inISR);
+        const bool ram8M = PCSX::g_emulator->m_mem->getBusConfig().ramSize == 0x800000;
+        const unsigned mode = (debug ? EXEC_DEBUG : 0) | (tracing ? EXEC_TRACE : 0) | (cached ? EXEC_CACHED : 0) |
+                              (ram8M ? EXEC_RAM8M : 0) | (m_pgxpMode ? EXEC_PGXP : 0);
+        (this->*s_execBlocks[mode])();
+    }
+}
+void InterpretedCPU::toggleTrace(bool enabled) {
+    auto &tracer = *PCSX::g_emulator->m_cpuTrace;
+    if (!enabled) {
+        tracer.stop();
+        return;
+    }
+    auto &debugSettings = PCSX::g_emulator->settings.get<PCSX::Emulator::SettingDebugSettings>();
+    std::filesystem::path path = debugSettings.get<PCSX::Emulator::DebugSettings::TraceFile>();
+    if (path.empty()) path = PCSX::g_system->getPersistentDir() / "cpu.trace";
+    PCSX::CPUTrace::Triggers triggers;
+    triggers.startPC = debugSettings.get<PCSX::Emulator::DebugSettings::TraceStartPC>();
+    triggers.stopPC = debugSettings.get<PCSX::Emulator::DebugSettings::TraceStopPC>();
+    triggers.startCycle = debugSettings.get<PCSX::Emulator::DebugSettings::TraceStartCycle>();
+    triggers.stopCycle = debugSettings.get<PCSX::Emulator::DebugSettings::TraceStopCycle>();
+    if (!tracer.start(path, triggers)) {
+        PCSX::g_system->printf(_("Unable to open CPU trace file %s\n"), path.string());
+        debugSettings.get<PCSX::Emulator::DebugSettings::Trace>() = false;
+    }
+}
+void InterpretedCPU::Clear(uint32_t Addr, uint32_t Size) {
+    if (!m_cachedPages) return;
+    Addr &= ~3;
+    while (Size) {
+        const uint32_t count = std::min(Size, (c_cachedPageSize - (Addr & (c_cachedPageSize - 1))) / 4);
+        CachedInstruction *entry = cachedEntry(Addr, false);
+        if (entry) std::fill_n(entry, count, CachedInstruction{});
+        Addr += count * 4;
+        Size -= count;
+    }
+}
+InterpretedCPU::CachedInstruction *InterpretedCPU::cachedEntry(uint32_t pc, bool allocate) {
+    auto &mem = *PCSX::g_emulator->m_mem;
+    const uint8_t *lut = mem.m_readLUT[pc >> 16];
+    if (!lut) return nullptr;
+    const uint8_t *host = lut + (pc & 0xfffc);
+    uint32_t offset;
+    if ((host >= mem.m_wram) && (host < mem.m_wram + c_cachedRAMSize)) {
+        offset = host - mem.m_wram;
+    } else if ((host >= mem.m_bios) && (host < mem.m_bios + c_cachedBIOSSize)) {
+        offset = c_cachedRAMSize + (host - mem.m_bios);
+    } else {
+        return nullptr;
+    }
+    auto &page = m_cachedPages[offset / c_cachedPageSize];
+    if (!page) {
+        if (!allocate) return nullptr;
+        // The extra entry past the end is never filled, so that running off
+        // the end of a page always goes back through a lookup.
+        page.reset(new CachedInstruction[c_cachedPageEntries + 1]());
+    }
+    return &page[(offset % c_cachedPageSize) / 4];
+}
+const InterpretedCPU::CachedInstruction *InterpretedCPU::fetchCached(uint32_t pc) {
+    if (!m_cachedPages) m_cachedPages.reset(new std::unique_ptr<CachedInstruction[]>[c_cachedPages]);
+    CachedInstruction *entry = cachedEntry(pc, true);
+    if (!entry || entry->handler) return entry;
+
+    // Decode up to the delay slot of the first branch or jump, stopping early
+    // at the end of the page, or when running into already decoded code.
+    const uint32_t *host = PCSX::g_emulator->m_mem->getPointer<const uint32_t>(pc & ~3);
+    const CachedInstruction *end = entry + c_cachedPageEntries - ((pc & (c_cachedPageSize - 1)) / 4);
+    bool delaySlot = false;
+    for (CachedInstruction *e = entry; (e < end) && !e->handler; e++) {
+        const uint32_t code = SWAP_LE32(*host++);
+        e->code = code;
+        e->handler = resolveHandler(code);
+        if (delaySlot) break;
+        const uint32_t op = code >> 26;
+        if (op == 0) {
+            const uint32_t funct = code & 0x3f;
+            delaySlot = (funct == 0x08) || (funct == 0x09);
         } else {
-            if (!trace || (skipISR && m_inISR)) {
-                execBlock<false, false>();
-            } else {
-                execBlock<false, true>();
-            }
+            delaySlot = op <= 0x07;
         }
     }
+    return entry;
+}
+InterpretedCPU::cIntFunc_t *InterpretedCPU::resolveHandler(uint32_t code) {
+    cIntFunc_t *handler = &s_pPsxBSC[code >> 26];
+    // These only dispatch further based on the opcode, so they can be
+    // skipped altogether. The COP2 one also checks the status register.
+    if (*handler == &InterpretedCPU::psxSPECIAL) {
+        handler = &s_pPsxSPC[_Funct_];
+    } else if (*handler == &InterpretedCPU::psxREGIMM) {
+        handler = &s_pPsxREG[_Rt_];
+    } else if (*handler == &InterpretedCPU::psxCOP0) {
+        handler = &s_pPsxCP0[_Rs_];
+    }
+    return handler;
+}
+void InterpretedCPU::flushCachedCode() {
+    if (!m_cachedPages) return;
+    for (uint32_t i = 0; i < c_cachedPages; i++) {
+        auto &page = m_cachedPages[i];
+        if (page) std::fill_n(page.get(), c_cachedPageEntries, CachedInstruction{});
+    }
 }
-void InterpretedCPU::Clear(uint32_t Addr, uint32_t Size) {}
 void InterpretedCPU::Shutdown() {}
 // interpreter execution
-template <bool debug, bool trace>
+template <unsigned mode>
 inline void InterpretedCPU::execBlock() {
+    constexpr bool debug = mode & EXEC_DEBUG;
+    constexpr bool trace = mode & EXEC_TRACE;
+    constexpr bool cached = mode & EXEC_CACHED;
+    constexpr bool ram8M = mode & EXEC_RAM8M;
+    constexpr bool pgxp = mode & EXEC_PGXP;
     bool ranDelaySlot = false;
+    [[maybe_unused]] const CachedInstruction *cachedIns = nullptr;
+    [[maybe_unused]] uint32_t cachedPC = 0;
     do {
         if (m_nextIsDelaySlot) {
             m_inDelaySlot = true;
@@ -1596,21 +1784,72 @@ inline void InterpretedCPU::execBlock() {
         }
         // TODO: throw an exception here if pc is out of range
         const uint32_t pc = m_regs.pc;
-        // TODO: throw an exception here if we don't have a pointer
-        uint32_t code = readICache(pc);
+        uint32_t code;
+        cIntFunc_t *func;
+        if constexpr (cached) {
+            // Keep walking the decoded entries for as long as execution is
+            // sequential, and none of them got wiped in the meantime.
+            if (!cachedIns || (cachedPC != pc) || !cachedIns->handler) {
+                cachedIns = fetchCached(pc);
+                cachedPC = pc;
+            }
+        }
+        if (cached && cachedIns) {
+            code = cachedIns->code;
+            func = cachedIns->handler;
+            cachedIns++;
+            cachedPC += 4;
+        } else {
+            // TODO: throw an exception here if we don't have a pointer
+            code = fetch<ram8M>(pc);
+            // Without PGXP, the tables are known at compile time.
+            func = pgxp ? &s_pPsxBSC[code >> 26] : &s_psxBSC[code >> 26];
+        }
 
         m_regs.code = code;
 
+        [[maybe_unused]] PCSX::CPUTrace::Record record;
+        [[maybe_unused]] bool traced = false;
+        [[maybe_unused]] const unsigned loadSlot = m_currentDelayedLoad;
         if constexpr (trace) {
-            std::string ins = PCSX::Disasm::asString(code, 0, pc, nullptr, true);
-            PCSX::g_system->log(PCSX::LogClass::CPU, "%s\n", ins);
+            traced = PCSX::g_emulator->m_cpuTrace->inWindow(pc, m_regs.cycle);
+            if (traced) {
+                record.pc = pc;
+                record.code = code;
+                record.cycle = m_regs.cycle;
+                record.memAddress = record.memValue = 0;
+                record.flags = 0;
+                record.reserved = 0;
+                if (PCSX::CPUTrace::memoryAccess(code, m_regs.GPR.r, record.memAddress, record.flags)) {
+                    if (record.flags & PCSX::CPUTrace::MEM_WRITE) {
+                        const uint32_t rt = (code >> 16) & 0x1f;
+                        record.memValue = (code >> 26) == 0x3a ? m_regs.CP2D.r[rt] : m_regs.GPR.r[rt];
+                    }
+                }
+                if (m_inISR) record.flags |= PCSX::CPUTrace::IN_ISR;
+            }
         }
 
         m_regs.pc += 4;
         m_regs.cycle += PCSX::Emulator::BIAS;
 
-        cIntFunc_t func = s_pPsxBSC[code >> 26];
-        (*this.*func)(code);
+        (*this.*(*func))(code);
+
+        if constexpr (trace) {
+            if (traced) {
+                // A load scheduled by this instruction is still pending in its
+                // delay slot, so record the value it's going to land with.
+                const auto &pending = m_delayedLoadInfo[loadSlot];
+                if (pending.active) {
+                    record.reg = pending.index;
+                    record.regValue = (m_regs.GPR.r[pending.index] & pending.mask) | pending.value;
+                } else {
+                    record.reg = PCSX::CPUTrace::immediateDestination(code);
+                    record.regValue = m_regs.GPR.r[record.reg];
+                }
+                PCSX::g_emulator->m_cpuTrace->push(record);
+            }
+        }
 
         m_currentDelayedLoad ^= 1;
         flushCurrentDelayedLoad();
@@ -1636,7 +1875,11 @@ inline void InterpretedCPU::execBlock() {
     } while (!ranDelaySlot && !debug);
 }
 
+const std::array<InterpretedCPU::execBlock_t, InterpretedCPU::EXEC_MODES> InterpretedCPU::s_execBlocks =
+    InterpretedCPU::makeExecBlocks(std::make_index_sequence<InterpretedCPU::EXEC_MODES>());
+
 void InterpretedCPU::SetPGXPMode(uint32_t pgxpMode) {
+    m_pgxpMode = pgxpMode;
     switch (pgxpMode) {
         case 0:  // PGXP_MODE_DISABLED:
             s_pPsxBSC = s_psxBSC;
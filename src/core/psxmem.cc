@@ -29,6 +29,7 @@
 #include "core/r3000a.h"
 #include "mips/common/util/encoder.hh"
 #include "support/file.h"
+#include "support/instrumentation.h"
 #include "supportpsx/binloader.h"
 
 static const std::map<uint32_t, std::string_view> s_knownBioses = {
@@ -85,18 +86,47 @@ static const std::map<uint32_t, std::string_view> s_knownBioses = {
 #endif
 };
 
+PCSX::Memory::Memory() : m_listener(g_system->m_eventBus) {
+    auto refresh = [this](const auto &) { refreshSettings(); };
+    m_listener.listen<Events::SettingsLoaded>(refresh);
+    m_listener.listen<Events::SettingsChanged>(refresh);
+}
+
+void PCSX::Memory::refreshSettings() {
+    if (!m_readLUT) return;
+    auto &settings = g_emulator->settings;
+    const bool ramExpansion = settings.get<Emulator::Setting8MB>();
+    const bool pioConnected = settings.get<Emulator::SettingPIOConnected>();
+    const bool debug = settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>();
+    if ((ramExpansion == m_busConfig.ramExpansion) && (pioConnected == m_busConfig.pioConnected) &&
+        (debug == m_busConfig.debug)) {
+        return;
+    }
+    if (pioConnected != m_busConfig.pioConnected) g_emulator->m_pioCart->setLuts();
+    setLuts();
+}
+
 int PCSX::Memory::init() {
     m_readLUT = (uint8_t **)calloc(0x10000, sizeof(void *));
     m_writeLUT = (uint8_t **)calloc(0x10000, sizeof(void *));
 
-    // Init all memory as named mappings
-    bool success = m_wramShared.init("wram", 0x00800000, true);
-    if (!success) g_system->message(_("SharedMem failed to share memory for wram, falling back to memory alloc\n"));
-    m_wram = m_wramShared.getPtr();
+    // RAM and the scratchpad come from the host mirror when it's in use, and RAM
+    // can't be shared with other processes then.
+    if (g_emulator->settings.get<Emulator::SettingFastmem>() && m_fastMem.init()) {
+        m_wram = m_fastMem.getWRAM();
+        m_hard = m_fastMem.getHard();
+    } else {
+        // Init all memory as named mappings
+        bool success = m_wramShared.init("wram", 0x00800000, true);
+        if (!success) g_system->message(_("SharedMem failed to share memory for wram, falling back to memory alloc\n"));
+        m_wram = m_wramShared.getPtr();
+        m_hard = (uint8_t *)calloc(0x00010000, 1);
+    }
 
-    m_exp1 = (uint8_t *)calloc(0x00800000, 1);
-    m_hard = (uint8_t *)calloc(0x00010000, 1);
-    m_bios = (uint8_t *)calloc(0x00080000, 1);
+    m_exp1Mem.init(nullptr, 0x00800000, true);
+    m_exp1 = m_exp1Mem.getPtr();
+    m_biosMem.init(nullptr, 0x00080000, true);
+    m_bios = m_biosMem.getPtr();
 
     if (m_readLUT == NULL || m_writeLUT == NULL || m_wram == NULL || m_exp1 == NULL || m_bios == NULL ||
         m_hard == NULL) {
@@ -125,7 +155,7 @@ int PCSX::Memory::init() {
 }
 
 bool PCSX::Memory::loadEXP1FromFile(std::filesystem::path rom_path) {
-    const size_t exp1_size = 0x00040000;
+    const size_t exp1_size = EXP1_ROM_SIZE;
     bool result = false;
 
     auto &exp1Path = rom_path;
@@ -151,14 +181,15 @@ bool PCSX::Memory::loadEXP1FromFile(std::filesystem::path rom_path) {
 
     if (result) {
         g_emulator->settings.get<Emulator::SettingEXP1Filepath>().value = rom_path;
+        m_exp1Mem.shareContent("exp1", exp1_size);
     }
 
     return result;
 }
 
 void PCSX::Memory::reset() {
-    const uint32_t bios_size = 0x00080000;
-    const uint32_t exp1_size = 0x00040000;
+    const uint32_t bios_size = BIOS_SIZE;
+    const uint32_t exp1_size = EXP1_ROM_SIZE;
     memset(m_wram, 0, 0x00800000);
     memset(m_exp1, 0xff, exp1_size);
     memset(m_bios, 0, bios_size);
@@ -230,6 +261,8 @@ The distributed OpenBIOS.bin file can be an appropriate BIOS replacement.
         loadEXP1FromFile(g_emulator->settings.get<Emulator::SettingEXP1Filepath>().value);
     }
 
+    shareROMs();
+
     uint32_t crc = crc32(0L, Z_NULL, 0);
     m_biosCRC = crc = crc32(crc, m_bios, bios_size);
     auto it = s_knownBioses.find(crc);
@@ -243,10 +276,13 @@ The distributed OpenBIOS.bin file can be an appropriate BIOS replacement.
     m_BIU = 0;
 }
 
+void PCSX::Memory::shareROMs() {
+    m_biosMem.shareContent("bios", BIOS_SIZE);
+    m_exp1Mem.shareContent("exp1", EXP1_ROM_SIZE);
+}
+
 void PCSX::Memory::shutdown() {
-    free(m_exp1);
-    free(m_hard);
-    free(m_bios);
+    if (!m_fastMem.enabled()) free(m_hard);
 
     free(m_readLUT);
     free(m_writeLUT);
@@ -256,7 +292,6 @@ uint8_t PCSX::Memory::read8(uint32_t address) {
     g_emulator->m_cpu->m_regs.cycle += 1;
     const uint32_t page = address >> 16;
     const auto pointer = (uint8_t *)m_readLUT[page];
-    const bool pioConnected = g_emulator->settings.get<Emulator::SettingPIOConnected>().value;
 
     if (pointer != nullptr) {
         const uint32_t offset = address & 0xffff;
@@ -267,7 +302,7 @@ uint8_t PCSX::Memory::read8(uint32_t address) {
         } else {
             return g_emulator->m_hw->read8(address);
         }
-    } else if ((page & 0x1fff) >= 0x1f00 && (page & 0x1fff) < 0x1f80 && pioConnected) {
+    } else if ((page & 0x1fff) >= 0x1f00 && (page & 0x1fff) < 0x1f80 && m_busConfig.pioConnected) {
         return g_emulator->m_pioCart->read8(address);
     } else if (sendReadToLua(address, 1)) {
         auto L = *g_emulator->m_lua;
@@ -281,7 +316,7 @@ uint8_t PCSX::Memory::read8(uint32_t address) {
         return 0xff;
     } else if (isiCacheEnabled()) {
         g_system->log(LogClass::CPU, _("8-bit read from unknown address: %8.8lx\n"), address);
-        if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>()) {
+        if (m_busConfig.debug) {
             g_system->pause();
         }
     }
@@ -292,7 +327,6 @@ uint16_t PCSX::Memory::read16(uint32_t address) {
     g_emulator->m_cpu->m_regs.cycle += 1;
     const uint32_t page = address >> 16;
     const auto pointer = (uint8_t *)m_readLUT[page];
-    const bool pioConnected = g_emulator->settings.get<Emulator::SettingPIOConnected>().value;
 
     if (pointer != nullptr) {
         const uint32_t offset = address & 0xffff;
@@ -304,7 +338,7 @@ uint16_t PCSX::Memory::read16(uint32_t address) {
         } else {
             return g_emulator->m_hw->read16(address);
         }
-    } else if ((page & 0x1fff) >= 0x1f00 && (page & 0x1fff) < 0x1f80 && pioConnected) {
+    } else if ((page & 0x1fff) >= 0x1f00 && (page & 0x1fff) < 0x1f80 && m_busConfig.pioConnected) {
         return g_emulator->m_pioCart->read8(address);
     } else if (sendReadToLua(address, 2)) {
         auto L = *g_emulator->m_lua;
@@ -314,7 +348,7 @@ uint16_t PCSX::Memory::read16(uint32_t address) {
         return ret;
     } else if (isiCacheEnabled()) {
         g_system->log(LogClass::CPU, _("16-bit read from unknown address: %8.8lx\n"), address);
-        if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>()) {
+        if (m_busConfig.debug) {
             g_system->pause();
         }
     }
@@ -325,7 +359,6 @@ uint32_t PCSX::Memory::read32(uint32_t address, ReadType readType) {
     if (readType == ReadType::Data) g_emulator->m_cpu->m_regs.cycle += 1;
     const uint32_t page = address >> 16;
     const auto pointer = (uint8_t *)m_readLUT[page];
-    const bool pioConnected = g_emulator->settings.get<Emulator::SettingPIOConnected>().value;
 
     if (pointer != nullptr) {
         const uint32_t offset = address & 0xffff;
@@ -337,7 +370,7 @@ uint32_t PCSX::Memory::read32(uint32_t address, ReadType readType) {
         } else {
             return g_emulator->m_hw->read32(address);
         }
-    } else if ((page & 0x1fff) >= 0x1f00 && (page & 0x1fff) < 0x1f80 && pioConnected) {
+    } else if ((page & 0x1fff) >= 0x1f00 && (page & 0x1fff) < 0x1f80 && m_busConfig.pioConnected) {
         return g_emulator->m_pioCart->read32(address);
     } else if (address == 0xfffe0130) {
         return m_BIU;
@@ -349,7 +382,7 @@ uint32_t PCSX::Memory::read32(uint32_t address, ReadType readType) {
         return ret;
     } else if (isiCacheEnabled()) {
         g_system->log(LogClass::CPU, _("32-bit read from unknown address: %8.8lx\n"), address);
-        if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>()) {
+        if (m_busConfig.debug) {
             g_system->pause();
         }
     }
@@ -371,6 +404,7 @@ int PCSX::Memory::sendReadToLua(const uint32_t address, const size_t size) {
             const int top = L.gettop();
             L.push(lua_Number(address));
             L.push(lua_Number(size));
+            PCSX_INSTRUMENT(Lua);
             nresult = L.pcall(2);
             // Discard anything more than 1 result
             for (int n = 1; n < nresult; n++) {
@@ -406,6 +440,7 @@ bool PCSX::Memory::sendWriteToLua(const uint32_t address, const size_t size, uin
             L.push(lua_Number(address));
             L.push(lua_Number(size));
             L.push(lua_Number(value));
+            PCSX_INSTRUMENT(Lua);
             int nresult = L.pcall(3);
 
             if (nresult > 0) {
@@ -434,7 +469,6 @@ void PCSX::Memory::write8(uint32_t address, uint32_t value) {
     g_emulator->m_cpu->m_regs.cycle += 1;
     const uint32_t page = address >> 16;
     const auto pointer = (uint8_t *)m_writeLUT[page];
-    const bool pioConnected = g_emulator->settings.get<Emulator::SettingPIOConnected>().value;
 
     if (pointer != nullptr) {
         const uint32_t offset = address & 0xffff;
@@ -446,14 +480,14 @@ void PCSX::Memory::write8(uint32_t address, uint32_t value) {
         } else {
             g_emulator->m_hw->write8(address, value);
         }
-    } else if ((page & 0x1fff) >= 0x1f00 && (page & 0x1fff) < 0x1f80 && pioConnected) {
+    } else if ((page & 0x1fff) >= 0x1f00 && (page & 0x1fff) < 0x1f80 && m_busConfig.pioConnected) {
         g_emulator->m_pioCart->write8(address, value);
     } else if (sendWriteToLua(address, 1, value)) {
         g_system->log(LogClass::HARDWARE, _("8-bit write redirected to Lua for address: %8.8lx\n"), address);
     } else if (isiCacheEnabled()) {
         g_emulator->m_cpu->Clear(address, 1);
         g_system->log(LogClass::CPU, _("8-bit write to unknown address: %8.8lx\n"), address);
-        if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>()) {
+        if (m_busConfig.debug) {
             g_system->pause();
         }
     }
@@ -463,7 +497,6 @@ void PCSX::Memory::write16(uint32_t address, uint32_t value) {
     g_emulator->m_cpu->m_regs.cycle += 1;
     const uint32_t page = address >> 16;
     const auto pointer = (uint8_t *)m_writeLUT[page];
-    const bool pioConnected = g_emulator->settings.get<Emulator::SettingPIOConnected>().value;
 
     if (pointer != nullptr) {
         const uint32_t offset = address & 0xffff;
@@ -476,14 +509,14 @@ void PCSX::Memory::write16(uint32_t address, uint32_t value) {
         } else {
             g_emulator->m_hw->write16(address, value);
         }
-    } else if ((page & 0x1fff) >= 0x1f00 && (page & 0x1fff) < 0x1f80 && pioConnected) {
+    } else if ((page & 0x1fff) >= 0x1f00 && (page & 0x1fff) < 0x1f80 && m_busConfig.pioConnected) {
         g_emulator->m_pioCart->write16(address, value);
     } else if (sendWriteToLua(address, 2, value)) {
         g_system->log(LogClass::HARDWARE, _("16-bit write redirected to Lua for address: %8.8lx\n"), address);
     } else if (isiCacheEnabled()) {
         g_emulator->m_cpu->Clear(address, 1);
         g_system->log(LogClass::CPU, _("16-bit write to unknown address: %8.8lx\n"), address);
-        if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>()) {
+        if (m_busConfig.debug) {
             g_system->pause();
         }
     }
@@ -493,7 +526,6 @@ void PCSX::Memory::write32(uint32_t address, uint32_t value) {
     g_emulator->m_cpu->m_regs.cycle += 1;
     const uint32_t page = address >> 16;
     const auto pointer = (uint8_t *)m_writeLUT[page];
-    const bool pioConnected = g_emulator->settings.get<Emulator::SettingPIOConnected>().value;
 
     if (pointer != nullptr) {
         const uint32_t offset = address & 0xffff;
@@ -506,7 +538,7 @@ void PCSX::Memory::write32(uint32_t address, uint32_t value) {
         } else {
             g_emulator->m_hw->write32(address, value);
         }
-    } else if ((page & 0x1fff) >= 0x1f00 && (page & 0x1fff) < 0x1f80 && pioConnected) {
+    } else if ((page & 0x1fff) >= 0x1f00 && (page & 0x1fff) < 0x1f80 && m_busConfig.pioConnected) {
         g_emulator->m_pioCart->write32(address, value);
     } else if (address == 0xfffe0130) {
         m_BIU = value;
@@ -521,7 +553,7 @@ void PCSX::Memory::write32(uint32_t address, uint32_t value) {
                 break;
             default:
                 g_system->log(LogClass::CPU, _("Unknown BIU value: %8.8lx\n"), value);
-                if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>()) {
+                if (m_busConfig.debug) {
                     g_system->pause();
                 }
                 break;
@@ -531,7 +563,7 @@ void PCSX::Memory::write32(uint32_t address, uint32_t value) {
     } else if (isiCacheEnabled()) {
         g_emulator->m_cpu->Clear(address, 1);
         g_system->log(LogClass::CPU, _("32-bit write to unknown address: %8.8lx\n"), address);
-        if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>()) {
+        if (m_busConfig.debug) {
             g_system->pause();
         }
     }
@@ -635,6 +667,22 @@ void PCSX::Memory::setLuts() {
         memset(m_writeLUT + 0x8000, 0, 0x80 * sizeof(void *));
         memset(m_writeLUT + 0xa000, 0, 0x80 * sizeof(void *));
     }
+
+    const uint32_t ramSize = max << 16;
+    const bool pioConnected = g_emulator->settings.get<Emulator::SettingPIOConnected>().value;
+    // Cache isolation doesn't change the version: the dynarecs check ramWritable
+    // at runtime before storing straight to RAM, as it happens on each FlushCache.
+    if ((ramSize != m_busConfig.ramSize) || (pioConnected != m_busConfig.pioConnected)) {
+        m_busConfig.version++;
+    }
+    m_busConfig.ramSize = ramSize;
+    m_busConfig.ramExpansion = g_emulator->settings.get<Emulator::Setting8MB>();
+    m_busConfig.pioConnected = pioConnected;
+    m_busConfig.debug =
+        g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>();
+    m_busConfig.ramWritable = isiCacheEnabled();
+
+    m_fastMem.setLayout(m_busConfig.ramSize, m_busConfig.ramWritable);
     g_system->m_eventBus->signal(PCSX::Events::Memory::SetLuts{});
 }
 
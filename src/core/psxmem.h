@@ -22,7 +22,9 @@
 #include <string_view>
 #include <vector>
 
+#include "core/fastmem.h"
 #include "core/psxemulator.h"
+#include "support/eventbus.h"
 #include "support/sharedmem.h"
 
 #if defined(__BIGENDIAN__)
@@ -46,6 +48,7 @@ namespace PCSX {
 
 class Memory {
   public:
+    Memory();
     int init();
     void reset();
     void shutdown();
@@ -73,6 +76,10 @@ class Memory {
     static constexpr uint16_t DMA_PCR = 0x10f0;
     static constexpr uint16_t DMA_ICR = 0x10f4;
 
+    // How much of the BIOS and EXP1 regions get loaded from ROM files.
+    static constexpr uint32_t BIOS_SIZE = 0x00080000;
+    static constexpr uint32_t EXP1_ROM_SIZE = 0x00040000;
+
     template <unsigned n>
     void dmaInterrupt() {
         uint32_t icr = readHardwareRegister<DMA_ICR>();
@@ -225,6 +232,41 @@ class Memory {
 
     bool isiCacheEnabled() { return m_BIU == 0x1e988; }
 
+    // Swaps main RAM or EXP1 for a copy-on-write view of an opened file, at a
+    // page aligned offset. Returns false if the region can't be remapped, which
+    // is the case when RAM is shared with other processes, or comes from the
+    // fastmem mirror; the caller then needs to copy the data in itself. The
+    // caller is responsible for invalidating any cached code afterwards.
+    bool isWRAMShared() const { return m_wramShared.isShared(); }
+    bool mapWRAM(int fd, uint64_t offset) { return m_wramShared.mapFilePrivate(fd, offset); }
+    bool mapEXP1(int fd, uint64_t offset) { return m_exp1Mem.mapFilePrivate(fd, offset); }
+
+    // Swaps the BIOS and EXP1 ROM for copy-on-write pages shared between all
+    // the processes which loaded the same content. To be called once they've
+    // been written to, as writes give a process its own copy of a page.
+    void shareROMs();
+
+    // The host mirror of the guest address space, when enabled. See FastMem.
+    FastMem &getFastMem() { return m_fastMem; }
+
+    // The settings decoding accesses depends on, so that the accessors and
+    // DMA don't go through the settings tree each time. Rebuilt by setLuts(),
+    // which happens on its own when settings get loaded or written from Lua,
+    // and which the UI calls when toggling them. The version only changes
+    // along with what code compiled against the LUTs may have resolved: the
+    // decoded RAM size and the PIO cart mapping. Cache isolation is left out,
+    // as the BIOS toggles it on each FlushCache; code writing straight to RAM
+    // checks ramWritable instead.
+    struct BusConfig {
+        uint32_t version = 0;
+        uint32_t ramSize = 0x00200000;  // As currently decoded, 2MB or 8MB
+        bool ramExpansion = false;      // The 8MB setting itself, which DMA and the debugger follow
+        bool pioConnected = false;
+        bool debug = false;
+        bool ramWritable = true;  // False while the cache is isolated
+    };
+    const BusConfig &getBusConfig() const { return m_busConfig; }
+
   private:
     friend class MemoryAsFile;
     IO<MemoryAsFile> m_memoryAsFile;
@@ -233,6 +275,12 @@ class Memory {
 
     // Shared memory wrappers, pointers below point to these where appropriate
     SharedMem m_wramShared;
+    SharedMem m_exp1Mem;
+    SharedMem m_biosMem;
+    FastMem m_fastMem;
+    BusConfig m_busConfig;
+    EventBus::Listener m_listener;
+    void refreshSettings();
 
     uint32_t m_BIU = 0;
 
@@ -29,11 +29,13 @@
 #include "core/gte.h"
 #include "core/mdec.h"
 #include "core/pgxp_mem.h"
+#include "core/sampling-profiler.h"
 #include "core/sio.h"
 #include "core/sio1.h"
 #include "core/spu.h"
 #include "fmt/format.h"
 #include "magic_enum/include/magic_enum/magic_enum_all.hpp"
+#include "support/instrumentation.h"
 
 int PCSX::R3000Acpu::psxInit() {
     g_system->printf(_("PCSX-Redux booting\n"));
@@ -79,6 +81,11 @@ void PCSX::R3000Acpu::psxReset() {
 
 void PCSX::R3000Acpu::psxShutdown() { Shutdown(); }
 
+PCSX::R3000Acpu::~R3000Acpu() {
+    m_pcdrvFiles.destroyAll();
+    if (m_ownsCodeCache) Cpus::releaseCodeCache();
+}
+
 void PCSX::R3000Acpu::exception(uint32_t code, bool bd, bool cop0) {
     auto& emuSettings = g_emulator->settings;
     auto& debugSettings = emuSettings.get<Emulator::SettingDebugSettings>();
@@ -352,9 +359,13 @@ void PCSX::R3000Acpu::branchTest() {
 
     const uint32_t cycle = m_regs.cycle;
 
+    g_emulator->m_samplingProfiler->maybeSample(cycle, m_regs.pc);
     if (cycle >= g_emulator->m_counters->m_psxNextCounter) g_emulator->m_counters->update();
 
-    if (m_regs.spuInterrupt.exchange(false)) g_emulator->m_spu->interrupt();
+    if (m_regs.spuInterrupt.exchange(false)) {
+        PCSX_INSTRUMENT(SPU);
+        g_emulator->m_spu->interrupt();
+    }
 
     const uint32_t interrupts = m_regs.interrupt;
 
@@ -363,7 +374,7 @@ void PCSX::R3000Acpu::branchTest() {
     uint32_t* targets = m_regs.intTargets;
 
     if ((interrupts != 0) && (((int32_t)(m_regs.lowestTarget - cycle)) <= 0)) {
-#define checkAndUpdate(irq, act)                                                          \
+#define checkAndUpdate(irq, scope, act)                                                   \
     {                                                                                     \
         constexpr uint32_t mask = 1 << irq;                                               \
         if ((interrupts & mask) != 0) {                                                   \
@@ -377,23 +388,24 @@ void PCSX::R3000Acpu::branchTest() {
             } else {                                                                      \
                 m_regs.interrupt &= ~mask;                                                \
                 PSXIRQ_LOG("Triggering interrupt %08x\n", magic_enum::enum_integer(irq)); \
+                PCSX_INSTRUMENT(scope);                                                   \
                 act();                                                                    \
             }                                                                             \
         }                                                                                 \
     }
-        checkAndUpdate(PSXINT_SIO, g_emulator->m_sio->interrupt);
-        checkAndUpdate(PSXINT_SIO1, g_emulator->m_sio1->interrupt);
-        checkAndUpdate(PSXINT_CDR, g_emulator->m_cdrom->interrupt);
-        checkAndUpdate(PSXINT_CDREAD, g_emulator->m_cdrom->readInterrupt);
-        checkAndUpdate(PSXINT_GPUDMA, GPU::gpuInterrupt);
-        checkAndUpdate(PSXINT_MDECOUTDMA, g_emulator->m_mdec->mdec1Interrupt);
-        checkAndUpdate(PSXINT_SPUDMA, spuInterrupt);
-        checkAndUpdate(PSXINT_MDECINDMA, g_emulator->m_mdec->mdec0Interrupt);
-        checkAndUpdate(PSXINT_GPUOTCDMA, gpuotcInterrupt);
-        checkAndUpdate(PSXINT_CDRDMA, g_emulator->m_cdrom->dmaInterrupt);
-        checkAndUpdate(PSXINT_CDRPLAY, g_emulator->m_cdrom->playInterrupt);
-        checkAndUpdate(PSXINT_CDRDBUF, g_emulator->m_cdrom->decodedBufferInterrupt);
-        checkAndUpdate(PSXINT_CDRLID, g_emulator->m_cdrom->lidSeekInterrupt);
+        checkAndUpdate(PSXINT_SIO, SIO, g_emulator->m_sio->interrupt);
+        checkAndUpdate(PSXINT_SIO1, SIO, g_emulator->m_sio1->interrupt);
+        checkAndUpdate(PSXINT_CDR, CDROM, g_emulator->m_cdrom->interrupt);
+        checkAndUpdate(PSXINT_CDREAD, CDROM, g_emulator->m_cdrom->readInterrupt);
+        checkAndUpdate(PSXINT_GPUDMA, GPU, GPU::gpuInterrupt);
+        checkAndUpdate(PSXINT_MDECOUTDMA, MDEC, g_emulator->m_mdec->mdec1Interrupt);
+        checkAndUpdate(PSXINT_SPUDMA, SPU, spuInterrupt);
+        checkAndUpdate(PSXINT_MDECINDMA, MDEC, g_emulator->m_mdec->mdec0Interrupt);
+        checkAndUpdate(PSXINT_GPUOTCDMA, GPU, gpuotcInterrupt);
+        checkAndUpdate(PSXINT_CDRDMA, CDROM, g_emulator->m_cdrom->dmaInterrupt);
+        checkAndUpdate(PSXINT_CDRPLAY, CDROM, g_emulator->m_cdrom->playInterrupt);
+        checkAndUpdate(PSXINT_CDRDBUF, CDROM, g_emulator->m_cdrom->decodedBufferInterrupt);
+        checkAndUpdate(PSXINT_CDRLID, CDROM, g_emulator->m_cdrom->lidSeekInterrupt);
         m_regs.lowestTarget = lowestTarget;
     }
     auto& mem = g_emulator->m_mem;
@@ -426,9 +438,26 @@ std::unique_ptr<PCSX::R3000Acpu> PCSX::Cpus::Interpreted() {
     return nullptr;
 }
 
+// The dynarecs emit their code, helpers included, into a single static code
+// cache, as it has to sit close enough to the executable for rip-relative
+// accesses. Only one emulator per process can therefore run a dynarec at a
+// time, and the other ones fall back to the interpreter.
+static std::atomic<bool> s_codeCacheInUse = false;
+
+void PCSX::Cpus::releaseCodeCache() { s_codeCacheInUse.store(false); }
+
 std::unique_ptr<PCSX::R3000Acpu> PCSX::Cpus::DynaRec() {
+    bool expected = false;
+    if (!s_codeCacheInUse.compare_exchange_strong(expected, true)) {
+        g_system->printf(_("Another emulator instance is using the dynarec, falling back to the interpreter\n"));
+        return nullptr;
+    }
     std::unique_ptr<PCSX::R3000Acpu> cpu = getDynaRec();
-    if (cpu->Implemented()) return cpu;
+    if (cpu->Implemented()) {
+        cpu->m_ownsCodeCache = true;
+        return cpu;
+    }
+    releaseCodeCache();
     return nullptr;
 }
 
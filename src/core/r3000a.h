@@ -270,7 +270,7 @@ struct psxRegisters {
 
 class R3000Acpu {
   public:
-    virtual ~R3000Acpu() { m_pcdrvFiles.destroyAll(); };
+    virtual ~R3000Acpu();
     R3000Acpu() {
         for (unsigned i = 0; i < 65536; i++) {
             m_availableFDs.push_back(i);
@@ -507,6 +507,9 @@ Formula One 2001
 
   private:
     const std::string m_name;
+    // Set on the dynarec holding the process' code cache; see Cpus::DynaRec.
+    bool m_ownsCodeCache = false;
+    friend class Cpus;
 
     struct PCdrvFile;
     typedef Intrusive::HashTable<uint32_t, PCdrvFile> PCdrvFiles;
@@ -547,6 +550,7 @@ class Cpus {
     static std::unique_ptr<R3000Acpu> DynaRec();
 
   private:
+    static void releaseCodeCache();
     static std::unique_ptr<R3000Acpu> getDynaRec();
     static std::unique_ptr<R3000Acpu> getInterpreted();
 };
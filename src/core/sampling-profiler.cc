@@ -0,0 +1,146 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/sampling-profiler.h"
+
+#include <string.h>
+
+#include "core/callstacks.h"
+#include "core/psxemulator.h"
+#include "core/r3000a.h"
+#include "fmt/format.h"
+
+void PCSX::SamplingProfiler::start(uint32_t period) {
+    m_period = period ? period : c_defaultPeriod;
+    m_nextSample = g_emulator->m_cpu->m_regs.cycle + m_period;
+    m_running = true;
+}
+
+void PCSX::SamplingProfiler::clear() {
+    if (!m_table) return;
+    for (size_t i = 0; i < c_tableSize; i++) {
+        m_table[i].hash.store(0, std::memory_order_relaxed);
+        m_table[i].count.store(0, std::memory_order_relaxed);
+    }
+    m_used = 0;
+    m_samples.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+}
+
+void PCSX::SamplingProfiler::sample(uint32_t pc) {
+    uint32_t frames[c_maxDepth];
+    unsigned depth = 0;
+    auto push = [&frames, &depth](uint32_t address) {
+        // Keep the innermost frames when the stack is too deep.
+        if (depth == (c_maxDepth - 1)) {
+            memmove(frames, frames + 1, (depth - 1) * sizeof(uint32_t));
+            depth--;
+        }
+        frames[depth++] = address;
+    };
+
+    auto& cpu = g_emulator->m_cpu;
+    auto& callstacks = g_emulator->m_callStacks;
+    // Only the interpreter maintains the shadow call stacks. Otherwise, $ra is
+    // the best guess we have about the caller; in functions which already made
+    // a call, it points inside the function itself, and gets merged away later.
+    if (!cpu->isDynarec() && callstacks->hasCurrent()) {
+        const auto& current = callstacks->getCurrent();
+        for (auto& call : current.calls) push(call.ra);
+        if (current.ra) push(current.ra);
+    } else if (cpu->m_regs.GPR.n.ra) {
+        push(cpu->m_regs.GPR.n.ra);
+    }
+    frames[depth++] = pc;
+    record(frames, depth);
+}
+
+void PCSX::SamplingProfiler::record(const uint32_t* frames, unsigned depth) {
+    if (depth > c_maxDepth) {
+        frames += depth - c_maxDepth;
+        depth = c_maxDepth;
+    }
+    // Only allocated the first time around, as most sessions never profile anything.
+    if (!m_table) m_table.reset(new Entry[c_tableSize]);
+    m_samples.fetch_add(1, std::memory_order_relaxed);
+
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned i = 0; i < depth; i++) {
+        hash ^= frames[i];
+        hash *= 0x100000001b3ULL;
+    }
+    if (hash == 0) hash = 1;
+
+    for (size_t probe = 0; probe < c_tableSize; probe++) {
+        auto& entry = m_table[(hash + probe) & (c_tableSize - 1)];
+        const uint64_t slotHash = entry.hash.load(std::memory_order_relaxed);
+        if (slotHash == 0) {
+            // Past three quarters, probe sequences get too long to be worth it.
+            if (m_used >= (c_tableSize / 4 * 3)) break;
+            entry.depth = depth;
+            memcpy(entry.frames, frames, depth * sizeof(uint32_t));
+            entry.count.store(1, std::memory_order_relaxed);
+            entry.hash.store(hash, std::memory_order_release);
+            m_used++;
+            return;
+        }
+        if ((slotHash == hash) && (entry.depth == depth) &&
+            (memcmp(entry.frames, frames, depth * sizeof(uint32_t)) == 0)) {
+            entry.count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+namespace {
+
+std::string symbolize(uint32_t address, const std::map<uint32_t, std::string>& symbols) {
+    auto symbol = symbols.upper_bound(address);
+    if (symbol == symbols.begin()) return fmt::format("0x{:08x}", address);
+    --symbol;
+    std::string name = symbol->second;
+    // The collapsed format uses these as separators.
+    for (auto& c : name) {
+        if (c == ';') c = ':';
+        if (c == ' ') c = '_';
+    }
+    return name;
+}
+
+}  // namespace
+
+void PCSX::SamplingProfiler::writeCollapsed(std::ostream& out, const std::map<uint32_t, std::string>& symbols) const {
+    if (!m_table) return;
+    for (size_t i = 0; i < c_tableSize; i++) {
+        const auto& entry = m_table[i];
+        if (entry.hash.load(std::memory_order_acquire) == 0) continue;
+        std::string line;
+        std::string previous;
+        for (unsigned f = 0; f < entry.depth; f++) {
+            std::string name = symbolize(entry.frames[f], symbols);
+            if (name == previous) continue;
+            if (!line.empty()) line += ';';
+            line += name;
+            previous = std::move(name);
+        }
+        out << line << ' ' << entry.count.load(std::memory_order_relaxed) << '\n';
+    }
+}
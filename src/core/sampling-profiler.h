@@ -0,0 +1,93 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace PCSX {
+
+// Statistical profiler for guest code. Every so many emulated cycles, the CPU
+// hands its PC over from branchTest(), which every CPU core calls on its own,
+// and the profiler records it along with the callers it knows about. Since the
+// period is counted in emulated cycles, the guest can't tell the profiler is
+// there, and profiling the same code twice yields the same samples.
+//
+// Identical stacks are aggregated in a fixed size open addressing table, which
+// the emulation thread fills without locking, and which can be walked while
+// samples keep coming in. Starting, stopping and clearing is up to the
+// emulation thread.
+class SamplingProfiler {
+  public:
+    static constexpr unsigned c_maxDepth = 32;
+    // About 1kHz of emulated time.
+    static constexpr uint32_t c_defaultPeriod = 33868800 / 1000;
+
+    void start(uint32_t period = c_defaultPeriod);
+    void stop() { m_running = false; }
+    void clear();
+    bool running() const { return m_running; }
+
+    void maybeSample(uint32_t cycle, uint32_t pc) {
+        if (!m_running || (static_cast<int32_t>(cycle - m_nextSample) < 0)) return;
+        m_nextSample = cycle + m_period;
+        sample(pc);
+    }
+
+    // Adds one sample for this stack, outermost caller first, and the sampled pc last.
+    void record(const uint32_t* frames, unsigned depth);
+
+    uint64_t samples() const { return m_samples.load(std::memory_order_relaxed); }
+    // Samples which didn't fit in the table.
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // Writes one line per distinct stack, in the collapsed format flame graph
+    // tools consume: "outer;caller;function count". Addresses are resolved to
+    // the closest symbol at or before them, and consecutive frames landing in
+    // the same function are merged, as return addresses point inside their caller.
+    void writeCollapsed(std::ostream& out, const std::map<uint32_t, std::string>& symbols) const;
+
+  private:
+    static constexpr size_t c_tableSize = 1 << 14;
+    struct Entry {
+        // 0 means the slot is free; written last, so readers never see a partial stack.
+        std::atomic<uint64_t> hash = 0;
+        std::atomic<uint64_t> count = 0;
+        uint32_t depth = 0;
+        uint32_t frames[c_maxDepth];
+    };
+
+    void sample(uint32_t pc);
+
+    std::unique_ptr<Entry[]> m_table;
+    std::atomic<uint64_t> m_samples = 0;
+    std::atomic<uint64_t> m_dropped = 0;
+    size_t m_used = 0;
+    uint32_t m_period = c_defaultPeriod;
+    uint32_t m_nextSample = 0;
+    bool m_running = false;
+};
+
+}  // namespace PCSX
@@ -646,6 +646,20 @@ void PCSX::SIO::saveMcd(int mcd) {
     }
 }
 
+void PCSX::SIO::commitMcds() {
+    if (m_memoryCard[0].dataChanged()) {
+        m_memoryCard[0].commit(g_emulator->settings.get<Emulator::SettingMcd1>().string().c_str());
+    }
+    if (m_memoryCard[1].dataChanged()) {
+        m_memoryCard[1].commit(g_emulator->settings.get<Emulator::SettingMcd2>().string().c_str());
+    }
+}
+
+void PCSX::SIO::flushMcds() {
+    m_memoryCard[0].flush(g_emulator->settings.get<Emulator::SettingMcd1>().string().c_str(), true);
+    m_memoryCard[1].flush(g_emulator->settings.get<Emulator::SettingMcd2>().string().c_str(), true);
+}
+
 void PCSX::SIO::togglePocketstationMode() {
     if (PCSX::g_emulator->settings.get<PCSX::Emulator::SettingMcd1Pocketstation>()) {
         m_memoryCard[0].enablePocketstation();
@@ -117,6 +117,10 @@ class SIO {
         m_memoryCard[1].loadMcd(mcd2);
     }
     void saveMcd(int mcd);
+    // Persists the pending memory card writes once their coalescing window
+    // has elapsed; flushMcds forces them out and waits for completion.
+    void commitMcds();
+    void flushMcds();
     static constexpr int otherMcd(int mcd) {
         if ((mcd != 1) && (mcd != 2)) throw std::runtime_error("Bad memory card number");
         if (mcd == 1) return 2;
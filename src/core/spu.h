@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "core/decode_xa.h"
 #include "core/psxemulator.h"
 #include "core/psxmem.h"
@@ -57,8 +59,9 @@ class SPUInterface {
     virtual void save(SaveStates::SPU &) = 0;
     virtual void load(const SaveStates::SPU &) = 0;
     virtual uint32_t getCurrentFrames() = 0;
-    virtual void waitForGoal(uint32_t goal) = 0;
+    virtual bool waitForGoal(uint32_t goal, std::chrono::microseconds maxWait) = 0;
     virtual uint32_t getFrameCount() = 0;
+    virtual uint32_t getBufferFill() = 0;
     virtual void setLua(Lua L) = 0;
 
     bool m_showDebug = false;
@@ -19,6 +19,16 @@
 
 #include "core/sstate.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "core/callstacks.h"
 #include "core/cdrom.h"
 #include "core/gpu.h"
@@ -29,8 +39,10 @@
 #include "core/r3000a.h"
 #include "core/sio.h"
 #include "spu/interface.h"
+#include "support/file.h"
+#include "support/zfile.h"
 
-PCSX::SaveStates::SaveState PCSX::SaveStates::constructSaveState() {
+PCSX::SaveStates::SaveState PCSX::SaveStates::constructSaveState(bool withMemory) {
     // clang-format off
     return SaveState {
         SaveStateInfo {
@@ -39,10 +51,10 @@ PCSX::SaveStates::SaveState PCSX::SaveStates::constructSaveState() {
         },
         Thumbnail {},
         Memory {
-            RAM { g_emulator->m_mem->m_wram },
-            ROM { g_emulator->m_mem->m_bios },
-            EXP1 { g_emulator->m_mem->m_exp1 },
-            HardwareMemory { g_emulator->m_mem->m_hard },
+            RAM { withMemory ? g_emulator->m_mem->m_wram : nullptr },
+            ROM { withMemory ? g_emulator->m_mem->m_bios : nullptr },
+            EXP1 { withMemory ? g_emulator->m_mem->m_exp1 : nullptr },
+            HardwareMemory { withMemory ? g_emulator->m_mem->m_hard : nullptr },
         },
         Registers {
             GPR { g_emulator->m_cpu->m_regs.GPR.r },
@@ -161,6 +173,7 @@ PCSX::SaveStates::SaveState PCSX::SaveStates::constructSaveState() {
             CDSubQAbsolute { g_emulator->m_cdrom->m_subq.absolute },
             CDTrackChanged { g_emulator->m_cdrom->m_trackChanged },
             CDLocationChanged { g_emulator->m_cdrom->m_locationChanged },
+            CDAcceleratedRead { g_emulator->m_cdrom->m_acceleratedRead },
         },
         Hardware {},
         Counters {},
@@ -178,8 +191,11 @@ struct SaveStateWrapper {
 };
 }  // namespace PCSX
 
-std::string PCSX::SaveStates::save() {
-    SaveState state = constructSaveState();
+namespace {
+
+void fillSaveState(PCSX::SaveStates::SaveState& state) {
+    using namespace PCSX;
+    using namespace PCSX::SaveStates;
     SaveStateWrapper wrapper(state);
 
     state.get<SaveStateInfoField>().get<VersionString>().value = "PCSX-Redux SaveState v3";
@@ -196,12 +212,126 @@ std::string PCSX::SaveStates::save() {
     });
 
     g_emulator->m_callStacks->serialize(&wrapper);
+}
+
+// Copies of the big memory regions taken by saveAsync. They are recycled
+// instead of freed, so that frequent autosaves don't keep faulting in 17MB
+// worth of fresh pages.
+struct MemorySnapshot {
+    uint8_t ram[0x00800000];
+    uint8_t rom[0x00080000];
+    uint8_t exp1[0x00800000];
+    uint8_t hardware[0x00010000];
+};
+
+// Snapshots are released from the thread pool, so each save job keeps a
+// reference to the pool of the emulator it came from.
+class MemorySnapshotPool {
+  public:
+    std::unique_ptr<MemorySnapshot> acquire() {
+        std::unique_lock lock(m_mutex);
+        if (m_pool.empty()) return std::make_unique<MemorySnapshot>();
+        auto ret = std::move(m_pool.back());
+        m_pool.pop_back();
+        return ret;
+    }
+    void release(std::unique_ptr<MemorySnapshot>&& snapshot) {
+        std::unique_lock lock(m_mutex);
+        if (m_pool.size() < c_maxPooled) m_pool.push_back(std::move(snapshot));
+    }
+
+  private:
+    static constexpr size_t c_maxPooled = 2;
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<MemorySnapshot>> m_pool;
+};
+
+struct AsyncSave {
+    uv_work_t req;
+    std::filesystem::path filename;
+    std::string state;
+    std::shared_ptr<MemorySnapshotPool> pool;
+    std::unique_ptr<MemorySnapshot> memory;
+    std::shared_future<void> previous;
+    std::promise<void> done;
+    bool success = false;
+
+    void work() {
+        using namespace PCSX::SaveStates;
+        // The memory field goes after everything else in the file. Field order
+        // doesn't matter to protobuf decoders, including ours.
+        PCSX::Protobuf::OutSlice slice;
+        slice.putVarInt((MemoryField::fieldNumber << 3) | MemoryField::wireType);
+        MemoryField field{RAM{memory->ram}, ROM{memory->rom}, EXP1{memory->exp1}, HardwareMemory{memory->hardware}};
+        field.serialize(&slice);
+        std::string memoryData = slice.finalize();
+        pool->release(std::move(memory));
+
+        // Saves to the same file must land in the order they were requested.
+        if (previous.valid()) previous.wait();
+        PCSX::ZWriter save(new PCSX::PosixFile(filename, PCSX::FileOps::TRUNCATE), PCSX::ZWriter::GZIP);
+        if (!save.failed()) {
+            save.writeString(state);
+            save.writeString(memoryData);
+            success = true;
+        }
+        save.close();
+        done.set_value();
+    }
+};
+
+// Per emulation thread, like g_emulator, so that instances running side by
+// side neither share snapshots nor wait on each other's saves.
+thread_local std::shared_ptr<MemorySnapshotPool> s_snapshotPool = std::make_shared<MemorySnapshotPool>();
+thread_local std::shared_future<void> s_lastAsyncSave;
+
+}  // namespace
+
+std::string PCSX::SaveStates::save() {
+    SaveState state = constructSaveState();
+    fillSaveState(state);
 
     Protobuf::OutSlice slice;
     state.serialize(&slice);
     return slice.finalize();
 }
 
+void PCSX::SaveStates::saveAsync(std::filesystem::path filename) {
+    auto save = new AsyncSave();
+    save->req.data = save;
+    save->filename = std::move(filename);
+    save->previous = s_lastAsyncSave;
+    s_lastAsyncSave = save->done.get_future().share();
+
+    // Only the memory copy and the encoding of the small device state happen
+    // here; the 17MB of memory gets encoded along with the compression and I/O.
+    save->pool = s_snapshotPool;
+    auto& memory = save->memory = s_snapshotPool->acquire();
+    memcpy(memory->ram, g_emulator->m_mem->m_wram, sizeof(memory->ram));
+    memcpy(memory->rom, g_emulator->m_mem->m_bios, sizeof(memory->rom));
+    memcpy(memory->exp1, g_emulator->m_mem->m_exp1, sizeof(memory->exp1));
+    memcpy(memory->hardware, g_emulator->m_mem->m_hard, sizeof(memory->hardware));
+
+    SaveState state = constructSaveState(false);
+    fillSaveState(state);
+    Protobuf::OutSlice slice;
+    state.serialize(&slice);
+    save->state = slice.finalize();
+
+    uv_queue_work(
+        g_system->getLoop(), &save->req, [](uv_work_t* req) { reinterpret_cast<AsyncSave*>(req->data)->work(); },
+        [](uv_work_t* req, int status) {
+            auto save = reinterpret_cast<AsyncSave*>(req->data);
+            g_system->m_eventBus->signal(
+                Events::ExecutionFlow::SaveStateSaved{save->filename.string(), save->success});
+            delete save;
+        });
+}
+
+void PCSX::SaveStates::waitAsyncSaves() {
+    if (s_lastAsyncSave.valid()) s_lastAsyncSave.wait();
+}
+
 void PCSX::CallStacks::serialize(SaveStateWrapper* w) {
     using namespace SaveStates;
     auto& callstacks = w->state.get<SaveStates::CallStacksField>().get<CallStacksMessageField>().value;
@@ -278,8 +408,10 @@ void PCSX::Counters::serialize(SaveStateWrapper* w) {
     counters.get<PSXNextCounter>().value = m_psxNextCounter;
 }
 
-bool PCSX::SaveStates::load(std::string_view data) {
-    SaveState state = constructSaveState();
+bool PCSX::SaveStates::load(std::string_view data) { return load(data, nullptr); }
+
+bool PCSX::SaveStates::load(std::string_view data, const std::function<void()>& restoreMemory) {
+    SaveState state = constructSaveState(!restoreMemory);
 
     Protobuf::InSlice slice(reinterpret_cast<const uint8_t*>(data.data()), data.size());
     try {
@@ -292,9 +424,12 @@ bool PCSX::SaveStates::load(std::string_view data) {
         return false;
     }
 
+    if (restoreMemory) restoreMemory();
+
     SaveStateWrapper wrapper(state);
     PCSX::g_emulator->m_cpu->Reset();
     state.commit();
+    g_emulator->m_mem->shareROMs();
     g_emulator->m_cpu->m_regs.lowestTarget = g_emulator->m_cpu->m_regs.cycle;
     g_emulator->m_cpu->m_regs.previousCycles = g_emulator->m_cpu->m_regs.cycle;
     // x86-64 recompiler might make save states with an unaligned PC, since it ignores the bottom 2 bits
@@ -340,6 +475,96 @@ bool PCSX::SaveStates::load(std::string_view data) {
     return true;
 }
 
+bool PCSX::SaveStates::saveMapped(const std::filesystem::path& filename) {
+    SaveState state = constructSaveState(false);
+    fillSaveState(state);
+    Protobuf::OutSlice slice;
+    state.serialize(&slice);
+    std::string data = slice.finalize();
+
+    auto& mem = g_emulator->m_mem;
+    const void* sources[] = {mem->m_wram, mem->m_exp1, mem->m_bios, mem->m_hard, data.data()};
+    const uint64_t sizes[] = {0x00800000, 0x00800000, 0x00080000, 0x00010000, data.size()};
+    static_assert(sizeof(sizes) / sizeof(sizes[0]) == MappedHeader::SECTION_COUNT);
+
+    MappedHeader header;
+    memcpy(header.magic, MappedHeader::c_magic, sizeof(header.magic));
+    uint64_t offset = MappedHeader::c_alignment;
+    for (unsigned i = 0; i < MappedHeader::SECTION_COUNT; i++) {
+        header.sections[i].offset = offset;
+        header.sections[i].size = sizes[i];
+        offset = (offset + sizes[i] + MappedHeader::c_alignment - 1) & ~(MappedHeader::c_alignment - 1);
+    }
+
+    // A state loaded earlier from this very file may still have pages mapped
+    // from it, which must neither change nor get truncated from under it. So
+    // write a new file, and only then swap it in place of the old one.
+    auto tempFilename = filename;
+    tempFilename += ".tmp";
+    {
+        IO<File> out(new PosixFile(tempFilename, FileOps::TRUNCATE));
+        if (out->failed()) return false;
+        bool success = out->write(&header, sizeof(header)) == ssize_t(sizeof(header));
+        for (unsigned i = 0; success && (i < MappedHeader::SECTION_COUNT); i++) {
+            out->wSeek(header.sections[i].offset, SEEK_SET);
+            success = out->write(sources[i], sizes[i]) == ssize_t(sizes[i]);
+        }
+        out->close();
+        if (!success) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempFilename, filename, ec);
+    return !ec;
+}
+
+bool PCSX::SaveStates::loadMapped(const std::filesystem::path& filename) {
+    IO<File> in(new PosixFile(filename));
+    if (in->failed()) return false;
+    MappedHeader header;
+    if (in->read(&header, sizeof(header)) != ssize_t(sizeof(header))) return false;
+    if (memcmp(header.magic, MappedHeader::c_magic, sizeof(header.magic)) != 0) return false;
+
+    auto& mem = g_emulator->m_mem;
+    uint8_t* destinations[] = {mem->m_wram, mem->m_exp1, mem->m_bios, mem->m_hard};
+    const uint64_t sizes[] = {0x00800000, 0x00800000, 0x00080000, 0x00010000};
+    const uint64_t fileSize = in->size();
+    for (unsigned i = 0; i < MappedHeader::SECTION_COUNT; i++) {
+        auto& section = header.sections[i];
+        if ((section.offset % MappedHeader::c_alignment) != 0) return false;
+        if ((section.offset > fileSize) || (section.size > (fileSize - section.offset))) return false;
+        if ((i != MappedHeader::STATE) && (section.size != sizes[i])) return false;
+    }
+
+    std::string data;
+    auto& stateSection = header.sections[MappedHeader::STATE];
+    data.resize(stateSection.size);
+    in->rSeek(stateSection.offset, SEEK_SET);
+    if (in->read(data.data(), data.size()) != ssize_t(data.size())) return false;
+
+    return load(data, [&]() {
+        bool mapped[MappedHeader::SECTION_COUNT] = {};
+#ifndef _WIN32
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            // Other processes may be looking at RAM through its shared memory
+            // object, and a private mapping would leave them with stale pages,
+            // so shared RAM, which is the default, always gets read in.
+            if (!mem->isWRAMShared()) {
+                mapped[MappedHeader::RAM] = mem->mapWRAM(fd, header.sections[MappedHeader::RAM].offset);
+            }
+            mapped[MappedHeader::EXP1] = mem->mapEXP1(fd, header.sections[MappedHeader::EXP1].offset);
+            // The mappings hold on to the file on their own.
+            close(fd);
+        }
+#endif
+        for (unsigned i = 0; i < MappedHeader::STATE; i++) {
+            if (mapped[i]) continue;
+            in->rSeek(header.sections[i].offset, SEEK_SET);
+            in->read(destinations[i], sizes[i]);
+        }
+    });
+}
+
 void PCSX::CallStacks::deserialize(const SaveStateWrapper* w) {
     using namespace SaveStates;
     m_callstacks.destroyAll();
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <filesystem>
+#include <functional>
 #include <string_view>
 
 #include "spu/types.h"
@@ -234,6 +236,7 @@ typedef Protobuf::FieldPtr<Protobuf::FixedBytes<3>, TYPESTRING("subq_relative"),
 typedef Protobuf::FieldPtr<Protobuf::FixedBytes<3>, TYPESTRING("subq_absolute"), 55> CDSubQAbsolute;
 typedef Protobuf::FieldRef<Protobuf::Bool, TYPESTRING("track_changed"), 56> CDTrackChanged;
 typedef Protobuf::FieldRef<Protobuf::Bool, TYPESTRING("location_changed"), 57> CDLocationChanged;
+typedef Protobuf::FieldRef<Protobuf::Bool, TYPESTRING("accelerated_read"), 58> CDAcceleratedRead;
 
 typedef Protobuf::Message<
     TYPESTRING("CDRom"), CDReg1Mode, CDReg2, CDCmdProcess, CDCtrl, CDStat, CDStatP, CDTransfer, CDTransferIndex, CDPrev,
@@ -242,7 +245,7 @@ typedef Protobuf::Message<
     CDSuceeded, CDFirstSector, CDIRQ, CDIrqRepeated, CDECycle, CDSeeked, CDReadRescheduled, CDDriveState, CDFastForward,
     CDFastBackward, CDAttenuatorLeftToLeft, CDAttenuatorLeftToRight, CDAttenuatorRightToRight, CDAttenuatorRightToLeft,
     CDAttenuatorLeftToLeftT, CDAttenuatorLeftToRightT, CDAttenuatorRightToRightT, CDAttenuatorRightToLeftT, CDSubQTrack,
-    CDSubQIndex, CDSubQRelative, CDSubQAbsolute, CDTrackChanged, CDLocationChanged>
+    CDSubQIndex, CDSubQRelative, CDSubQAbsolute, CDTrackChanged, CDLocationChanged, CDAcceleratedRead>
     CDRom;
 typedef Protobuf::MessageField<CDRom, TYPESTRING("cdrom"), 8> CDRomField;
 
@@ -319,10 +322,45 @@ typedef Protobuf::ProtoFile<SaveStateInfo, Thumbnail, Memory, DelaySlotInfo, Reg
                             CDRom, Hardware, Rcnt, Counters, MDEC, PCdrvFile, Call, CallStack, CallStacks, SaveState>
     ProtoFile;
 
-SaveState constructSaveState();
+SaveState constructSaveState(bool withMemory = true);
 
 std::string save();
+// Captures the machine state into pooled buffers, and leaves the protobuf
+// encoding, compression and writing of the file to the libuv thread pool.
+// Events::ExecutionFlow::SaveStateSaved is signaled on the main loop once
+// the file is fully written.
+void saveAsync(std::filesystem::path filename);
+// Blocks until all the saves started by saveAsync have hit the disk.
+void waitAsyncSaves();
 bool load(std::string_view data);
+// Same as above, for data which doesn't contain any of the Memory fields.
+// Once the rest of the state has been decoded successfully, restoreMemory
+// is called to bring the memory back by some other mean.
+bool load(std::string_view data, const std::function<void()>& restoreMemory);
+
+// Uncompressed save state container, laid out for loading speed rather than
+// size. Main RAM and EXP1 sit in their own page aligned sections, which the
+// loader maps copy-on-write straight into the emulated memory where the OS
+// allows it, so that only the pages actually touched afterwards are read.
+// This is POSIX only, and RAM is only ever mapped when it is neither shared
+// with other processes, which it is by default, nor the fastmem mirror;
+// otherwise it's simply read in, and only EXP1 gets mapped.
+// The remaining memory regions follow, then a regular SaveState message
+// without any of its Memory fields.
+struct MappedHeader {
+    enum Section { RAM, EXP1, ROM, HARDWARE, STATE, SECTION_COUNT };
+    static constexpr char c_magic[8] = {'P', 'C', 'S', 'X', 'M', 'S', 'S', '1'};
+    // Windows' allocation granularity, which is coarser than any page size.
+    static constexpr uint64_t c_alignment = 0x10000;
+    char magic[8];
+    struct {
+        uint64_t offset;
+        uint64_t size;
+    } sections[SECTION_COUNT];
+};
+
+bool saveMapped(const std::filesystem::path& filename);
+bool loadMapped(const std::filesystem::path& filename);
 }  // namespace SaveStates
 
 }  // namespace PCSX
@@ -26,7 +26,7 @@
 
 #include "support/file.h"
 
-PCSX::System* PCSX::g_system = NULL;
+thread_local PCSX::System* PCSX::g_system = NULL;
 
 static const ImWchar c_frenchRanges[] = {0x0020, 0x00ff, 0x0152, 0x0153, 0};
 static const ImWchar c_greekRanges[] = {0x0020, 0x00ff, 0x0370, 0x03ff, 0};
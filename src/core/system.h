@@ -61,6 +61,9 @@ namespace Events {
 struct SettingsLoaded {
     bool safe = false;
 };
+// Some setting got written from Lua, which bypasses whatever the UI would
+// have done along with the change.
+struct SettingsChanged {};
 struct Quitting {};
 struct LogMessage {
     LogClass logClass;
@@ -80,6 +83,10 @@ struct Reset {
     bool hard = false;
 };
 struct SaveStateLoaded {};
+struct SaveStateSaved {
+    std::string filename;
+    bool success = false;
+};
 }  // namespace ExecutionFlow
 namespace GUI {
 struct JumpToPC {
@@ -264,7 +271,7 @@ class System {
     bool m_emergencyExit = false;
 };
 
-extern System *g_system;
+extern thread_local System *g_system;
 
 }  // namespace PCSX
 
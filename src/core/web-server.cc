@@ -22,6 +22,7 @@
 #include <charconv>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <string>
 
 #include "GL/gl3w.h"
@@ -31,9 +32,11 @@
 #include "cdrom/iso9660-reader.h"
 #include "core/cdrom.h"
 #include "core/gpu.h"
+#include "core/memory-scanner.h"
 #include "core/psxemulator.h"
 #include "core/psxmem.h"
 #include "core/r3000a.h"
+#include "core/sampling-profiler.h"
 #include "core/system.h"
 #include "http-parser/http_parser.h"
 #include "lua/luawrapper.h"
@@ -41,6 +44,7 @@
 #include "multipart-parser-c/multipart_parser.h"
 #include "support/file.h"
 #include "support/hashtable.h"
+#include "support/instrumentation.h"
 #include "support/strings-helpers.h"
 
 namespace {
@@ -297,6 +301,209 @@ class FlowExecutor : public PCSX::WebExecutor {
     virtual ~FlowExecutor() = default;
 };
 
+class ProfilerExecutor : public PCSX::WebExecutor {
+    virtual bool match(PCSX::WebClient* client, const PCSX::UrlData& urldata) final {
+        return urldata.path == "/api/v1/cpu/profiler";
+    }
+    virtual bool execute(PCSX::WebClient* client, PCSX::RequestData& request) final {
+        auto& profiler = PCSX::g_emulator->m_samplingProfiler;
+        if (request.method == PCSX::RequestData::Method::HTTP_HTTP_GET) {
+            // Collapsed stacks, ready to be fed to flamegraph.pl or speedscope
+            std::ostringstream out;
+            profiler->writeCollapsed(out, PCSX::g_emulator->m_cpu->m_symbols);
+            std::string stacks = out.str();
+            client->write(std::string("HTTP/1.1 200 OK\r\n"
+                                      "Content-Type: text/plain\r\n"
+                                      "Content-Length: ") +
+                          std::to_string(stacks.size()) + std::string("\r\n\r\n") + stacks);
+            return true;
+        } else if (request.method == PCSX::RequestData::Method::HTTP_POST) {
+            auto vars = parseQuery(request.urlData.query);
+            auto ifunction = vars.find("function");
+            if (ifunction == vars.end()) {
+                client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+                return true;
+            }
+            std::string function = ifunction->second;
+            if (function.compare("start") == 0) {
+                uint32_t period = PCSX::SamplingProfiler::c_defaultPeriod;
+                auto iperiod = vars.find("period");
+                if (iperiod != vars.end()) {
+                    auto& str = iperiod->second;
+                    auto result = std::from_chars(str.data(), str.data() + str.size(), period);
+                    if ((result.ec != std::errc()) || (period == 0)) {
+                        client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+                        return true;
+                    }
+                }
+                profiler->start(period);
+                client->write("HTTP/1.1 200 OK\r\n\r\n");
+                return true;
+            }
+            if (function.compare("stop") == 0) {
+                profiler->stop();
+                client->write("HTTP/1.1 200 OK\r\n\r\n");
+                return true;
+            }
+            if (function.compare("clear") == 0) {
+                profiler->clear();
+                client->write("HTTP/1.1 200 OK\r\n\r\n");
+                return true;
+            }
+            client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+            return true;
+        }
+        return false;
+    }
+
+  public:
+    ProfilerExecutor() = default;
+    virtual ~ProfilerExecutor() = default;
+};
+
+class InstrumentationExecutor : public PCSX::WebExecutor {
+    virtual bool match(PCSX::WebClient* client, const PCSX::UrlData& urldata) final {
+        return urldata.path == "/api/v1/instrumentation";
+    }
+    virtual bool execute(PCSX::WebClient* client, PCSX::RequestData& request) final {
+        auto& instrumentation = PCSX::g_emulator->m_instrumentation;
+        if (request.method == PCSX::RequestData::Method::HTTP_HTTP_GET) {
+            auto& frame = instrumentation->lastFrame();
+            nlohmann::json j;
+            j["enabled"] = instrumentation->isEnabled();
+            j["frames"] = instrumentation->frames();
+            j["frameMicroseconds"] = frame.toMicroseconds(frame.totalTicks);
+            for (unsigned i = 0; i < PCSX::Instrumentation::c_scopeCount; i++) {
+                nlohmann::json scope;
+                scope["name"] = PCSX::Instrumentation::c_scopeNames[i];
+                scope["microseconds"] = frame.toMicroseconds(frame.ticks[i]);
+                scope["percent"] = frame.totalTicks ? 100.0 * double(frame.ticks[i]) / double(frame.totalTicks) : 0.0;
+                scope["calls"] = frame.calls[i];
+                j["scopes"].push_back(scope);
+            }
+            write200(client, j);
+            return true;
+        } else if (request.method == PCSX::RequestData::Method::HTTP_POST) {
+            auto vars = parseQuery(request.urlData.query);
+            auto ifunction = vars.find("function");
+            if (ifunction == vars.end()) {
+                client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+                return true;
+            }
+            std::string function = ifunction->second;
+            if (function.compare("enable") == 0) {
+                instrumentation->enable();
+                client->write("HTTP/1.1 200 OK\r\n\r\n");
+                return true;
+            }
+            if (function.compare("disable") == 0) {
+                instrumentation->disable();
+                client->write("HTTP/1.1 200 OK\r\n\r\n");
+                return true;
+            }
+            client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+            return true;
+        }
+        return false;
+    }
+
+  public:
+    InstrumentationExecutor() = default;
+    virtual ~InstrumentationExecutor() = default;
+};
+
+class MemoryScannerExecutor : public PCSX::WebExecutor {
+    virtual bool match(PCSX::WebClient* client, const PCSX::UrlData& urldata) final {
+        return urldata.path == "/api/v1/memory-scanner";
+    }
+    virtual bool execute(PCSX::WebClient* client, PCSX::RequestData& request) final {
+        using PCSX::MemoryScanner;
+        auto& scanner = PCSX::g_emulator->m_memoryScanner;
+        uint8_t* mem = PCSX::g_emulator->m_mem->m_wram;
+        auto vars = parseQuery(request.urlData.query);
+        if (request.method == PCSX::RequestData::Method::HTTP_HTTP_GET) {
+            // Candidates can number in the millions; only send a window of them.
+            size_t first = 0;
+            size_t count = 1000;
+            auto ifirst = vars.find("first");
+            auto icount = vars.find("count");
+            if (ifirst != vars.end()) first = std::stoul(ifirst->second);
+            if (icount != vars.end()) count = std::stoul(icount->second);
+            const size_t size = scanner->size();
+            const size_t last = first < size ? first + std::min(count, size - first) : first;
+            nlohmann::json j;
+            j["valueType"] = magic_enum::enum_name(scanner->valueType());
+            j["count"] = size;
+            j["candidates"] = nlohmann::json::array();
+            for (size_t i = first; i < last; i++) {
+                const uint32_t offset = scanner->candidate(i);
+                nlohmann::json candidate;
+                candidate["address"] = 0x80000000 + offset;
+                candidate["current"] = MemoryScanner::read(scanner->valueType(), mem, offset);
+                candidate["scanned"] = scanner->scannedValue(offset);
+                j["candidates"].push_back(candidate);
+            }
+            write200(client, j);
+            return true;
+        } else if (request.method == PCSX::RequestData::Method::HTTP_POST) {
+            auto ifunction = vars.find("function");
+            if (ifunction == vars.end()) {
+                client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+                return true;
+            }
+            std::string function = ifunction->second;
+            if (function.compare("reset") == 0) {
+                scanner->reset();
+                client->write("HTTP/1.1 200 OK\r\n\r\n");
+                return true;
+            }
+            const bool first = function.compare("first") == 0;
+            if (!first && (function.compare("next") != 0)) {
+                client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+                return true;
+            }
+            auto iscan = vars.find("scan");
+            auto scan =
+                iscan == vars.end() ? std::nullopt : magic_enum::enum_cast<MemoryScanner::ScanType>(iscan->second);
+            auto valueType = scanner->valueType();
+            if (first) {
+                auto itype = vars.find("type");
+                auto type =
+                    itype == vars.end() ? std::nullopt : magic_enum::enum_cast<MemoryScanner::ValueType>(itype->second);
+                if (!type.has_value()) {
+                    client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+                    return true;
+                }
+                valueType = type.value();
+            }
+            if (!scan.has_value()) {
+                client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+                return true;
+            }
+            int64_t value = 0;
+            auto ivalue = vars.find("value");
+            if (ivalue != vars.end()) {
+                value = MemoryScanner::truncate(valueType, std::stoll(ivalue->second, nullptr, 0));
+            }
+            if (first) {
+                const bool ram8M = PCSX::g_emulator->settings.get<PCSX::Emulator::Setting8MB>();
+                scanner->firstScan(mem, 1024 * 1024 * (ram8M ? 8 : 2), valueType, scan.value(), value);
+            } else {
+                scanner->nextScan(mem, scan.value(), value);
+            }
+            nlohmann::json j;
+            j["count"] = scanner->size();
+            write200(client, j);
+            return true;
+        }
+        return false;
+    }
+
+  public:
+    MemoryScannerExecutor() = default;
+    virtual ~MemoryScannerExecutor() = default;
+};
+
 class LuaExecutor : public PCSX::WebExecutor {
     virtual bool match(PCSX::WebClient* client, const PCSX::UrlData& urldata) final {
         return PCSX::StringsHelpers::startsWith(urldata.path, c_prefix);
@@ -406,7 +613,7 @@ class CDExecutor : public PCSX::WebExecutor {
         auto path = request.urlData.path.substr(c_prefix.length());
         auto& cdrom = PCSX::g_emulator->m_cdrom;
         auto iso = cdrom->getIso();
-        PCSX::ISO9660Reader reader(iso);
+        auto reader = cdrom->getIsoReader();
 
         if (request.method == PCSX::RequestData::Method::HTTP_HTTP_GET) {
             if (path == "info") {
@@ -432,7 +639,7 @@ class CDExecutor : public PCSX::WebExecutor {
                     client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
                     return true;
                 }
-                PCSX::IO<PCSX::File> file = reader.open(filename->second);
+                PCSX::IO<PCSX::File> file = reader->open(filename->second);
                 if (file->failed()) {
                     std::string message = fmt::format(
                         "HTTP/1.1 404 File Not Found\r\n\r\nFile {} was not found in the currently loaded disc image.",
@@ -475,7 +682,7 @@ class CDExecutor : public PCSX::WebExecutor {
                     }
                 }
 
-                if (reader.failed()) {
+                if (reader->failed()) {
                     client->write("HTTP/1.1 404 File Not Found\r\n\r\nNo disc image currently loaded.");
                     return true;
                 }
@@ -483,7 +690,7 @@ class CDExecutor : public PCSX::WebExecutor {
                 PCSX::IO<PCSX::File> file;
 
                 if (filename != vars.end()) {
-                    file = reader.open(filename->second);
+                    file = reader->open(filename->second);
                 }
 
                 if (sector != vars.end()) {
@@ -592,6 +799,9 @@ PCSX::WebServer::WebServer() : m_listener(g_system->m_eventBus) {
     m_executors.push_back(new AssemblyExecutor());
     m_executors.push_back(new CacheExecutor());
     m_executors.push_back(new FlowExecutor());
+    m_executors.push_back(new ProfilerExecutor());
+    m_executors.push_back(new InstrumentationExecutor());
+    m_executors.push_back(new MemoryScannerExecutor());
     m_executors.push_back(new LuaExecutor());
     m_executors.push_back(new CDExecutor());
     m_listener.listen<Events::SettingsLoaded>([this](const auto& event) {
@@ -26,6 +26,7 @@
 #include "gpu/soft/soft.h"
 #include "imgui.h"
 #include "support/imgui-helpers.h"
+#include "support/instrumentation.h"
 #include "tracy/Tracy.hpp"
 
 #define GPUSTATUS_DMABITS 0x60000000
@@ -286,6 +287,7 @@ static constexpr inline uint16_t BGR24to16(uint32_t BGR) {
 void PCSX::SoftGPU::impl::write0(ClearCache *) {}
 
 void PCSX::SoftGPU::impl::write0(FastFill *prim) {
+    PCSX_INSTRUMENT(Rasterizer);
     int16_t sX = prim->x;
     int16_t sY = prim->y;
     int16_t sW = prim->w;
@@ -309,6 +311,7 @@ void PCSX::SoftGPU::impl::write0(FastFill *prim) {
 template <PCSX::GPU::Shading shading, PCSX::GPU::Shape shape, PCSX::GPU::Textured textured, PCSX::GPU::Blend blend,
           PCSX::GPU::Modulation modulation>
 void PCSX::SoftGPU::impl::polyExec(Poly<shading, shape, textured, blend, modulation> *prim) {
+    PCSX_INSTRUMENT(Rasterizer);
     m_x0 = prim->x[0];
     m_y0 = prim->y[0];
     m_x1 = prim->x[1];
@@ -460,6 +463,7 @@ static constexpr inline bool CheckCoordL(int16_t slx0, int16_t sly0, int16_t slx
 
 template <PCSX::GPU::Shading shading, PCSX::GPU::LineType lineType, PCSX::GPU::Blend blend>
 void PCSX::SoftGPU::impl::lineExec(Line<shading, lineType, blend> *prim) {
+    PCSX_INSTRUMENT(Rasterizer);
     auto count = prim->colors.size();
 
     m_drawSemiTrans = blend == Blend::Semi;
@@ -490,6 +494,7 @@ void PCSX::SoftGPU::impl::lineExec(Line<shading, lineType, blend> *prim) {
 
 template <PCSX::GPU::Size size, PCSX::GPU::Textured textured, PCSX::GPU::Blend blend, PCSX::GPU::Modulation modulation>
 void PCSX::SoftGPU::impl::rectExec(Rect<size, textured, blend, modulation> *prim) {
+    PCSX_INSTRUMENT(Rasterizer);
     int16_t w, h;
 
     m_x0 = prim->x;
@@ -549,6 +554,7 @@ void PCSX::SoftGPU::impl::rectExec(Rect<size, textured, blend, modulation> *prim
 }
 
 void PCSX::SoftGPU::impl::write0(BlitVramVram *prim) {
+    PCSX_INSTRUMENT(Rasterizer);
     int16_t imageY0, imageX0, imageY1, imageX1, imageSX, imageSY, i, j;
 
     imageX0 = prim->sX;
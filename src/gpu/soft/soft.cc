@@ -20,6 +20,8 @@
 #include "gpu/soft/soft.h"
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
 
 #include "gpu/soft/soft.h"
 
@@ -280,13 +282,18 @@ void PCSX::SoftGPU::SoftRenderer::applyOffset4() {
 
 static constexpr uint8_t s_dithertable[16] = {7, 0, 6, 1, 2, 5, 3, 4, 1, 6, 0, 7, 4, 3, 5, 2};
 
-static uint16_t *s_ditherLUT = nullptr;
+// The table is 512MB large and never changes once built, so it's only kept
+// around for as long as at least one renderer holds onto it.
+static std::mutex s_ditherLUTMutex;
+static std::weak_ptr<const uint16_t[]> s_ditherLUT;
 
-static void prepareDitherLut() {
+static std::shared_ptr<const uint16_t[]> prepareDitherLut() {
     uint32_t r, g, b, s;
-    assert(s_ditherLUT == nullptr);
-    s_ditherLUT = new uint16_t[256 * 256 * 256 * 16];
-    uint16_t *ditherLUT = s_ditherLUT;
+    std::unique_lock<std::mutex> lock(s_ditherLUTMutex);
+    auto shared = s_ditherLUT.lock();
+    if (shared) return shared;
+    std::shared_ptr<uint16_t[]> lut(new uint16_t[256 * 256 * 256 * 16]);
+    uint16_t *ditherLUT = lut.get();
     for (r = 0; r < 256; r++) {
         for (g = 0; g < 256; g++) {
             for (b = 0; b < 256; b++) {
@@ -317,23 +324,20 @@ static void prepareDitherLut() {
             }
         }
     }
+    s_ditherLUT = lut;
+    return lut;
 }
 
 void PCSX::SoftGPU::SoftRenderer::enableCachedDithering() {
-    if (!s_ditherLUT) prepareDitherLut();
+    if (!m_ditherLUT) m_ditherLUT = prepareDitherLut();
 }
 
-void PCSX::SoftGPU::SoftRenderer::disableCachedDithering() {
-    if (s_ditherLUT) delete[] s_ditherLUT;
-    s_ditherLUT = nullptr;
-}
+void PCSX::SoftGPU::SoftRenderer::disableCachedDithering() { m_ditherLUT.reset(); }
 
-PCSX::SoftGPU::SoftRenderer::~SoftRenderer() {
-    if (s_ditherLUT) delete[] s_ditherLUT;
-    s_ditherLUT = nullptr;
-}
+PCSX::SoftGPU::SoftRenderer::~SoftRenderer() {}
 
-static void applyDitherCached(uint16_t *pdest, uint16_t *base, uint32_t r, uint32_t g, uint32_t b, uint16_t sM) {
+static void applyDitherCached(const uint16_t *lut, uint16_t *pdest, uint16_t *base, uint32_t r, uint32_t g, uint32_t b,
+                              uint16_t sM) {
     int x, y;
 
     x = pdest - base;
@@ -348,7 +352,7 @@ static void applyDitherCached(uint16_t *pdest, uint16_t *base, uint32_t r, uint3
     index <<= 4;
     index |= (y & 3) * 4 + (x & 3);
 
-    *pdest = s_ditherLUT[index] | sM;
+    *pdest = lut[index] | sM;
 }
 
 static void applyDither(uint16_t *pdest, uint16_t *base, uint32_t r, uint32_t g, uint32_t b, uint16_t sM) {
@@ -423,7 +427,7 @@ void PCSX::SoftGPU::SoftRenderer::getShadeTransColDither(uint16_t *pdest, int32_
     if (g & 0x7fffff00) g = 0xff;
 
     if constexpr (useCachedDither) {
-        applyDitherCached(pdest, m_vram16, r, b, g, m_setMask16);
+        applyDitherCached(m_ditherLUT.get(), pdest, m_vram16, r, b, g, m_setMask16);
     } else {
         applyDither(pdest, m_vram16, r, b, g, m_setMask16);
     }
@@ -930,7 +934,7 @@ void PCSX::SoftGPU::SoftRenderer::getTextureTransColShadeXDither(uint16_t *pdest
     if (g & 0x7fffff00) g = 0xff;
 
     if constexpr (useCachedDither) {
-        applyDitherCached(pdest, m_vram16, r, b, g, m_setMask16 | (color & 0x8000));
+        applyDitherCached(m_ditherLUT.get(), pdest, m_vram16, r, b, g, m_setMask16 | (color & 0x8000));
     } else {
         applyDither(pdest, m_vram16, r, b, g, m_setMask16 | (color & 0x8000));
     }
@@ -1067,9 +1071,8 @@ void PCSX::SoftGPU::SoftRenderer::fillSoftwareAreaTrans(int16_t x0, int16_t y0,
 
     if (dx == 1 && dy == 1 && x0 == 1020 && y0 == 511) {
         // interlace hack - fix me
-        static int iCheat = 0;
-        col += iCheat;
-        iCheat ^= 1;
+        col += m_interlaceCheat;
+        m_interlaceCheat ^= 1;
     }
 
     if (dx & 1) {
@@ -3858,7 +3861,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Gi(int16_t x1, int16_t y1, int16_t x2
 ////////////////////////////////////////////////////////////////////////
 
 void PCSX::SoftGPU::SoftRenderer::drawPolyShade3(int32_t rgb1, int32_t rgb2, int32_t rgb3) {
-    if (s_ditherLUT) {
+    if (m_ditherLUT) {
         drawPoly3Gi<true>(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, rgb1, rgb2, rgb3);
     } else {
         drawPoly3Gi<false>(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, rgb1, rgb2, rgb3);
@@ -3868,7 +3871,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPolyShade3(int32_t rgb1, int32_t rgb2, int
 // draw two g-shaded tris for right psx shading emulation
 
 void PCSX::SoftGPU::SoftRenderer::drawPolyShade4(int32_t rgb1, int32_t rgb2, int32_t rgb3, int32_t rgb4) {
-    if (s_ditherLUT) {
+    if (m_ditherLUT) {
         drawPoly3Gi<true>(m_x1, m_y1, m_x3, m_y3, m_x2, m_y2, rgb2, rgb4, rgb3);
         drawPoly3Gi<true>(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, rgb1, rgb2, rgb3);
     } else {
@@ -4043,7 +4046,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx4(int16_t x1, int16_t y1, int16_t
                                                  int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3,
                                                  int16_t ty3, int16_t clX, int16_t clY, int32_t col1, int32_t col2,
                                                  int32_t col3) {
-    if (s_ditherLUT) {
+    if (m_ditherLUT) {
         drawPoly3TGEx4i<true>(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, clX, clY, col1, col2, col3);
     } else {
         drawPoly3TGEx4i<false>(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, clX, clY, col1, col2, col3);
@@ -4055,7 +4058,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly4TGEx4(int16_t x1, int16_t y1, int16_t
                                                  int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4, int16_t ty4,
                                                  int16_t clX, int16_t clY, int32_t col1, int32_t col2, int32_t col3,
                                                  int32_t col4) {
-    if (s_ditherLUT) {
+    if (m_ditherLUT) {
         drawPoly3TGEx4i<true>(x2, y2, x3, y3, x4, y4, tx2, ty2, tx3, ty3, tx4, ty4, clX, clY, col2, col4, col3);
         drawPoly3TGEx4i<true>(x1, y1, x2, y2, x4, y4, tx1, ty1, tx2, ty2, tx4, ty4, clX, clY, col1, col2, col3);
     } else {
@@ -4222,7 +4225,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx8(int16_t x1, int16_t y1, int16_t
                                                  int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3,
                                                  int16_t ty3, int16_t clX, int16_t clY, int32_t col1, int32_t col2,
                                                  int32_t col3) {
-    if (s_ditherLUT) {
+    if (m_ditherLUT) {
         drawPoly3TGEx8i<true>(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, clX, clY, col1, col2, col3);
     } else {
         drawPoly3TGEx8i<false>(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, clX, clY, col1, col2, col3);
@@ -4234,7 +4237,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly4TGEx8(int16_t x1, int16_t y1, int16_t
                                                  int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4, int16_t ty4,
                                                  int16_t clX, int16_t clY, int32_t col1, int32_t col2, int32_t col3,
                                                  int32_t col4) {
-    if (s_ditherLUT) {
+    if (m_ditherLUT) {
         drawPoly3TGEx8i<true>(x2, y2, x3, y3, x4, y4, tx2, ty2, tx3, ty3, tx4, ty4, clX, clY, col2, col4, col3);
         drawPoly3TGEx8i<true>(x1, y1, x2, y2, x4, y4, tx1, ty1, tx2, ty2, tx4, ty4, clX, clY, col1, col2, col3);
     } else {
@@ -4402,7 +4405,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGDi(int16_t x1, int16_t y1, int16_t
 void PCSX::SoftGPU::SoftRenderer::drawPoly3TGD(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
                                                int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3,
                                                int16_t ty3, int32_t col1, int32_t col2, int32_t col3) {
-    if (s_ditherLUT) {
+    if (m_ditherLUT) {
         drawPoly3TGDi<true>(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, col1, col2, col3);
     } else {
         drawPoly3TGDi<false>(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, col1, col2, col3);
@@ -4413,7 +4416,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly4TGD(int16_t x1, int16_t y1, int16_t x
                                                int16_t x4, int16_t y4, int16_t tx1, int16_t ty1, int16_t tx2,
                                                int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4, int16_t ty4,
                                                int32_t col1, int32_t col2, int32_t col3, int32_t col4) {
-    if (s_ditherLUT) {
+    if (m_ditherLUT) {
         drawPoly3TGDi<true>(x2, y2, x3, y3, x4, y4, tx2, ty2, tx3, ty3, tx4, ty4, col2, col4, col3);
         drawPoly3TGDi<true>(x1, y1, x2, y2, x4, y4, tx1, ty1, tx2, ty2, tx4, ty4, col1, col2, col3);
     } else {
@@ -21,6 +21,8 @@
 
 #include <stdint.h>
 
+#include <memory>
+
 #include "core/gpu.h"
 
 namespace PCSX {
@@ -91,6 +93,7 @@ struct SoftRenderer {
     SoftRect m_textureWindow;
     bool m_ditherMode = false;
     int m_drawX, m_drawY, m_drawW, m_drawH;
+    int m_interlaceCheat = 0;
 
     static constexpr int GPU_WIDTH = 1024;
     static constexpr int GPU_HEIGHT = 512;
@@ -116,6 +119,8 @@ struct SoftRenderer {
     SoftDisplay m_softDisplay;
     uint8_t *m_vram;
     uint16_t *m_vram16;
+    // Shared between all of the renderers which have cached dithering enabled.
+    std::shared_ptr<const uint16_t[]> m_ditherLUT;
 
     void applyOffset2();
     void applyOffset3();
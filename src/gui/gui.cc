@@ -1368,6 +1368,8 @@ in Configuration->Emulation, restart PCSX-Redux, then try again.)"));
                     }
                     ImGui::EndMenu();
                 }
+                ImGui::Separator();
+                ImGui::MenuItem(_("Show Instrumentation"), nullptr, &m_instrumentation.m_show);
                 ImGui::EndMenu();
             }
             ImGui::Separator();
@@ -1390,6 +1392,9 @@ in Configuration->Emulation, restart PCSX-Redux, then try again.)"));
                 ImGui::Separator();
                 uint32_t frameCount = g_emulator->m_spu->getFrameCount();
                 ImGui::Text(_("%.2f ms audio buffer (%i frames)"), 1000.0f * frameCount / 44100.0f, frameCount);
+                ImGui::Separator();
+                ImGui::Text(_("%i frames queued, %.1f ms/s audio stall"), g_emulator->m_spu->getBufferFill(),
+                            g_emulator->m_counters->getAudioStallPerSecond());
             } else {
                 ImGui::TextUnformatted(_("Idle"));
             }
@@ -1501,6 +1506,9 @@ in Configuration->Emulation, restart PCSX-Redux, then try again.)"));
     if (m_callstacks.m_show) {
         m_callstacks.draw(_("Callstacks"), this);
     }
+    if (m_instrumentation.m_show) {
+        m_instrumentation.draw(_("Instrumentation"));
+    }
 
     {
         unsigned counter = 0;
@@ -1666,6 +1674,13 @@ their TV set to match the aspect ratio of the game.)"));
         if (ImGui::Begin(_("System Configuration"), &m_showSysCfg)) {
             changed |=
                 ImGui::Checkbox(_("Preload Disk Image files"), &emuSettings.get<Emulator::SettingFullCaching>().value);
+            changed |= ImGui::Checkbox(_("Memory map Disk Image files"),
+                                       &emuSettings.get<Emulator::SettingMmapDiscImages>().value);
+            ImGuiHelpers::ShowHelpMarker(_(R"(Disk images are mapped in memory, instead of being read
+through the file API. This is cheaper on large images, and
+leaves the caching to the operating system. Only used for
+local files, and takes over the preload option when active.
+Takes effect on the next disk image opened.)"));
             changed |= ImGui::Checkbox(_("Enable Auto Update"), &emuSettings.get<Emulator::SettingAutoUpdate>().value);
         }
         ImGui::End();
@@ -1992,12 +2007,37 @@ bool PCSX::GUI::configure() {
             }
         }
 
+#if defined(DYNAREC_X86_64)
+        ImGuiHelpers::ShowHelpMarker(_(R"(Activates the dynamic recompiler CPU core.
+It is significantly faster than the interpreted CPU.
+Breakpoints work with it, but stepping through code
+and memory maps still require the interpreted CPU.
+A breakpoint on a branch delay slot, or right after
+a load, only stops at the end of the compiled block.
+Changing this setting requires a reboot to take effect.
+The dynarec core isn't available for all CPUs, so
+this setting may not have any effect for you.)"));
+#else
         ImGuiHelpers::ShowHelpMarker(_(R"(Activates the dynamic recompiler CPU core.
 It is significantly faster than the interpreted CPU,
 however it doesn't play nicely with the debugger.
 Changing this setting requires a reboot to take effect.
 The dynarec core isn't available for all CPUs, so
 this setting may not have any effect for you.)"));
+#endif
+        changed |=
+            ImGui::Checkbox(_("Cached interpreter"), &settings.get<Emulator::SettingCachedInterpreter>().value);
+        ImGuiHelpers::ShowHelpMarker(_(R"(When using the interpreted CPU, decodes the
+code once and caches it, instead of decoding every
+instruction each time it runs. This is faster, and
+works everywhere, but bypasses the emulation of the
+CPU instruction cache, which very few games rely on.)"));
+        changed |= ImGui::Checkbox(_("Fastmem"), &settings.get<Emulator::SettingFastmem>().value);
+        ImGuiHelpers::ShowHelpMarker(_(R"(Lets the dynarec access memory directly through
+a mirror of the console's address space, instead
+of calling into the memory handlers, which is a
+lot faster. Only available on Linux and MacOS.
+Requires a restart when changing this setting.)"));
         bool memChanged = ImGui::Checkbox(_("8MB"), &settings.get<Emulator::Setting8MB>().value);
         ImGuiHelpers::ShowHelpMarker(_(R"(Emulates an installed 8MB system,
 instead of the normal 2MB. Useful for working
@@ -2043,6 +2083,32 @@ when changing this setting.)"));
 which may include additional checks.
 Also will make the boot time substantially
 faster by not displaying the logo.)"));
+        {
+            static const std::function<const char*()> speeds[] = {l_("Instant"), l_("Off"), l_("2x"),
+                                                                  l_("4x"),      l_("8x"),  l_("16x")};
+            static const int values[] = {0, 1, 2, 4, 8, 16};
+            auto& speedup = settings.get<Emulator::SettingCDSpeedup>().value;
+            unsigned current = 1;
+            for (unsigned i = 0; i < std::size(values); i++) {
+                if (values[i] == speedup) current = i;
+            }
+            if (ImGui::BeginCombo(_("Accelerated CD"), speeds[current]())) {
+                for (unsigned i = 0; i < std::size(values); i++) {
+                    if (ImGui::Selectable(speeds[i](), i == current)) {
+                        changed = true;
+                        speedup = values[i];
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            ImGuiHelpers::ShowHelpMarker(_(R"(Shortens the CD-ROM seeks, spin ups and data
+reads by the selected factor. Streamed reads,
+such as XA audio and movies, and CD audio keep
+their real speed. Games timing themselves on the
+drive may misbehave, so leave this off when in doubt.)"));
+            ImGui::Text(_("Saved %.2fs of CD-ROM delays since the last reset"),
+                        double(g_emulator->m_cdrom->getAcceleratedCycles()) / g_emulator->m_psxClockSpeed);
+        }
         auto bios = settings.get<Emulator::SettingBios>().string();
         ImGui::InputText(_("BIOS file"), const_cast<char*>(reinterpret_cast<const char*>(bios.c_str())), bios.length(),
                          ImGuiInputTextFlags_ReadOnly);
@@ -2050,6 +2116,7 @@ faster by not displaying the logo.)"));
         selectBiosDialog = ImGui::Button("...");
         if (ImGui::Checkbox(_("Enable Debugger"), &debugSettings.get<Emulator::DebugSettings::Debug>().value)) {
             changed = true;
+            g_emulator->m_mem->setLuts();
             if (debugSettings.get<PCSX::Emulator::DebugSettings::Debug>() && settings.get<Emulator::SettingDynarec>()) {
                 showDynarecDebugWarning = true;
             }
@@ -2213,15 +2280,29 @@ See the wiki for details.)"));
         }
     }
     if (showDynarecDebugWarning && showDynarecWarning) {
+#if defined(DYNAREC_X86_64)
+        addNotification(R"(Debugger and dynarec enabled at the same time.
+Breakpoints will work, but stepping through code
+and memory maps require turning the dynarec off.
+Additionally, changing the dynarec option requires
+a restart of the emulator to take effect.)");
+#else
         addNotification(R"(Debugger and dynarec enabled at the same time.
 Consider turning either one off, otherwise
 debugging features may not work. Additionally,
 changing the dynarec option requires a restart
 of the emulator to take effect.)");
+#endif
     } else if (showDynarecDebugWarning) {
+#if defined(DYNAREC_X86_64)
+        addNotification(R"(Debugger and dynarec enabled at the same time.
+Breakpoints will work, but stepping through code
+and memory maps require turning the dynarec off.)");
+#else
         addNotification(R"(Debugger and dynarec enabled at the same time.
 Consider turning either one off, otherwise
 debugging features may not work.)");
+#endif
     } else if (showDynarecWarning) {
         addNotification(R"(Toggling the Dynarec option requires a restart
 of the emulator to take effect.)");
@@ -2575,16 +2656,14 @@ void PCSX::GUI::saveSaveState(std::filesystem::path filename) {
     if (filename.is_relative()) {
         filename = g_system->getPersistentDir() / filename;
     }
-    // TODO: yeet this to libuv's threadpool.
-    ZWriter save(new UvFile(filename, FileOps::TRUNCATE), ZWriter::GZIP);
-    if (!save.failed()) save.writeString(SaveStates::save());
-    save.close();
+    SaveStates::saveAsync(filename);
 }
 
 void PCSX::GUI::loadSaveState(std::filesystem::path filename) {
     if (filename.is_relative()) {
         filename = g_system->getPersistentDir() / filename;
     }
+    SaveStates::waitAsyncSaves();
     ZReader save(new PosixFile(filename));
     if (save.failed()) return;
     std::ostringstream os;
@@ -540,11 +540,19 @@ void PCSX::Widgets::Assembly::draw(GUI* gui, psxRegisters* registers, Memory* me
     uint32_t pc = virtToReal(m_registers->pc);
     auto& debugSettings = g_emulator->settings.get<Emulator::SettingDebugSettings>();
     if (ImGui::Checkbox(_("Enable Debugger"), &debugSettings.get<Emulator::DebugSettings::Debug>().value)) {
+        g_emulator->m_mem->setLuts();
         if (g_emulator->settings.get<Emulator::SettingDynarec>() &&
             debugSettings.get<Emulator::DebugSettings::Debug>()) {
+#if defined(DYNAREC_X86_64)
+            gui->addNotification(R"(Debugger and dynarec enabled at the same time.
+Breakpoints will work, but stepping through code
+and memory maps require turning the dynarec off
+in the main Emulation settings.)");
+#else
             gui->addNotification(R"(Debugger and dynarec enabled at the same time.
 Consider turning the dynarec off in the main Emulation
 settings, otherwise debugging features may not work.)");
+#endif
         }
     }
     ImGui::SameLine();
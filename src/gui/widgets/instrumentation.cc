@@ -0,0 +1,73 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "gui/widgets/instrumentation.h"
+
+#include <string>
+
+#include "core/psxemulator.h"
+#include "core/system.h"
+#include "fmt/format.h"
+#include "imgui.h"
+#include "support/instrumentation.h"
+
+void PCSX::Widgets::Instrumentation::draw(const char* title) {
+    if (!ImGui::Begin(title, &m_show)) {
+        ImGui::End();
+        return;
+    }
+
+    auto& instrumentation = g_emulator->m_instrumentation;
+    bool enabled = instrumentation->isEnabled();
+    if (ImGui::Checkbox(_("Enable"), &enabled)) {
+        if (enabled) {
+            instrumentation->enable();
+        } else {
+            instrumentation->disable();
+        }
+    }
+    auto& frame = instrumentation->lastFrame();
+    ImGui::SameLine();
+    ImGui::Text(_("Last frame: %.1f us"), frame.toMicroseconds(frame.totalTicks));
+
+    if (ImGui::BeginTable("Instrumentation", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn(_("Scope"));
+        ImGui::TableSetupColumn(_("Time (us)"));
+        ImGui::TableSetupColumn(_("Share"), ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn(_("Calls"));
+        ImGui::TableHeadersRow();
+        for (unsigned i = 0; i < PCSX::Instrumentation::c_scopeCount; i++) {
+            float share = frame.totalTicks ? float(double(frame.ticks[i]) / double(frame.totalTicks)) : 0.0f;
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            auto name = PCSX::Instrumentation::c_scopeNames[i];
+            ImGui::TextUnformatted(name.data(), name.data() + name.size());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", frame.toMicroseconds(frame.ticks[i]));
+            ImGui::TableNextColumn();
+            std::string overlay = fmt::format("{:.1f}%", share * 100.0f);
+            ImGui::ProgressBar(share, ImVec2(-1, 0), overlay.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(frame.calls[i]));
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
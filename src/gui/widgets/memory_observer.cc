@@ -26,6 +26,7 @@
 #include <magic_enum/include/magic_enum/magic_enum_all.hpp>
 
 #include "core/debug.h"
+#include "core/memory-scanner.h"
 #include "core/psxemulator.h"
 #include "core/psxmem.h"
 #include "core/system.h"
@@ -34,12 +35,12 @@
 
 PCSX::Widgets::MemoryObserver::MemoryObserver(bool& show) : m_show(show), m_listener(g_system->m_eventBus) {
     m_listener.listen<PCSX::Events::GPU::VSync>([this](const auto& event) {
-        for (const auto& addressValuePair : m_addressValuePairs) {
-            if (addressValuePair.frozen) {
-                const auto dataSize = getStrideFromValueType(m_scanValueType);
-                memcpy(g_emulator->m_mem->m_wram + addressValuePair.address - 0x80000000, &addressValuePair.frozenValue,
-                       dataSize);
-            }
+        auto& scanner = g_emulator->m_memoryScanner;
+        const auto dataSize = MemoryScanner::stride(scanner->valueType());
+        for (const auto& [address, value] : m_frozen) {
+            // The search may have been reset or narrowed down from Lua or the web server.
+            if (!scanner->isCandidate(address - 0x80000000)) continue;
+            memcpy(g_emulator->m_mem->m_wram + address - 0x80000000, &value, dataSize);
         }
     });
 
@@ -195,104 +196,39 @@ void PCSX::Widgets::MemoryObserver::draw(const char* title) {
         }
 
         if (ImGui::BeginTabItem(_("Delta-over-time search"))) {
-            const auto stride = getStrideFromValueType(m_scanValueType);
-
-            if (m_addressValuePairs.empty() && ImGui::Button(_("First scan"))) {
-                int64_t memValue = 0;
-
-                for (uint32_t i = 0; i < memSize; ++i) {
-                    if (i != 0 && i % stride == 0) {
-                        switch (m_scanType) {
-                            case ScanType::ExactValue:
-                                if (memValue == m_value) {
-                                    m_addressValuePairs.push_back({memBase + i - stride, memValue});
-                                }
-                                break;
-                            case ScanType::GreaterThan:
-                                if (memValue > m_value) {
-                                    m_addressValuePairs.push_back({memBase + i - stride, memValue});
-                                }
-                                break;
-                            case ScanType::LessThan:
-                                if (memValue < m_value) {
-                                    m_addressValuePairs.push_back({memBase + i - stride, memValue});
-                                }
-                                break;
-                            case ScanType::Changed:
-                            case ScanType::Unchanged:
-                            case ScanType::Increased:
-                            case ScanType::Decreased:
-                                break;
-                            case ScanType::UnknownInitialValue:
-                                m_addressValuePairs.push_back({memBase + i - stride, memValue});
-                                break;
-                        }
-
-                        memValue = 0;
-                    }
+            auto& scanner = g_emulator->m_memoryScanner;
+            const auto valueType = scanner->empty() ? m_scanValueType : scanner->valueType();
+            const auto stride = MemoryScanner::stride(valueType);
 
-                    const uint8_t currentByte = memData[i];
-                    const uint8_t leftShift = 8 * (i % stride);
-                    const uint32_t mask = 0xffffffff ^ (0xff << leftShift);
-                    const int byteToWrite = currentByte << leftShift;
-                    memValue = (memValue & mask) | byteToWrite;
-                    memValue = getValueAsSelectedType(memValue);
-                }
+            if (scanner->empty() && ImGui::Button(_("First scan"))) {
+                m_frozen.clear();
+                scanner->firstScan(memData, memSize, m_scanValueType, m_scanType, m_value);
             }
 
-            if (!m_addressValuePairs.empty() && ImGui::Button(_("Next scan"))) {
-                auto doesntMatchCriterion = [this, memData, memSize, stride](const AddressValuePair& addressValuePair) {
-                    const uint32_t address = addressValuePair.address;
-                    const int64_t memValue =
-                        getValueAsSelectedType(getMemValue(address, memData, memSize, memBase, stride));
-
-                    switch (m_scanType) {
-                        case ScanType::ExactValue:
-                            return memValue != m_value;
-                        case ScanType::GreaterThan:
-                            return memValue <= m_value;
-                        case ScanType::LessThan:
-                            return memValue >= m_value;
-                        case ScanType::Changed:
-                            return memValue == addressValuePair.scannedValue;
-                        case ScanType::Unchanged:
-                            return memValue != addressValuePair.scannedValue;
-                        case ScanType::Increased:
-                            return memValue <= addressValuePair.scannedValue;
-                        case ScanType::Decreased:
-                            return memValue >= addressValuePair.scannedValue;
-                        case ScanType::UnknownInitialValue:
-                            return true;
-                    }
-
-                    return true;
-                };
-
-                std::erase_if(m_addressValuePairs, doesntMatchCriterion);
-
-                if (m_addressValuePairs.empty()) {
-                    m_scanType = ScanType::ExactValue;
-                } else {
-                    for (auto& addressValuePair : m_addressValuePairs) {
-                        addressValuePair.scannedValue = getValueAsSelectedType(
-                            getMemValue(addressValuePair.address, memData, memSize, memBase, stride));
-                    }
-                }
+            if (!scanner->empty() && ImGui::Button(_("Next scan"))) {
+                scanner->nextScan(memData, m_scanType, m_value);
+                std::erase_if(m_frozen, [&scanner](const auto& frozen) {
+                    return !scanner->isCandidate(frozen.first - memBase);
+                });
+                if (scanner->empty()) m_scanType = MemoryScanner::ScanType::ExactValue;
             }
 
-            if (!m_addressValuePairs.empty() && ImGui::Button(_("New scan"))) {
-                m_addressValuePairs.clear();
-                m_scanType = ScanType::ExactValue;
+            if (!scanner->empty() && ImGui::Button(_("New scan"))) {
+                scanner->reset();
+                m_frozen.clear();
+                m_scanType = MemoryScanner::ScanType::ExactValue;
             }
 
             ImGui::Checkbox(_("Hex"), &m_hex);
             ImGui::InputScalar(_("Value"), ImGuiDataType_S64, &m_value, NULL, NULL, m_hex ? "%x" : "%i",
                                m_hex ? ImGuiInputTextFlags_CharsHexadecimal : ImGuiInputTextFlags_CharsDecimal);
-            m_value = getValueAsSelectedType(m_value);
+            m_value = MemoryScanner::truncate(valueType, m_value);
 
-            const auto currentScanValueType = magic_enum::enum_name(m_scanValueType);
+            // The value type can't change in the middle of a search.
+            ImGui::BeginDisabled(!scanner->empty());
+            const auto currentScanValueType = magic_enum::enum_name(valueType);
             if (ImGui::BeginCombo(_("Value type"), currentScanValueType.data())) {
-                for (auto v : magic_enum::enum_values<ScanValueType>()) {
+                for (auto v : magic_enum::enum_values<MemoryScanner::ValueType>()) {
                     bool selected = (v == m_scanValueType);
                     auto name = magic_enum::enum_name(v);
                     if (ImGui::Selectable(name.data(), selected)) {
@@ -304,10 +240,11 @@ void PCSX::Widgets::MemoryObserver::draw(const char* title) {
                 }
                 ImGui::EndCombo();
             }
+            ImGui::EndDisabled();
 
             const auto currentScanType = magic_enum::enum_name(m_scanType);
             if (ImGui::BeginCombo(_("Scan type"), currentScanType.data())) {
-                for (auto v : magic_enum::enum_values<ScanType>()) {
+                for (auto v : magic_enum::enum_values<MemoryScanner::ScanType>()) {
                     bool selected = (v == m_scanType);
                     auto name = magic_enum::enum_name(v);
                     if (ImGui::Selectable(name.data(), selected)) {
@@ -333,20 +270,19 @@ void PCSX::Widgets::MemoryObserver::draw(const char* title) {
                 ImGui::TableSetupColumn(_("Write breakpoint"));
                 ImGui::TableHeadersRow();
 
-                bool as_uint = (m_scanValueType == ScanValueType::Uint);
+                bool as_uint = (valueType == MemoryScanner::ValueType::Uint);
                 const auto valueDisplayFormat =
                     m_hex ? "%x"
                           : (m_fixedPoint && stride > 1) ? (as_uint ? "%u.%u" : "%i.%i") : (as_uint ? "%u" : "%i");
 
                 ImGuiListClipper clipper;
-                clipper.Begin(m_addressValuePairs.size());
+                clipper.Begin(scanner->size());
                 while (clipper.Step()) {
                     for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
-                        auto& addressValuePair = m_addressValuePairs[row];
-                        const uint32_t currentAddress = addressValuePair.address;
-                        const auto memValue =
-                            getValueAsSelectedType(getMemValue(currentAddress, memData, memSize, memBase, stride));
-                        const auto scannedValue = addressValuePair.scannedValue;
+                        const uint32_t offset = scanner->candidate(row);
+                        const uint32_t currentAddress = memBase + offset;
+                        const auto memValue = MemoryScanner::read(valueType, memData, offset);
+                        const auto scannedValue = scanner->scannedValue(offset);
                         const bool displayAsFixedPoint = !m_hex && m_fixedPoint && stride > 1;
 
                         ImGui::TableNextRow();
@@ -360,8 +296,13 @@ void PCSX::Widgets::MemoryObserver::draw(const char* title) {
                         }
                         ImGui::SameLine();
                         auto CheckboxName = fmt::format(f_("Freeze##{}"), row);
-                        if (ImGui::Checkbox(CheckboxName.c_str(), &addressValuePair.frozen)) {
-                            addressValuePair.frozenValue = memValue;
+                        bool frozen = m_frozen.contains(currentAddress);
+                        if (ImGui::Checkbox(CheckboxName.c_str(), &frozen)) {
+                            if (frozen) {
+                                m_frozen[currentAddress] = memValue;
+                            } else {
+                                m_frozen.erase(currentAddress);
+                            }
                         }
                         ImGui::TableSetColumnIndex(2);
                         if (displayAsFixedPoint) {
@@ -455,68 +396,6 @@ void PCSX::Widgets::MemoryObserver::draw(const char* title) {
     ImGui::End();
 }
 
-uint8_t PCSX::Widgets::MemoryObserver::getStrideFromValueType(ScanValueType valueType) {
-    switch (valueType) {
-        case ScanValueType::Char:
-        case ScanValueType::Uchar:
-            return 1;
-        case ScanValueType::Short:
-        case ScanValueType::Ushort:
-            return 2;
-        case ScanValueType::Int:
-        case ScanValueType::Uint:
-            return 4;
-        default:
-            throw std::runtime_error("Invalid value type.");
-    }
-}
-
-int64_t PCSX::Widgets::MemoryObserver::getValueAsSelectedType(int64_t memValue) {
-    switch (m_scanValueType) {
-        case ScanValueType::Char:
-            int8_t char_val;
-            memcpy(&char_val, &memValue, 1);
-            return char_val;
-        case ScanValueType::Uchar:
-            uint8_t uchar_val;
-            memcpy(&uchar_val, &memValue, 1);
-            return uchar_val;
-        case ScanValueType::Short:
-            short short_val;
-            memcpy(&short_val, &memValue, 2);
-            return short_val;
-        case ScanValueType::Ushort:
-            unsigned short ushort_val;
-            memcpy(&ushort_val, &memValue, 2);
-            return ushort_val;
-        case ScanValueType::Int:
-            int int_val;
-            memcpy(&int_val, &memValue, 4);
-            return int_val;
-        case ScanValueType::Uint:
-            unsigned int uint_val;
-            memcpy(&uint_val, &memValue, 4);
-            return uint_val;
-        default:
-            throw std::runtime_error("Invalid value type.");
-    }
-}
-
-int PCSX::Widgets::MemoryObserver::getMemValue(uint32_t absoluteAddress, const uint8_t* memData, uint32_t memSize,
-                                               uint32_t memBase, uint8_t stride) {
-    int memValue = 0;
-    const uint32_t relativeAddress = absoluteAddress - memBase;
-    assert(relativeAddress < memSize);
-    for (uint32_t i = relativeAddress; i < relativeAddress + stride; ++i) {
-        const uint8_t currentByte = memData[i];
-        const uint8_t leftShift = 8 * (i % stride);
-        const uint32_t mask = 0xffffffff ^ (0xff << leftShift);
-        const int byteToWrite = currentByte << leftShift;
-        memValue = (memValue & mask) | byteToWrite;
-    }
-    return memValue;
-}
-
 #ifdef MEMORY_OBSERVER_X86
 // Check if all bytes in a 256-bit vector are equal
 // Broadcasts byte 0 of the vector to 256 bits, then xors the result with the starting vector
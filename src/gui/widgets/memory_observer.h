@@ -23,10 +23,12 @@
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <map>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "core/memory-scanner.h"
 #include "imgui.h"
 #include "support/eventbus.h"
 #if defined(__i386__) || defined(_M_IX86) || defined(__x86_64) || defined(_M_AMD64)
@@ -50,9 +52,6 @@ class MemoryObserver {
     MemoryObserver(bool& show);
 
   private:
-    static int getMemValue(uint32_t absoluteAddress, const uint8_t* memData, uint32_t memSize, uint32_t memBase,
-                           uint8_t stride);
-
     /**
      * Plain search.
      */
@@ -67,32 +66,10 @@ class MemoryObserver {
      * Delta-over-time search.
      */
 
-    enum class ScanType {
-        ExactValue,
-        GreaterThan,
-        LessThan,
-        Changed,
-        Unchanged,
-        Increased,
-        Decreased,
-        UnknownInitialValue
-    };
-
-    enum class ScanValueType { Char, Uchar, Short, Ushort, Int, Uint };
-    static uint8_t getStrideFromValueType(ScanValueType valueType);
-    int64_t getValueAsSelectedType(int64_t memValue);
-
-    struct AddressValuePair {
-        uint32_t address = 0;
-        int64_t scannedValue = 0;
-
-        bool frozen = false;
-        int64_t frozenValue = 0;
-    };
-
-    ScanType m_scanType = ScanType::ExactValue;
-    ScanValueType m_scanValueType = ScanValueType::Short;
-    std::vector<AddressValuePair> m_addressValuePairs;
+    MemoryScanner::ScanType m_scanType = MemoryScanner::ScanType::ExactValue;
+    MemoryScanner::ValueType m_scanValueType = MemoryScanner::ValueType::Short;
+    // Frozen addresses, and the value they're held at.
+    std::map<uint32_t, int64_t> m_frozen;
     bool m_hex = false;
     bool m_fixedPoint = false;
     bool m_useSIMD = false;
@@ -54,6 +54,7 @@ bool PCSX::Widgets::PIOCart::draw(const char* title) {
 
         if (ImGui::Checkbox(_("Connected"), &settings.get<Emulator::SettingPIOConnected>().value)) {
             g_emulator->m_pioCart->setLuts();
+            g_emulator->m_mem->setLuts();
         }
 
         {  // Select EXP1 Dialog
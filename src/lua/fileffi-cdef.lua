@@ -27,6 +27,7 @@ enum FileOps {
     CREATE,
     READWRITE,
     DOWNLOAD_URL,
+    MMAP,
 };
 
 enum SeekWheel {
@@ -87,7 +88,7 @@ bool startFileCachingWithCallback(LuaFile* wrapper, void (*callback)());
 
 LuaFile* dupFile(LuaFile*);
 
-LuaFile* zReader(LuaFile*, int64_t size, bool raw);
+LuaFile* zReader(LuaFile*, int64_t size, bool raw, uint32_t indexSpan);
 
 uint64_t getSliceSize(LuaSlice*);
 const void* getSliceData(LuaSlice*);
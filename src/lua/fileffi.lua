@@ -271,14 +271,16 @@ local function buffer(ptr, size, type)
     return createFileWrapper(f)
 end
 
-local function zReader(file, size, raw)
+local function zReader(file, size, raw, indexSpan)
     if type(size) == 'string' then
+        indexSpan = raw
         raw = size
         size = nil
     end
     raw = raw == 'RAW'
     if size == nil then size = -1 end
-    return createFileWrapper(C.zReader(file._wrapper, size, raw))
+    if indexSpan == nil then indexSpan = 0 end
+    return createFileWrapper(C.zReader(file._wrapper, size, raw, indexSpan))
 end
 
 local function uvFifo(address, port)
@@ -24,6 +24,7 @@
 #include "lua/luawrapper.h"
 #include "support/ffmpeg-audio-file.h"
 #include "support/mem4g.h"
+#include "support/mmapfile.h"
 #include "support/uvfile.h"
 #include "support/zfile.h"
 
@@ -37,6 +38,7 @@ enum FileOps {
     CREATE,
     READWRITE,
     DOWNLOAD_URL,
+    MMAP,
 };
 
 void deleteFile(LuaFile* wrapper) { delete wrapper; }
@@ -53,6 +55,8 @@ LuaFile* openFile(const char* filename, FileOps type) {
             return new LuaFile(new PCSX::UvFile(filename, PCSX::FileOps::READWRITE));
         case DOWNLOAD_URL:
             return new LuaFile(new PCSX::UvFile(filename, PCSX::UvFile::DOWNLOAD_URL));
+        case MMAP:
+            return new LuaFile(new PCSX::MmapFile(filename));
     }
 
     return nullptr;
@@ -162,9 +166,11 @@ bool startFileCachingWithCallback(LuaFile* wrapper, void (*callback)()) {
 
 LuaFile* dupFile(LuaFile* wrapper) { return new LuaFile(wrapper->file->dup()); }
 
-LuaFile* zReader(LuaFile* wrapper, int64_t size, bool raw) {
-    return new LuaFile(raw ? new PCSX::ZReader(wrapper->file, size, PCSX::ZReader::RAW)
-                           : new PCSX::ZReader(wrapper->file, size));
+LuaFile* zReader(LuaFile* wrapper, int64_t size, bool raw, uint32_t indexSpan) {
+    auto reader = raw ? new PCSX::ZReader(wrapper->file, size, PCSX::ZReader::RAW)
+                      : new PCSX::ZReader(wrapper->file, size);
+    if (indexSpan) reader->enableIndex(indexSpan);
+    return new LuaFile(reader);
 }
 
 uint64_t getSliceSize(PCSX::Slice* slice) { return slice->size(); }
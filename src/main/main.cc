@@ -24,6 +24,7 @@
 
 #include "core/arguments.h"
 #include "core/cdrom.h"
+#include "core/cputrace.h"
 #include "core/gpu.h"
 #include "core/logger.h"
 #include "core/psxemulator.h"
@@ -38,11 +39,13 @@
 #include "main/textui.h"
 #include "spu/interface.h"
 #include "support/binpath.h"
+#include "support/instrumentation.h"
 #include "support/uvfile.h"
 #include "support/version.h"
 #include "tracy/Tracy.hpp"
 
-static PCSX::UI *s_ui;
+// Per thread, like g_emulator and g_system, so that several instances can run side by side.
+static thread_local PCSX::UI *s_ui;
 
 class SystemImpl final : public PCSX::System {
     virtual void biosPutc(int c) final override {
@@ -188,6 +191,16 @@ int pcsxMain(int argc, char **argv) {
         return 0;
     }
 
+    // Same, for turning a binary CPU trace into a disassembly listing.
+    if (auto traceFile = args.get<std::string>("decodetrace")) {
+        PCSX::IO<PCSX::File> trace(new PCSX::PosixFile(*traceFile));
+        if (trace->failed() || !PCSX::CPUTrace::decode(trace, std::cout)) {
+            std::cerr << "Unable to decode CPU trace " << *traceFile << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
     // Creating the "system" global object first, making sure anything logging-related is
     // enabled as much as possible.
     SystemImpl *system = new SystemImpl(args);
@@ -286,6 +299,24 @@ int pcsxMain(int argc, char **argv) {
             debugSettings.get<PCSX::Emulator::DebugSettings::GdbServerPort>() = args.get<int>("gdb-port").value();
         }
 
+        // Lets host profilers such as Linux perf see which guest code the dynarec blocks they sampled are from.
+        if (args.get<bool>("perfmap")) {
+            debugSettings.get<PCSX::Emulator::DebugSettings::PerfMap>() = true;
+        }
+        if (args.get<bool>("no-perfmap")) {
+            debugSettings.get<PCSX::Emulator::DebugSettings::PerfMap>() = false;
+        }
+        if (args.get<bool>("jitdump")) {
+            debugSettings.get<PCSX::Emulator::DebugSettings::JitDump>() = true;
+        }
+        if (args.get<bool>("no-jitdump")) {
+            debugSettings.get<PCSX::Emulator::DebugSettings::JitDump>() = false;
+        }
+        // Per-subsystem host time accounting, readable through the web server, Lua, or the GUI.
+        if (args.get<bool>("instrumentation")) {
+            emulator->m_instrumentation->enable();
+        }
+
         auto argPCdrvBase = args.get<std::string>("pcdrvbase");
         if (args.get<bool>("pcdrv")) {
             debugSettings.get<PCSX::Emulator::DebugSettings::PCdrv>() = true;
@@ -303,6 +334,39 @@ int pcsxMain(int argc, char **argv) {
         if (args.get<bool>("interpreter")) {
             emuSettings.get<PCSX::Emulator::SettingDynarec>() = false;
         }
+        if (args.get<bool>("cachedinterpreter")) {
+            emuSettings.get<PCSX::Emulator::SettingDynarec>() = false;
+            emuSettings.get<PCSX::Emulator::SettingCachedInterpreter>() = true;
+        }
+        if (args.get<bool>("fastmem")) {
+            emuSettings.get<PCSX::Emulator::SettingFastmem>() = true;
+        }
+        if (args.get<bool>("no-fastmem")) {
+            emuSettings.get<PCSX::Emulator::SettingFastmem>() = false;
+        }
+        // 1 is the real drive speed, 2 to 16 divide its delays, 0 makes seeks instant.
+        auto argCDSpeedup = args.get<int>("cdspeedup");
+        if (argCDSpeedup.has_value()) {
+            int speedup = argCDSpeedup.value();
+            if ((speedup >= 0) && (speedup <= PCSX::CDRom::c_maxSpeedup)) {
+                emuSettings.get<PCSX::Emulator::SettingCDSpeedup>() = speedup;
+            } else {
+                system->printf("Ignoring -cdspeedup %i, as it needs to be between 0 and %i\n", speedup,
+                               PCSX::CDRom::c_maxSpeedup);
+            }
+        }
+
+        // 0 is off, 1 tracks the memory accesses and the GTE, 2 also tracks the CPU arithmetic.
+        auto argPGXP = args.get<int>("pgxp");
+        if (argPGXP.has_value()) {
+            int mode = argPGXP.value();
+            if ((mode >= 0) && (mode <= 2)) {
+                emulator->config().PGXP_Mode = mode;
+                emulator->config().PGXP_GTE = mode != 0;
+            } else {
+                system->printf("Ignoring -pgxp %i, as it needs to be between 0 and 2\n", mode);
+            }
+        }
 
         if (args.get<bool>("openglgpu")) {
             emuSettings.get<PCSX::Emulator::SettingHardwareRenderer>() = true;
@@ -0,0 +1,106 @@
+/*
+
+MIT License
+
+Copyright (c) 2024 PCSX-Redux authors
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include <stdint.h>
+
+#include "common/hardware/pcsxhw.h"
+
+/* Memory access microbenchmark, driven by tests/pcsxrunner/membench.cc. Each
+   phase runs between two Lua exec slots which time it on the host, and leaves
+   its name and amount of accesses at the end of the scratchpad for them. The
+   first phase only runs nops, as a baseline for the loop overhead. */
+
+#define ITERATIONS 200000
+#define REPEAT16(x) x x x x x x x x x x x x x x x x
+
+static volatile uint32_t* const s_report = (volatile uint32_t*)0x1f8003f8;
+
+static void begin(const char* name) {
+    s_report[0] = (uint32_t)name;
+    s_report[1] = ITERATIONS * 16;
+    pcsx_execSlot(1);
+}
+
+static void end() { pcsx_execSlot(2); }
+
+#define BENCH_READ(name, type, address)             \
+    do {                                            \
+        volatile type* p = (volatile type*)address; \
+        begin(name);                                \
+        for (unsigned i = 0; i < ITERATIONS; i++) { \
+            REPEAT16((void)*p;)                     \
+        }                                           \
+        end();                                      \
+    } while (0)
+
+#define BENCH_WRITE(name, type, address)            \
+    do {                                            \
+        volatile type* p = (volatile type*)address; \
+        begin(name);                                \
+        for (unsigned i = 0; i < ITERATIONS; i++) { \
+            REPEAT16(*p = 0;)                       \
+        }                                           \
+        end();                                      \
+    } while (0)
+
+int main() {
+    begin("nop");
+    for (unsigned i = 0; i < ITERATIONS; i++) {
+        REPEAT16(__asm__ volatile("nop");)
+    }
+    end();
+
+    BENCH_READ("ram lb", uint8_t, 0x80100000);
+    BENCH_READ("ram lh", uint16_t, 0x80100000);
+    BENCH_READ("ram lw", uint32_t, 0x80100000);
+    BENCH_WRITE("ram sb", uint8_t, 0x80100000);
+    BENCH_WRITE("ram sh", uint16_t, 0x80100000);
+    BENCH_WRITE("ram sw", uint32_t, 0x80100000);
+
+    BENCH_READ("kseg1 ram lw", uint32_t, 0xa0100000);
+    BENCH_WRITE("kseg1 ram sw", uint32_t, 0xa0100000);
+
+    BENCH_READ("scratchpad lb", uint8_t, 0x1f800000);
+    BENCH_READ("scratchpad lh", uint16_t, 0x1f800000);
+    BENCH_READ("scratchpad lw", uint32_t, 0x1f800000);
+    BENCH_WRITE("scratchpad sb", uint8_t, 0x1f800000);
+    BENCH_WRITE("scratchpad sh", uint16_t, 0x1f800000);
+    BENCH_WRITE("scratchpad sw", uint32_t, 0x1f800000);
+
+    BENCH_READ("bios lb", uint8_t, 0xbfc00000);
+    BENCH_READ("bios lh", uint16_t, 0xbfc00000);
+    BENCH_READ("bios lw", uint32_t, 0xbfc00000);
+
+    // Timer 2 target, which nothing uses while this runs.
+    BENCH_READ("hardware lh", uint16_t, 0x1f801128);
+    BENCH_READ("hardware lw", uint32_t, 0x1f801128);
+    BENCH_WRITE("hardware sh", uint16_t, 0x1f801128);
+    BENCH_WRITE("hardware sw", uint32_t, 0x1f801128);
+
+    pcsx_exit(0);
+    while (1)
+        ;
+}
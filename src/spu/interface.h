@@ -80,7 +80,10 @@ class impl final : public SPUInterface {
         }
     }
     uint32_t getCurrentFrames() override { return m_audioOut.getCurrentFrames(); }
-    void waitForGoal(uint32_t goal) override { m_audioOut.waitForGoal(goal); }
+    bool waitForGoal(uint32_t goal, std::chrono::microseconds maxWait) override {
+        return m_audioOut.waitForGoal(goal, maxWait);
+    }
+    uint32_t getBufferFill() override { return m_audioOut.getBufferFill(); }
 
   private:
     struct ADSRFlags {
@@ -265,6 +268,7 @@ class impl final : public SPUInterface {
     int iReverbOff = -1;  // some delay factor for reverb
     int iReverbRepeat = 0;
     int iReverbNum = 1;
+    int iReverbCnt = 0;  // MixREVERBLeft gets called at 44.1 khz, and works on every second call
 
     // XA
     xa_decode_t *xapGlobal = 0;
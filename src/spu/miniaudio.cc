@@ -19,9 +19,11 @@
 
 #include "spu/miniaudio.h"
 
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
 
+#include "core/psxcounters.h"
 #include "core/system.h"
 #include "spu/interface.h"
 
@@ -30,6 +32,8 @@
 
 PCSX::SPU::MiniAudio::MiniAudio(PCSX::SPU::SettingsType& settings)
     : m_settings(settings), m_listener(g_system->m_eventBus) {
+    static_assert(Counters::MaxAudioSlack * 2 <= VoiceStream::BUFFER_SIZE,
+                  "The audio throttling has to start before the voice stream is full");
     for (unsigned i = 0; i <= ma_backend_null; i++) {
         ma_backend b = ma_backend(i);
         if (ma_is_backend_enabled(b)) {
@@ -182,26 +186,25 @@ void PCSX::SPU::MiniAudio::callback(ma_device* device, float* output, ma_uint32
     if (frameCount > VoiceStream::BUFFER_SIZE) {
         throw std::runtime_error("Too many frames requested by miniaudio");
     }
-    static std::array<Buffer, STREAMS> buffers;
     const bool mono = m_settings.get<Mono>();
     const bool muted = m_settings.get<Mute>();
 
     static_assert(STREAMS == 2);
 
     for (unsigned i = 0; i < STREAMS; i++) {
-        size_t a = i == 0 ? m_voicesStream.dequeue(buffers[i].data(), frameCount)
-                          : m_audioStream.dequeue(buffers[i].data(), frameCount);
+        size_t a = i == 0 ? dequeueVoices(m_buffers[i].data(), frameCount)
+                          : m_audioStream.dequeue(m_buffers[i].data(), frameCount);
         for (size_t f = (muted ? 0 : a); f < frameCount; f++) {
             // maybe warn about underflow? tho it's fine if it happens on stream 1 (cdda)
-            buffers[i][f] = {};
+            m_buffers[i][f] = {};
         }
     }
 
     for (ma_uint32 f = 0; f < frameCount; f++) {
         float l = 0.0f, r = 0.0f;
         for (unsigned i = 0; i < STREAMS; i++) {
-            l += static_cast<float>(buffers[i][f].L) / static_cast<float>(std::numeric_limits<int16_t>::max());
-            r += static_cast<float>(buffers[i][f].R) / static_cast<float>(std::numeric_limits<int16_t>::max());
+            l += static_cast<float>(m_buffers[i][f].L) / static_cast<float>(std::numeric_limits<int16_t>::max());
+            r += static_cast<float>(m_buffers[i][f].R) / static_cast<float>(std::numeric_limits<int16_t>::max());
         }
 
         if (mono) {
@@ -219,20 +222,44 @@ void PCSX::SPU::MiniAudio::callback(ma_device* device, float* output, ma_uint32
     callbackNull(device, output, frameCount);
 }
 
+size_t PCSX::SPU::MiniAudio::dequeueVoices(Frame* dest, size_t frameCount) {
+    constexpr float half = VoiceStream::BUFFER_SIZE / 2.0f;
+    const float fill = m_voicesStream.buffered();
+    const float ratio = 1.0f + c_maxRateDelta * std::clamp((fill - half) / half, -1.0f, 1.0f);
+    m_ratePhase += frameCount * ratio;
+    size_t wanted = std::min<size_t>(m_ratePhase, VoiceStream::BUFFER_SIZE - 1);
+    m_ratePhase -= wanted;
+
+    // The first input frame is the last one from the previous callback, so the
+    // interpolation is continuous across buffers.
+    Frame* input = m_rateInput.data();
+    input[0] = m_lastVoiceFrame;
+    size_t a = m_voicesStream.dequeue(input + 1, wanted);
+    if (a == 0) return 0;
+    m_lastVoiceFrame = input[a];
+
+    // On underruns, play what we have as is and let the caller pad with silence.
+    if (a < wanted) {
+        std::copy(input + 1, input + 1 + a, dest);
+        return a;
+    }
+
+    const float step = static_cast<float>(a) / frameCount;
+    for (size_t f = 0; f < frameCount; f++) {
+        float pos = (f + 1) * step;
+        size_t i = std::min<size_t>(pos, a - 1);
+        float frac = pos - i;
+        dest[f].L = static_cast<int16_t>(input[i].L + (input[i + 1].L - input[i].L) * frac);
+        dest[f].R = static_cast<int16_t>(input[i].R + (input[i + 1].R - input[i].R) * frac);
+    }
+    return frameCount;
+}
+
 void PCSX::SPU::MiniAudio::callbackNull(ma_device* device, float* output, ma_uint32 frameCount) {
     m_frameCount.store(frameCount);
 
     auto total = m_frames.fetch_add(frameCount);
 
-#if HAS_ATOMIC_WAIT
-    auto goalpost = m_goalpost.load();
-    if (goalpost == m_previousGoalpost) return;
-
-    if (((int32_t)(goalpost - total)) > 0) return;
-    m_previousGoalpost = goalpost;
-    m_triggered++;
-    m_triggered.notify_one();
-#else
     std::unique_lock<std::mutex> l(m_mu);
     auto goalpost = m_goalpost;
     if (goalpost == m_previousGoalpost) return;
@@ -241,5 +268,4 @@ void PCSX::SPU::MiniAudio::callbackNull(ma_device* device, float* output, ma_uin
     m_previousGoalpost = goalpost;
     m_triggered++;
     m_cv.notify_one();
-#endif
 }
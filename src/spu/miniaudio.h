@@ -23,6 +23,9 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -39,12 +42,6 @@
 #include "support/circular.h"
 #include "support/eventbus.h"
 
-#if defined(_MSC_VER) || defined(__linux__)
-#define HAS_ATOMIC_WAIT 1
-#else
-#define HAS_ATOMIC_WAIT 0
-#endif
-
 namespace PCSX {
 namespace SPU {
 
@@ -90,20 +87,15 @@ class MiniAudio {
         }
     }
     uint32_t getCurrentFrames() { return m_frames.load(); }
-    void waitForGoal(uint32_t goal) {
-#if HAS_ATOMIC_WAIT
-        // for once, Visual Studio is better than clang/gcc/libc++/libstdc++. Its C++20
-        // support contain the appropriate wait/notify on atomics, so we can do this:
-        auto triggered = m_triggered.load();
-        m_goalpost.store(goal);
-        m_triggered.wait(triggered);
-#else
-        // and until the rest of the world catches on, we'll have to do this instead:
+    // Frames queued up in the voices stream.
+    uint32_t getBufferFill() { return m_voicesStream.buffered(); }
+    // Blocks until the audio device has played up to goal, or until maxWait
+    // has elapsed, whichever comes first. Returns false on timeout.
+    bool waitForGoal(uint32_t goal, std::chrono::microseconds maxWait) {
         std::unique_lock<std::mutex> l(m_mu);
         auto triggered = m_triggered;
         m_goalpost = goal;
-        m_cv.wait(l, [this, triggered]() { return m_triggered != triggered; });
-#endif
+        return m_cv.wait_for(l, maxWait, [this, triggered]() { return m_triggered != triggered; });
     }
 
   private:
@@ -114,6 +106,7 @@ class MiniAudio {
     void init(bool safe = false);
     void uninit();
     void maybeRestart();
+    size_t dequeueVoices(Frame* dest, size_t frameCount);
 
     ma_context m_context;
     ma_device_config m_config;
@@ -127,16 +120,21 @@ class MiniAudio {
     VoiceStream m_voicesStream;
     Circular<Frame, 16 * 1024> m_audioStream;
     typedef std::array<Frame, VoiceStream::BUFFER_SIZE> Buffer;
+    std::array<Buffer, STREAMS> m_buffers;
     std::atomic<uint32_t> m_frames = 0;
-#if HAS_ATOMIC_WAIT
-    std::atomic<uint32_t> m_goalpost = 0;
-    std::atomic<uint32_t> m_triggered = 0;
-#else
+
+    // Dynamic rate control: the voices stream gets played up to 0.5% faster or
+    // slower depending on how far its fill level is from the halfway mark, so a
+    // mixer thread held up by the host drains the buffer slower instead of
+    // running it dry.
+    static constexpr float c_maxRateDelta = 0.005f;
+    float m_ratePhase = 0.0f;
+    Frame m_lastVoiceFrame;
+    Buffer m_rateInput;
     uint32_t m_goalpost = 0;
     uint32_t m_triggered = 0;
     std::mutex m_mu;
     std::condition_variable m_cv;
-#endif
     uint32_t m_previousGoalpost = 0;
 
     std::vector<std::string> m_backends;
@@ -209,17 +209,15 @@ int PCSX::SPU::impl::MixREVERBLeft(int ns) {
     if (settings.get<Reverb>() == 0)
         return 0;
     else if (settings.get<Reverb>() == 2) {
-        static int iCnt = 0;  // this func will be called with 44.1 khz
-
         if (!rvb.StartAddr)  // reverb is off
         {
             rvb.iLastRVBLeft = rvb.iLastRVBRight = rvb.iRVBLeft = rvb.iRVBRight = 0;
             return 0;
         }
 
-        iCnt++;
+        iReverbCnt++;
 
-        if (iCnt & 1)  // we work on every second left value: downsample to 22 khz
+        if (iReverbCnt & 1)  // we work on every second left value: downsample to 22 khz
         {
             if (spuCtrl & ControlFlags::ReverbMasterEnable)  // -> reverb on? oki
             {
@@ -910,7 +910,11 @@ void PCSX::SPU::impl::SetupThread() {
     bThreadEnded = 0;
     bSpuInit = 1;  // flag: we are inited
 
-    hMainThread = std::thread([this]() { MainThread(); });
+    // The mixer raises SPU interrupts on the emulator which owns it.
+    hMainThread = std::thread([this, emulator = g_emulator, system = g_system]() {
+        Emulator::ThreadBinding binding(emulator, system);
+        MainThread();
+    });
 }
 
 ////////////////////////////////////////////////////////////////////////
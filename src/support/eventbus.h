@@ -34,6 +34,7 @@ SOFTWARE.
 #include <utility>
 
 #include "support/hashtable.h"
+#include "support/instrumentation.h"
 #include "support/list.h"
 
 namespace PCSX {
@@ -84,6 +85,7 @@ class EventBus {
         using Functor = typename ListenerElement<Event>::Functor;
         auto list = m_table.find(typeid(Event).hash_code());
         if (list == m_table.end()) return;
+        PCSX_INSTRUMENT(Events);
         for (auto& listener : list->list) {
             std::any cb = listener.getCB();
             Functor* func = std::any_cast<Functor*>(cb);
@@ -0,0 +1,64 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "support/instrumentation.h"
+
+#include <chrono>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+thread_local PCSX::Instrumentation* PCSX::Instrumentation::s_current = nullptr;
+
+static uint64_t wallClock() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+uint64_t PCSX::Instrumentation::ticks() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return wallClock();
+#endif
+}
+
+void PCSX::Instrumentation::enable() {
+    if (m_enabled) return;
+    m_frame = {};
+    m_last = ticks();
+    m_frameStartNanoseconds = wallClock();
+    m_enabled = true;
+}
+
+void PCSX::Instrumentation::endFrame() {
+    if (!m_enabled) return;
+    uint64_t now = ticks();
+    charge(now);
+    uint64_t nanoseconds = wallClock();
+    for (auto t : m_frame.ticks) m_frame.totalTicks += t;
+    m_frame.nanoseconds = nanoseconds - m_frameStartNanoseconds;
+    m_lastFrame = m_frame;
+    m_frame = {};
+    m_frameStartNanoseconds = nanoseconds;
+    m_frames++;
+}
@@ -0,0 +1,140 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <string_view>
+
+#include "tracy/Tracy.hpp"
+
+namespace PCSX {
+
+// Host time accounting of the emulator, broken down per subsystem. Scopes are
+// exclusive: time spent in a nested scope is only charged to the innermost one,
+// and anything outside of any scope is charged to the CPU. Only the thread the
+// instance is attached to gets measured, which is the main emulation thread.
+// Timers are always compiled in, unless PCSX_NO_INSTRUMENTATION is defined,
+// but only cost a thread local load and a branch when disabled.
+class Instrumentation {
+  public:
+    enum class Scope : unsigned {
+        CPU,
+        GPU,
+        Rasterizer,
+        SPU,
+        CDROM,
+        DiscIO,
+        MDEC,
+        SIO,
+        Events,
+        Lua,
+        Frontend,
+        Throttle,
+        Count,
+    };
+    static constexpr unsigned c_scopeCount = static_cast<unsigned>(Scope::Count);
+    static constexpr std::array<std::string_view, c_scopeCount> c_scopeNames = {
+        "CPU", "GPU", "Rasterizer", "SPU", "CD-Rom", "Disc I/O", "MDEC", "SIO", "Events", "Lua", "Frontend", "Throttle",
+    };
+
+    struct Frame {
+        std::array<uint64_t, c_scopeCount> ticks = {};
+        std::array<uint64_t, c_scopeCount> calls = {};
+        uint64_t totalTicks = 0;
+        // Wall time of the frame, to convert ticks into actual time.
+        uint64_t nanoseconds = 0;
+        double toMicroseconds(uint64_t t) const {
+            return totalTicks ? double(t) * double(nanoseconds) / double(totalTicks) / 1000.0 : 0.0;
+        }
+    };
+
+    static Instrumentation* current() { return s_current; }
+    static void setCurrent(Instrumentation* instrumentation) { s_current = instrumentation; }
+
+    static uint64_t ticks();
+
+    void enable();
+    void disable() { m_enabled = false; }
+    bool isEnabled() const { return m_enabled; }
+
+    // Called once per vsync: closes the current frame and starts the next one.
+    void endFrame();
+    const Frame& lastFrame() const { return m_lastFrame; }
+    uint64_t frames() const { return m_frames; }
+
+    class Timer {
+      public:
+        explicit Timer(Scope scope) {
+            auto instrumentation = s_current;
+            if (!instrumentation || !instrumentation->m_enabled) return;
+            m_instrumentation = instrumentation;
+            instrumentation->enter(scope);
+        }
+        ~Timer() {
+            if (m_instrumentation) m_instrumentation->leave();
+        }
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+      private:
+        Instrumentation* m_instrumentation = nullptr;
+    };
+
+  private:
+    static constexpr unsigned c_maxDepth = 16;
+
+    void charge(uint64_t now) {
+        m_frame.ticks[static_cast<unsigned>(m_stack[m_depth < c_maxDepth ? m_depth : c_maxDepth - 1])] +=
+            now - m_last;
+        m_last = now;
+    }
+    void enter(Scope scope) {
+        charge(ticks());
+        m_frame.calls[static_cast<unsigned>(scope)]++;
+        if (++m_depth < c_maxDepth) m_stack[m_depth] = scope;
+    }
+    void leave() {
+        charge(ticks());
+        m_depth--;
+    }
+
+    static thread_local Instrumentation* s_current;
+
+    bool m_enabled = false;
+    unsigned m_depth = 0;
+    std::array<Scope, c_maxDepth> m_stack = {Scope::CPU};
+    uint64_t m_last = 0;
+    uint64_t m_frameStartNanoseconds = 0;
+    uint64_t m_frames = 0;
+    Frame m_frame;
+    Frame m_lastFrame;
+};
+
+}  // namespace PCSX
+
+#if defined(PCSX_NO_INSTRUMENTATION)
+#define PCSX_INSTRUMENT(scope)
+#else
+#define PCSX_INSTRUMENT(scope)         \
+    ZoneScopedN("PCSX::" #scope);      \
+    PCSX::Instrumentation::Timer pcsxInstrumentationTimer(PCSX::Instrumentation::Scope::scope)
+#endif
@@ -0,0 +1,78 @@
+/*
+
+MIT License
+
+Copyright (c) 2024 PCSX-Redux authors
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "support/mmapfile.h"
+
+std::shared_ptr<PCSX::MmapFile::Mapping> PCSX::MmapFile::map(const std::filesystem::path& filename) {
+    int fd = ::open(reinterpret_cast<const char*>(filename.u8string().c_str()), O_RDONLY);
+    if (fd < 0) return nullptr;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    auto mapping = std::make_shared<Mapping>();
+    mapping->size = st.st_size;
+    // Empty files can't be mapped, but are still valid files.
+    if (mapping->size) {
+        void* data = mmap(nullptr, mapping->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) mapping.reset();
+        if (mapping) mapping->data = static_cast<const uint8_t*>(data);
+    }
+    // The mapping holds its own reference to the file.
+    ::close(fd);
+    return mapping;
+}
+
+PCSX::MmapFile::Mapping::~Mapping() {
+    if (data) munmap(const_cast<uint8_t*>(data), size);
+}
+
+void PCSX::MmapFile::advise(Access access) {
+    if (!m_mapping || !m_mapping->data) return;
+    int advice = MADV_NORMAL;
+    switch (access) {
+        case Access::NORMAL:
+            advice = MADV_NORMAL;
+            break;
+        case Access::SEQUENTIAL:
+            advice = MADV_SEQUENTIAL;
+            break;
+        case Access::RANDOM:
+            advice = MADV_RANDOM;
+            break;
+    }
+    madvise(const_cast<uint8_t*>(m_mapping->data), m_mapping->size, advice);
+}
+
+#endif
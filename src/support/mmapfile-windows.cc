@@ -0,0 +1,73 @@
+/*
+
+MIT License
+
+Copyright (c) 2024 PCSX-Redux authors
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#if defined(_WIN32) || defined(_WIN64)
+
+#include "support/mmapfile.h"
+#include "support/windowswrapper.h"
+
+std::shared_ptr<PCSX::MmapFile::Mapping> PCSX::MmapFile::map(const std::filesystem::path& filename) {
+    HANDLE file = CreateFileW(filename.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return nullptr;
+    }
+    auto mapping = std::make_shared<Mapping>();
+    mapping->size = static_cast<size_t>(size.QuadPart);
+    // Empty files can't be mapped, but are still valid files.
+    if (mapping->size) {
+        mapping->handle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* data = mapping->handle ? MapViewOfFile(mapping->handle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (data) {
+            mapping->data = static_cast<const uint8_t*>(data);
+        } else {
+            mapping.reset();
+        }
+    }
+    // The mapping holds its own reference to the file.
+    CloseHandle(file);
+    return mapping;
+}
+
+PCSX::MmapFile::Mapping::~Mapping() {
+    if (data) UnmapViewOfFile(data);
+    if (handle) CloseHandle(handle);
+}
+
+void PCSX::MmapFile::advise(Access access) {
+    if (!m_mapping || !m_mapping->data) return;
+    // There is no equivalent to the other hints.
+    if (access != Access::SEQUENTIAL) return;
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = const_cast<uint8_t*>(m_mapping->data);
+    range.NumberOfBytes = m_mapping->size;
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+#endif
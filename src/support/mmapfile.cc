@@ -0,0 +1,74 @@
+/*
+
+MIT License
+
+Copyright (c) 2024 PCSX-Redux authors
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "support/mmapfile.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+
+PCSX::MmapFile::MmapFile(const std::filesystem::path& filename, Access access)
+    : File(RO_SEEKABLE), m_filename(filename), m_mapping(map(filename)) {
+    if (m_mapping && (access != Access::NORMAL)) advise(access);
+}
+
+ssize_t PCSX::MmapFile::rSeek(ssize_t pos, int wheel) {
+    switch (wheel) {
+        case SEEK_SET:
+            m_ptrR = pos;
+            break;
+        case SEEK_END:
+            m_ptrR = size() + pos;
+            break;
+        case SEEK_CUR:
+            m_ptrR += pos;
+            break;
+    }
+    return m_ptrR;
+}
+
+ssize_t PCSX::MmapFile::read(void* dest, size_t size) {
+    ssize_t ret = readAt(dest, size, m_ptrR);
+    if (ret > 0) m_ptrR += ret;
+    return ret;
+}
+
+ssize_t PCSX::MmapFile::readAt(void* dest, size_t size, size_t ptr) {
+    if (!m_mapping) return -1;
+    if (ptr >= m_mapping->size) return -1;
+    size = std::min(size, m_mapping->size - ptr);
+    memcpy(dest, m_mapping->data + ptr, size);
+    return size;
+}
+
+PCSX::Slice PCSX::MmapFile::borrow(size_t size, size_t pos) {
+    Slice slice;
+    if (!m_mapping || (pos >= m_mapping->size)) return slice;
+    size = std::min({size, m_mapping->size - pos, size_t(std::numeric_limits<uint32_t>::max())});
+    slice.borrow(m_mapping->data + pos, size);
+    return slice;
+}
@@ -0,0 +1,89 @@
+/*
+
+MIT License
+
+Copyright (c) 2024 PCSX-Redux authors
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <filesystem>
+#include <memory>
+
+#include "support/file.h"
+
+namespace PCSX {
+
+// Read-only file backed by a memory mapping of the whole file, so that reads
+// are plain copies out of the page cache, and views over the data can be
+// handed out without any copy at all. The mapping is shared with the files
+// created through dup(), and goes away with the last of them.
+class MmapFile : public File {
+  public:
+    // Paging hints given to the kernel, mapped to madvise on POSIX systems,
+    // and to a prefetch of the whole file for sequential access on Windows.
+    enum class Access { NORMAL, SEQUENTIAL, RANDOM };
+
+    MmapFile(const std::filesystem::path& filename, Access access = Access::NORMAL);
+
+    virtual ssize_t rSeek(ssize_t pos, int wheel) final override;
+    virtual ssize_t rTell() final override { return m_ptrR; }
+    virtual size_t size() final override { return m_mapping ? m_mapping->size : 0; }
+    virtual ssize_t read(void* dest, size_t size) final override;
+    virtual ssize_t readAt(void* dest, size_t size, size_t ptr) final override;
+    virtual bool eof() final override { return m_ptrR >= size(); }
+    virtual File* dup() final override { return new MmapFile(m_mapping, m_filename); }
+    virtual bool failed() final override { return !m_mapping; }
+    virtual std::filesystem::path filename() final override { return m_filename; }
+    virtual int getc() final override {
+        if (m_ptrR >= size()) return -1;
+        return m_mapping->data[m_ptrR++];
+    }
+
+    // Zero-copy view over the mapped pages. The slice borrows the memory, so
+    // it's only valid for as long as this file, or one of its dups, is alive.
+    // Views are clamped to the end of the file, and to 4GB.
+    Slice borrow(size_t size, size_t pos);
+    const uint8_t* data() const { return m_mapping ? m_mapping->data : nullptr; }
+
+    void advise(Access access);
+
+  private:
+    struct Mapping {
+        ~Mapping();
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        void* handle = nullptr;
+    };
+    static std::shared_ptr<Mapping> map(const std::filesystem::path& filename);
+    MmapFile(std::shared_ptr<Mapping> mapping, const std::filesystem::path& filename)
+        : File(RO_SEEKABLE), m_filename(filename), m_mapping(mapping) {}
+    virtual void closeInternal() final override { m_mapping.reset(); }
+
+    const std::filesystem::path m_filename;
+    std::shared_ptr<Mapping> m_mapping;
+    size_t m_ptrR = 0;
+};
+
+}  // namespace PCSX
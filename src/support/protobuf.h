@@ -475,6 +475,8 @@ struct FieldPtr<FieldType, irqus::typestring<C...>, fieldNumberValue> {
     constexpr void deserialize(InSlice *slice, unsigned wireType) { copy.deserialize(slice, wireType); }
     constexpr void reset() {}
     constexpr void commit() {
+        // Fields absent from the input leave their destination untouched.
+        if (!copy.value) return;
         FieldType *field = reinterpret_cast<FieldType *>(&ref);
         field->copyFrom(copy.value);
     }
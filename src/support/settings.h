@@ -364,6 +364,14 @@ struct Settings : private std::tuple<settings...> {
         if (!L.isfunction()) return 0;
         L.copy(-5);
         L.pcall(1);
+        // The owner of the Lua state can register a function there, to be
+        // told about any setting written from Lua.
+        L.getfield("SettingsChanged", LUA_REGISTRYINDEX);
+        if (L.isfunction()) {
+            L.pcall();
+        } else {
+            L.pop();
+        }
         return 0;
     }
     static int lua_pairswrapper(lua_State *L_) {
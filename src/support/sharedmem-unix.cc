@@ -27,24 +27,88 @@ SOFTWARE.
 #if !defined(_WIN32) && !defined(_WIN64)
 
 #include <assert.h>
+#include <dirent.h>
+#include <errno.h>
 #include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/file.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <mutex>
+#include <string_view>
+
 #include "support/sharedmem.h"
 
+namespace {
+
+// Content objects are reference counted through flock: every process using
+// one holds a shared lock on it for as long as it does, and whoever manages
+// to turn theirs into an exclusive one is the last user left, and removes
+// the object. The kernel drops the locks of processes that crash, so they
+// don't keep anything alive. Systems which can't flock shared memory objects,
+// such as macOS, fall back to the creator removing the object when it exits.
+bool lockShared(int fd) { return flock(fd, LOCK_SH | LOCK_NB) == 0; }
+bool isLastUser(int fd) { return flock(fd, LOCK_EX | LOCK_NB) == 0; }
+
+// Removes the objects left behind by processes which crashed before they
+// could unlink them: the ones named after a process that is gone, and the
+// content ones nobody holds a lock on anymore. Only Linux lists the shared
+// memory objects anywhere.
+void cleanupStaleObjects() {
+#ifdef __linux__
+    constexpr std::string_view prefix = "pcsx-redux-";
+    DIR* dir = opendir("/dev/shm");
+    if (!dir) return;
+    while (auto entry = readdir(dir)) {
+        std::string_view name = entry->d_name;
+        if (!name.starts_with(prefix)) continue;
+        // Either <id>-<pid>, or <id>-<crc>-<size> for content objects.
+        std::string_view rest = name.substr(prefix.size());
+        auto idEnd = rest.find('-');
+        if (idEnd == std::string_view::npos) continue;
+        rest = rest.substr(idEnd + 1);
+        std::string nameStr(name);
+        if (rest.find('-') == std::string_view::npos) {
+            char* end;
+            long pid = strtol(std::string(rest).c_str(), &end, 10);
+            if ((*end == 0) && (pid > 0) && (kill(pid, 0) < 0) && (errno == ESRCH)) shm_unlink(nameStr.c_str());
+        } else {
+            int fd = shm_open(nameStr.c_str(), O_RDONLY, 0);
+            if (fd < 0) continue;
+            if (isLastUser(fd)) shm_unlink(nameStr.c_str());
+            close(fd);
+        }
+    }
+    closedir(dir);
+#endif
+}
+
+void cleanupStaleObjectsOnce() {
+    static std::once_flag once;
+    std::call_once(once, cleanupStaleObjects);
+}
+
+}  // namespace
+
 bool PCSX::SharedMem::init(const char* id, size_t size, bool initToZero) {
     assert(m_mem == nullptr);
     bool doRawAlloc = true;
     m_size = size;
     // Try to create a shared memory mapping, if an ID is provided
     if (id != nullptr) {
+        cleanupStaleObjectsOnce();
         // Build the full name to share as
         m_sharedName = getSharedName(id, static_cast<uint32_t>(getpid()));
-        // Try to create a shared memory mapping, if a name is provided
-        m_fd = shm_open(m_sharedName.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+        // The name only depends on the pid, so only the first instance of this
+        // process gets to publish its memory; the others would alias it.
+        if (claimSharedName(m_sharedName)) {
+            m_fd = shm_open(m_sharedName.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+        }
         if (m_fd >= 0) {
             // fd is ready, reserve the memory we need
             int result = ftruncate(m_fd, static_cast<off_t>(size));
@@ -70,11 +134,14 @@ bool PCSX::SharedMem::init(const char* id, size_t size, bool initToZero) {
                 }
             }
         }
+        if (m_fd < 0) releaseSharedName(m_sharedName);
     }
     // Alloc memory directly if we opted out or had problems creating the memory map
     if (doRawAlloc) {
-        // calloc will automatically init memory to zero
-        m_mem = (uint8_t*)calloc(size, 1);
+        // Anonymous mappings are zero filled, and page aligned so that
+        // mapFilePrivate can later be used on them
+        void* basePointer = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        m_mem = basePointer != MAP_FAILED ? static_cast<uint8_t*>(basePointer) : nullptr;
     }
 
     // Return false if we had to fall back to a raw alloc
@@ -82,13 +149,124 @@ bool PCSX::SharedMem::init(const char* id, size_t size, bool initToZero) {
 }
 
 PCSX::SharedMem::~SharedMem() {
-    if (m_fd == -1) {
-        free(m_mem);
-    } else {
-        munmap(m_mem, m_size);
+    if (m_mem) munmap(m_mem, m_size);
+    if (m_fd != -1) {
         shm_unlink(m_sharedName.c_str());
         close(m_fd);
+        releaseSharedName(m_sharedName);
+    }
+    releaseContent();
+}
+
+void PCSX::SharedMem::releaseContent() {
+    if (m_contentFd < 0) return;
+    if (m_contentLocked ? isLastUser(m_contentFd) : m_contentCreated) shm_unlink(m_contentName.c_str());
+    close(m_contentFd);
+    m_contentFd = -1;
+    m_contentName.clear();
+}
+
+bool PCSX::SharedMem::mapFilePrivate(int fd, uint64_t offset) {
+    if (isShared() || !m_mem) return false;
+    // MAP_FIXED atomically replaces the pages of the current mapping
+    void* basePointer =
+        mmap(m_mem, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, static_cast<off_t>(offset));
+    if (basePointer == MAP_FAILED) return false;
+    // Whatever content object we were mapping is gone from our view now.
+    releaseContent();
+    return true;
+}
+
+bool PCSX::SharedMem::shareContent(const char* id, size_t size) {
+    if (isShared() || !m_mem) return false;
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
+    size = std::min((size + pageSize - 1) & ~(pageSize - 1), m_size);
+    if (size == 0) return false;
+    cleanupStaleObjectsOnce();
+
+    const std::string name = getContentName(id, size);
+    // Being back to the content we already share doesn't mean we still map it:
+    // every page written to since, if only to reload the very same ROM, is now
+    // a private copy. Redo the mapping from the object we're holding on to.
+    if ((name == m_contentName) && (m_contentFd >= 0)) {
+        bool same = false;
+        void* view = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_contentFd, 0);
+        if (view != MAP_FAILED) {
+            same = memcmp(view, m_mem, size) == 0;
+            munmap(view, size);
+        }
+        if (same) {
+            void* basePointer = mmap(m_mem, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, m_contentFd, 0);
+            if (basePointer != MAP_FAILED) return true;
+        }
+        releaseContent();
+        return false;
     }
+    int fd = -1;
+    bool created = false;
+    bool locked = false;
+    bool valid = false;
+    // Two attempts, in case the first one runs into a stale object.
+    for (int attempt = 0; attempt < 2 && !valid; attempt++) {
+        created = true;
+        fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+        if (fd < 0) {
+            if (errno != EEXIST) return false;
+            created = false;
+            fd = shm_open(name.c_str(), O_RDONLY, 0);
+            if (fd < 0) return false;
+        }
+        // Lock first, so that the last user leaving can't remove it under us.
+        locked = lockShared(fd);
+
+        if (created) {
+            if (ftruncate(fd, static_cast<off_t>(size)) == 0) {
+                void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (view != MAP_FAILED) {
+                    memcpy(view, m_mem, size);
+                    munmap(view, size);
+                    valid = true;
+                }
+            }
+            if (!valid) shm_unlink(name.c_str());
+        } else {
+            // The object may be from a process which is still filling it in,
+            // from a hash collision, or left half written by a crash, so it
+            // needs to match what we have exactly.
+            struct stat st;
+            if ((fstat(fd, &st) == 0) && (static_cast<size_t>(st.st_size) == size)) {
+                void* view = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+                if (view != MAP_FAILED) {
+                    valid = memcmp(view, m_mem, size) == 0;
+                    munmap(view, size);
+                }
+            }
+            // Nobody else using a mismatching object means it's a leftover
+            // from a crash; get rid of it, and try again.
+            if (!valid && locked && isLastUser(fd)) shm_unlink(name.c_str());
+        }
+        if (!valid) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    if (!valid) return false;
+
+    // A private mapping of the shared pages only copies the ones written to.
+    if (mmap(m_mem, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        if (created || (locked && isLastUser(fd))) shm_unlink(name.c_str());
+        close(fd);
+        return false;
+    }
+
+    // The descriptor stays open for as long as we use the object, to hold
+    // on to our lock on it.
+    releaseContent();
+    m_contentFd = fd;
+    m_contentName = name;
+    m_contentCreated = created;
+    m_contentLocked = locked;
+    return true;
 }
 
 #endif
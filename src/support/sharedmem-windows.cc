@@ -37,12 +37,16 @@ bool PCSX::SharedMem::init(const char* id, size_t size, bool initToZero) {
     // Try to create a shared memory mapping, if an id is provided
     if (id != nullptr) {
         // Build the full name to share as
-        std::string fullname = getSharedName(id, static_cast<uint32_t>(GetCurrentProcessId()));
+        m_sharedName = getSharedName(id, static_cast<uint32_t>(GetCurrentProcessId()));
+        // The name only depends on the pid, so only the first instance of this
+        // process gets to publish its memory; the others would alias it.
         // Create the memory mapping handle
-        m_fileHandle =
-            CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<uint32_t>(size >> 32),
-                               static_cast<uint32_t>(size), fullname.c_str());
-        if (m_fileHandle != INVALID_HANDLE_VALUE) {
+        if (claimSharedName(m_sharedName)) {
+            m_fileHandle =
+                CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<uint32_t>(size >> 32),
+                                   static_cast<uint32_t>(size), m_sharedName.c_str());
+        }
+        if (m_fileHandle != nullptr && m_fileHandle != INVALID_HANDLE_VALUE) {
             // Create a view of the memory mapping at 0 offset
             void* basePointer = MapViewOfFileEx(m_fileHandle, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, size, nullptr);
             // Validate success and assign the view to m_mem
@@ -60,6 +64,7 @@ bool PCSX::SharedMem::init(const char* id, size_t size, bool initToZero) {
         } else {
             m_fileHandle = nullptr;
         }
+        if (m_fileHandle == nullptr) releaseSharedName(m_sharedName);
     }
     // Alloc memory directly if we opted out or had problems creating the memory map
     if (doRawAlloc) {
@@ -76,9 +81,17 @@ PCSX::SharedMem::~SharedMem() {
         m_mem = nullptr;
         CloseHandle(m_fileHandle);
         m_fileHandle = nullptr;
+        releaseSharedName(m_sharedName);
     } else {
         free(m_mem);
     }
 }
 
+// Mapping a view at a fixed address requires releasing the existing memory
+// first, which another thread could race for; just let the caller read it in.
+bool PCSX::SharedMem::mapFilePrivate(int fd, uint64_t offset) { return false; }
+
+// Same as above, as the shared view would have to take the place of the private memory.
+bool PCSX::SharedMem::shareContent(const char* id, size_t size) { return false; }
+
 #endif
@@ -26,9 +26,44 @@ SOFTWARE.
 
 #include "support/sharedmem.h"
 
+#include <zlib.h>
+
+#include <algorithm>
+#include <mutex>
+#include <set>
+
 #include "fmt/format.h"
 
+namespace {
+
+std::mutex s_sharedNamesMutex;
+std::set<std::string> s_sharedNames;
+
+}  // namespace
+
+bool PCSX::SharedMem::claimSharedName(const std::string& name) {
+    std::unique_lock<std::mutex> lock(s_sharedNamesMutex);
+    return s_sharedNames.insert(name).second;
+}
+
+void PCSX::SharedMem::releaseSharedName(const std::string& name) {
+    std::unique_lock<std::mutex> lock(s_sharedNamesMutex);
+    s_sharedNames.erase(name);
+}
+
 std::string PCSX::SharedMem::getSharedName(const char* id, uint32_t pid) {
     // Example name: pcsx-redux-wram-37045
     return fmt::format("pcsx-redux-{}-{}", id, pid);
 }
+
+std::string PCSX::SharedMem::getContentName(const char* id, size_t size) {
+    // Example name: pcsx-redux-bios-1b1d2fc5-80000
+    // Kept short, as some systems limit these names to 31 characters.
+    uLong crc = crc32(0L, Z_NULL, 0);
+    for (size_t offset = 0; offset < size;) {
+        const uInt chunk = static_cast<uInt>(std::min<size_t>(size - offset, 1 << 30));
+        crc = crc32(crc, m_mem + offset, chunk);
+        offset += chunk;
+    }
+    return fmt::format("pcsx-redux-{}-{:08x}-{:x}", id, crc, size);
+}
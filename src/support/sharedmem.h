@@ -43,14 +43,46 @@ class SharedMem {
      *  - no ID was given and a raw alloc was performed
      * Returns false if:
      *  - the memory failed to successfully share and defaulted to a raw alloc
+     *  - another instance in this process already shares memory under that ID,
+     *    in which case this one gets a raw alloc instead of aliasing it
      */
     bool init(const char* id, size_t size, bool initToZero);
 
     uint8_t* getPtr() { return m_mem; }
     size_t getSize() { return m_size; }
+    bool isShared() const { return m_fd >= 0 || m_fileHandle != nullptr; }
+
+    /**
+     * Replaces the whole block with a private, copy-on-write view of an opened
+     * file, starting at the given offset, which needs to be page aligned. Pages
+     * are only read from the file once touched, and writes never reach it.
+     * Only possible on raw allocations on POSIX systems; returns false when the
+     * memory was left untouched, in which case the caller has to read it in.
+     * Any content shared through shareContent is released.
+     */
+    bool mapFilePrivate(int fd, uint64_t offset);
+
+    /**
+     * Swaps the first size bytes of a raw allocation, rounded up to whole
+     * pages, for a view shared with every other process holding the very same
+     * content, such as instances running the same BIOS or disc image. The view
+     * is copy-on-write, so writes still only land in this process. Shared
+     * objects are named after a hash of the content, which gets compared byte
+     * for byte before use. Writes turn pages back into private copies, so this
+     * needs calling again once the content is restored, even when unchanged.
+     * Returns false when the memory stays private, which is always the case on
+     * Windows.
+     */
+    bool shareContent(const char* id, size_t size);
 
   private:
     std::string getSharedName(const char* id, uint32_t pid);
+    std::string getContentName(const char* id, size_t size);
+    void releaseContent();
+    // Names of the objects this process publishes, so that several emulator
+    // instances running in the same process don't all map the same one.
+    static bool claimSharedName(const std::string& name);
+    static void releaseSharedName(const std::string& name);
 
   private:
     uint8_t* m_mem = nullptr;
@@ -59,6 +91,12 @@ class SharedMem {
     void* m_fileHandle = nullptr;
     std::string m_sharedName;
     int m_fd = -1;
+    // The content object we're mapping. It gets removed by the last process
+    // using it, and processes already mapping it keep their view anyway.
+    std::string m_contentName;
+    int m_contentFd = -1;
+    bool m_contentCreated = false;
+    bool m_contentLocked = false;
 };
 
 }  // namespace PCSX
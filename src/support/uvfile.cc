@@ -60,6 +60,10 @@ std::atomic<size_t> PCSX::UvThreadOp::s_dataWrittenLastTick;
 std::atomic<size_t> PCSX::UvThreadOp::s_dataDownloadLastTick;
 ConcurrentQueue<PCSX::UvThreadOp::UvRequest> PCSX::UvThreadOp::s_queue;
 PCSX::UvThreadOpListType PCSX::UvThreadOp::s_allOps;
+std::mutex PCSX::UvThreadOp::s_allOpsMutex;
+std::mutex PCSX::UvThreadOp::s_requestMutex;
+std::mutex PCSX::UvThreadOp::s_threadMutex;
+unsigned PCSX::UvThreadOp::s_threadUsers = 0;
 uv_loop_t PCSX::UvThreadOp::s_uvLoop;
 uv_timer_t PCSX::UvThreadOp::s_curlTimeout;
 CURLM *PCSX::UvThreadOp::s_curlMulti = nullptr;
@@ -67,6 +71,16 @@ CURLM *PCSX::UvThreadOp::s_curlMulti = nullptr;
 uint64_t PCSX::UvThreadOp::s_readSequence = 0;
 uint64_t PCSX::UvThreadOp::s_writeSequence = 0;
 
+void PCSX::UvThreadOp::acquireThread() {
+    std::unique_lock<std::mutex> l(s_threadMutex);
+    if (s_threadUsers++ == 0) startThread();
+}
+
+void PCSX::UvThreadOp::releaseThread() {
+    std::unique_lock<std::mutex> l(s_threadMutex);
+    if (--s_threadUsers == 0) stopThread();
+}
+
 void PCSX::UvThreadOp::startThread() {
     if (s_threadRunning) throw std::runtime_error("UV thread already running");
     std::promise<void> barrier;
@@ -209,10 +223,18 @@ void PCSX::UvFile::closeInternal() {
         m_cancelDownload.store(true, std::memory_order_release);
         m_cacheBarrier.get_future().wait();
     } else if (m_cache && (m_cacheProgress.load(std::memory_order_acquire) != 1.0)) {
-        request([this](auto loop) { m_cachePtr = m_size; });
+        request([this](auto loop) {
+            m_cachePtr = m_size;
+            m_shareCache = false;
+        });
         m_cacheBarrier.get_future().wait();
     }
-    free(m_cache);
+    if (m_sharedCache) {
+        m_sharedCache.reset();
+        m_shareCache = false;
+    } else {
+        free(m_cache);
+    }
     m_cache = nullptr;
     m_download = false;
     m_cacheProgress.store(0.0f);
@@ -239,7 +261,7 @@ void PCSX::UvFile::closeUVHandle(uv_file handle, uv_loop_s *loop, PendingCloseIn
 }
 
 void PCSX::UvFile::openwrapper(const char *filename, int flags) {
-    s_allOps.push_back(this);
+    registerOp();
     struct Info {
         std::promise<uv_file> handle;
         std::promise<size_t> size;
@@ -301,7 +323,7 @@ PCSX::UvFile::UvFile(const char *filename, FileOps::ReadWrite) : File(RW_SEEKABL
 PCSX::UvFile::UvFile(const std::string_view &url, std::function<void()> &&callbackDone, uv_loop_t *otherLoop,
                      DownloadUrl)
     : File(RO_SEEKABLE), m_download(true), m_failed(false), m_filename(url) {
-    s_allOps.push_back(this);
+    registerOp();
     std::string urlCopy(url);
     cacheCallbackSetup(std::move(callbackDone), otherLoop);
     request([url = std::move(urlCopy), this](auto loop) {
@@ -718,6 +740,8 @@ bool PCSX::UvFile::eof() { return m_size == m_ptrR; }
 
 void PCSX::UvFile::readCacheChunk(uv_loop_t *loop) {
     if (m_cachePtr >= m_size) {
+        // Cached files are almost always disc images, which other instances may be running too.
+        if (m_shareCache) m_sharedCache->shareContent("cd", m_size);
         m_cacheProgress.store(1.0f, std::memory_order_release);
         if (m_cachingDoneCB) {
             uv_async_send(m_cbAsync);
@@ -758,7 +782,15 @@ void PCSX::UvFile::startCaching(std::function<void()> &&completed, uv_loop_t *lo
     if (m_cache || m_download) throw std::runtime_error("File is already cached");
     cacheCallbackSetup(std::move(completed), loop);
     if (failed()) return;
-    m_cache = reinterpret_cast<uint8_t *>(malloc(m_size));
+    // Files which can't change get cached in pages which can later be shared with other processes.
+    if (!writable() && (m_size >= c_minSharedCacheSize)) {
+        m_sharedCache.reset(new SharedMem());
+        m_sharedCache->init(nullptr, m_size, false);
+        m_cache = m_sharedCache->getPtr();
+        m_shareCache = m_cache != nullptr;
+        if (!m_cache) m_sharedCache.reset();
+    }
+    if (!m_cache) m_cache = reinterpret_cast<uint8_t *>(malloc(m_size));
     request([this](auto loop) { readCacheChunk(loop); });
 }
 
@@ -31,12 +31,15 @@ SOFTWARE.
 #include <atomic>
 #include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 
 #include "cq/concurrent_queue.h"
 #include "support/file.h"
 #include "support/list.h"
+#include "support/sharedmem.h"
 
 namespace PCSX {
 
@@ -46,11 +49,13 @@ typedef Intrusive::List<UvThreadOp> UvThreadOpListType;
 class UvThreadOp : public UvThreadOpListType::Node {
   public:
     enum DownloadUrl { DOWNLOAD_URL };
+    // The uv thread is shared by all of the emulator instances of the process:
+    // the first one to come up starts it, and the last one to go stops it.
     struct UvThread {
         void setEmergencyExit() { m_emergencyExit = true; }
-        UvThread() { PCSX::UvThreadOp::startThread(); }
+        UvThread() { PCSX::UvThreadOp::acquireThread(); }
         ~UvThread() {
-            if (!m_emergencyExit) PCSX::UvThreadOp::stopThread();
+            if (!m_emergencyExit) PCSX::UvThreadOp::releaseThread();
         }
 
       private:
@@ -58,10 +63,13 @@ class UvThreadOp : public UvThreadOpListType::Node {
     };
 
   private:
+    static void acquireThread();
+    static void releaseThread();
     static void startThread();
     static void stopThread();
 
   public:
+    virtual ~UvThreadOp() { unregisterOp(); }
     virtual bool canCache() const = 0;
     void startCaching() { startCaching(nullptr, nullptr); }
     virtual void startCaching(std::function<void()>&& completed, uv_loop_t* loop) {
@@ -72,6 +80,7 @@ class UvThreadOp : public UvThreadOpListType::Node {
     void waitCache() { m_cacheBarrier.get_future().get(); }
 
     static void iterateOverAllOps(std::function<void(UvThreadOp*)> walker) {
+        std::unique_lock<std::mutex> l(s_allOpsMutex);
         for (auto& f : s_allOps) walker(&f);
     }
 
@@ -100,10 +109,24 @@ class UvThreadOp : public UvThreadOpListType::Node {
     static void request(std::function<void(uv_loop_t*)>&& functor) {
         UvRequest req;
         req.functor = std::move(functor);
-        req.sequence = s_writeSequence++;
-        s_queue.Enqueue(std::move(req));
+        {
+            // Several emulator threads may post at once; the sequence numbers
+            // have to reach the queue in order, or the uv thread would stall
+            // waiting for one that got overtaken.
+            std::unique_lock<std::mutex> l(s_requestMutex);
+            req.sequence = s_writeSequence++;
+            s_queue.Enqueue(std::move(req));
+        }
         uv_async_send(&s_kicker);
     }
+    void registerOp() {
+        std::unique_lock<std::mutex> l(s_allOpsMutex);
+        s_allOps.push_back(this);
+    }
+    void unregisterOp() {
+        std::unique_lock<std::mutex> l(s_allOpsMutex);
+        unlink();
+    }
     static CURLM* s_curlMulti;
     static uv_timer_t s_curlTimeout;
 
@@ -128,8 +151,12 @@ class UvThreadOp : public UvThreadOpListType::Node {
     static constexpr uint64_t c_tick = 500;
 
     static UvThreadOpListType s_allOps;
+    static std::mutex s_allOpsMutex;
 
   private:
+    static std::mutex s_requestMutex;
+    static std::mutex s_threadMutex;
+    static unsigned s_threadUsers;
     static ConcurrentQueue<UvRequest> s_queue;
     static uint64_t s_writeSequence;
     static uint64_t s_readSequence;
@@ -218,6 +245,10 @@ class UvFile : public File, public UvThreadOp {
     uv_buf_t m_cacheBuf;
     uv_fs_t m_cacheReq;
     size_t m_cachePtr = 0;
+    // Read-only caches are held in here instead of being malloc'ed.
+    std::unique_ptr<SharedMem> m_sharedCache;
+    bool m_shareCache = false;
+    static constexpr size_t c_minSharedCacheSize = 1024 * 1024;
     struct PendingCloseInfo {
         unsigned pendingWrites = 0;
         bool closePending = false;
@@ -26,6 +26,9 @@ SOFTWARE.
 
 #include "support/zfile.h"
 
+#include <algorithm>
+#include <iterator>
+
 ssize_t PCSX::ZReader::rSeek(ssize_t pos, int wheel) {
     switch (wheel) {
         case SEEK_SET:
@@ -44,47 +47,120 @@ ssize_t PCSX::ZReader::rSeek(ssize_t pos, int wheel) {
     return m_filePtr;
 }
 
-ssize_t PCSX::ZReader::read(void *dest_, size_t size) {
-    uint8_t *dest = reinterpret_cast<uint8_t *>(dest_);
+PCSX::File *PCSX::ZReader::dup() {
+    auto ret = new ZReader(INTERNAL, m_file, m_size, m_raw);
+    ret->m_index = m_index;
+    return ret;
+}
+
+void PCSX::ZReader::enableIndex(size_t span) {
+    if (m_index) return;
+    m_index = std::make_shared<Index>();
+    m_index->span = span;
+}
 
-    ssize_t dumpDelta = m_filePtr - m_zstream.total_out;
-    if (dumpDelta < 0) {
-        dumpDelta = m_filePtr;
-        m_filePtr = 0;
-        m_hitEOF = false;
-        inflateEnd(&m_zstream);
-        m_zstream.avail_in = sizeof(m_inBuffer);
-        m_zstream.next_in = m_inBuffer;
-        inflateInit2(&m_zstream, m_raw ? -MAX_WBITS : MAX_WBITS);
+void PCSX::ZReader::restart() {
+    inflateEnd(&m_zstream);
+    m_zstream.avail_in = 0;
+    inflateInit2(&m_zstream, windowBits());
+    m_outPos = 0;
+    m_inPos = 0;
+    m_hitEOF = false;
+}
+
+bool PCSX::ZReader::restore(const AccessPoint &point) {
+    inflateEnd(&m_zstream);
+    m_zstream.avail_in = 0;
+    // Checkpoints are always past the headers, so the rest is a raw deflate stream.
+    inflateInit2(&m_zstream, -MAX_WBITS);
+    if (point.bits) {
+        uint8_t byte;
+        if (m_file->readAt(&byte, 1, point.in - 1) != 1) {
+            restart();
+            return false;
+        }
+        inflatePrime(&m_zstream, point.bits, byte >> (8 - point.bits));
     }
-    if (m_hitEOF) return -1;
-    auto decompSome = [this](void *dest, ssize_t size) -> ssize_t {
-        m_zstream.avail_out = size;
-        m_zstream.next_out = reinterpret_cast<decltype(m_zstream.next_out)>(dest);
+    inflateSetDictionary(&m_zstream, point.window.data(), point.window.size());
+    m_outPos = point.out;
+    m_inPos = point.in;
+    m_hitEOF = false;
+    return true;
+}
+
+void PCSX::ZReader::addPoint() {
+    auto &points = m_index->points;
+    ssize_t last = points.empty() ? 0 : points.back().out;
+    if ((m_outPos - last) < ssize_t(m_index->span)) return;
+    AccessPoint point;
+    point.out = m_outPos;
+    point.in = m_inPos - m_zstream.avail_in;
+    point.bits = m_zstream.data_type & 7;
+    point.window.resize(c_windowSize);
+    uInt length = c_windowSize;
+    inflateGetDictionary(&m_zstream, point.window.data(), &length);
+    point.window.resize(length);
+    points.push_back(std::move(point));
+}
+
+ssize_t PCSX::ZReader::decompSome(void *dest, size_t size) {
+    m_zstream.avail_out = size;
+    m_zstream.next_out = reinterpret_cast<decltype(m_zstream.next_out)>(dest);
+    while (true) {
         if (!m_zstream.avail_in) {
-            ssize_t block = m_file->readAt(m_inBuffer, sizeof(m_inBuffer), m_zstream.total_in);
+            ssize_t block = m_file->readAt(m_inBuffer.get(), c_inBufferSize, m_inPos);
             if (block < 0) return block;
+            m_inPos += block;
             m_zstream.avail_in = block;
-            m_zstream.next_in = m_inBuffer;
+            m_zstream.next_in = m_inBuffer.get();
         }
-        auto res = inflate(&m_zstream, Z_FINISH);
+        uInt availIn = m_zstream.avail_in;
+        uInt availOut = m_zstream.avail_out;
+        // With an index, stop at each deflate block boundary, the only places
+        // where the inflater's state can be captured.
+        auto res = inflate(&m_zstream, m_index ? Z_BLOCK : Z_NO_FLUSH);
         if ((res < 0) && (res != Z_BUF_ERROR)) {
             return -1;
         }
-        ssize_t delta = size - m_zstream.avail_out;
-        m_filePtr += delta;
-        if (res == Z_STREAM_END) m_hitEOF = true;
-        return delta;
-    };
-    ssize_t ret = 0;
-    while (dumpDelta) {
-        uint8_t dummy[256];
-        ssize_t toDump = std::min(ssize_t(sizeof(dummy)), dumpDelta);
+        m_outPos += availOut - m_zstream.avail_out;
+        if (res == Z_STREAM_END) {
+            m_hitEOF = true;
+            break;
+        }
+        if (m_index && (m_zstream.data_type & 128) && !(m_zstream.data_type & 64)) addPoint();
+        // Keep going until some output shows up, as long as the inflater makes progress.
+        bool progress = (availIn != m_zstream.avail_in) || (availOut != m_zstream.avail_out);
+        if (!progress || (m_zstream.avail_out != size)) break;
+    }
+    return size - m_zstream.avail_out;
+}
+
+ssize_t PCSX::ZReader::read(void *dest_, size_t size) {
+    uint8_t *dest = reinterpret_cast<uint8_t *>(dest_);
+
+    const AccessPoint *point = nullptr;
+    if (m_index) {
+        auto &points = m_index->points;
+        auto next = std::upper_bound(points.begin(), points.end(), m_filePtr,
+                                     [](ssize_t pos, const AccessPoint &point) { return pos < point.out; });
+        if (next != points.begin()) point = &*std::prev(next);
+    }
+    if (point && ((m_filePtr < m_outPos) || (point->out > m_outPos))) {
+        restore(*point);
+    } else if (m_filePtr < m_outPos) {
+        restart();
+    }
+    if (m_hitEOF) return -1;
+
+    while (m_outPos < m_filePtr) {
+        uint8_t dummy[4096];
+        ssize_t toDump = std::min(ssize_t(sizeof(dummy)), m_filePtr - m_outPos);
         ssize_t p = decompSome(dummy, toDump);
         if (p < 0) return p;
-        dumpDelta -= p;
         if (m_hitEOF || !p) break;
     }
+    if (m_outPos != m_filePtr) return 0;
+    ssize_t ret = 0;
     while (size) {
         if (m_hitEOF) break;
         ssize_t p = decompSome(dest, size);
@@ -94,6 +170,7 @@ ssize_t PCSX::ZReader::read(void *dest_, size_t size) {
         ret += p;
         dest += p;
     }
+    m_filePtr += ret;
 
     return ret;
 }
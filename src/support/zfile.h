@@ -28,6 +28,9 @@ SOFTWARE.
 
 #include <zlib.h>
 
+#include <memory>
+#include <vector>
+
 #include "support/file.h"
 
 namespace PCSX {
@@ -47,35 +50,63 @@ class ZReader : public File {
         throw std::runtime_error("Unable to determine file size");
     }
     virtual bool eof() final override { return m_hitEOF; }
-    virtual File* dup() final override { return new ZReader(INTERNAL, m_file, m_size, m_raw); };
+    virtual File* dup() final override;
     virtual bool failed() final override { return m_file->failed(); }
 
+    // Records an inflate checkpoint roughly every `span` bytes of output while
+    // decompressing, so that seeking anywhere already seen only has to inflate
+    // from the closest checkpoint before it, instead of from the beginning of
+    // the stream. Each checkpoint costs up to 32KB of memory. The index is
+    // shared with the readers created by dup().
+    void enableIndex(size_t span = c_defaultIndexSpan);
+    size_t indexPoints() const { return m_index ? m_index->points.size() : 0; }
+
+    static constexpr size_t c_defaultIndexSpan = 1024 * 1024;
+
   private:
+    static constexpr size_t c_inBufferSize = 65536;
+    static constexpr size_t c_windowSize = 32768;
+    struct AccessPoint {
+        ssize_t out;
+        ssize_t in;
+        // Amount of bits of the byte before `in` which still belong to the next block.
+        int bits;
+        std::vector<uint8_t> window;
+    };
+    struct Index {
+        size_t span;
+        std::vector<AccessPoint> points;
+    };
+
     virtual void closeInternal() final override { inflateEnd(&m_zstream); }
     enum Internal { INTERNAL };
     ZReader(Internal, IO<File> file, ssize_t size, bool raw)
-        : File(RO_SEEKABLE), m_file(file), m_size(size), m_raw(raw) {
+        : File(RO_SEEKABLE), m_file(file), m_size(size), m_raw(raw), m_inBuffer(new uint8_t[c_inBufferSize]) {
         auto z = &m_zstream;
         z->zalloc = Z_NULL;
         z->zfree = Z_NULL;
         z->opaque = Z_NULL;
         z->avail_in = 0;
-        int wbits = MAX_WBITS;
-        if (raw) {
-            wbits = -wbits;
-        } else {
-            wbits += 32;
-        }
-        auto res = inflateInit2(z, wbits);
+        auto res = inflateInit2(z, windowBits());
         if (res != Z_OK) throw std::runtime_error("inflateInit2 didn't work");
     }
+    int windowBits() const { return m_raw ? -MAX_WBITS : MAX_WBITS + 32; }
+    void restart();
+    bool restore(const AccessPoint& point);
+    void addPoint();
+    ssize_t decompSome(void* dest, size_t size);
+
     IO<File> m_file;
     z_stream m_zstream;
     ssize_t m_filePtr = 0;
+    // Position of the inflater, in the uncompressed and the compressed stream.
+    ssize_t m_outPos = 0;
+    ssize_t m_inPos = 0;
     ssize_t m_size = 0;
     bool m_hitEOF = false;
     bool m_raw = false;
-    uint8_t m_inBuffer[1024];
+    std::unique_ptr<uint8_t[]> m_inBuffer;
+    std::shared_ptr<Index> m_index;
 };
 
 class ZWriter : public File {
@@ -135,7 +135,10 @@ PCSX::File* PCSX::ZipArchive::openFile(std::string path) {
         if (file.name == path) {
             SubFile* sub = new SubFile(m_file, file.offset, file.compressedSize);
             if (file.compressed) {
-                ret = new ZReader(sub, file.size, ZReader::RAW);
+                auto reader = new ZReader(sub, file.size, ZReader::RAW);
+                // Entries such as disc images get read at random.
+                reader->enableIndex();
+                ret = reader;
             } else {
                 ret = sub;
             }
@@ -27,8 +27,12 @@ SOFTWARE.
 #include "supportpsx/iec-60908b.h"
 
 #include <stdint.h>
+#include <string.h>
 
-#include "iec-60908b/edcecc.h"
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
 
 // Lookup table for crc-16 subq calculation. This is a normal CRC-CCITT.
 static constexpr uint16_t crctab[256] = {
@@ -76,4 +80,176 @@ uint16_t PCSX::IEC60908b::subqCRC(const uint8_t* d, int len) {
     return ~crc;
 }
 
-void PCSX::IEC60908b::computeEDCECC(uint8_t* sector) { compute_edcecc(sector); }
+// This is a table-driven rewrite of the reference implementation found in
+// third_party/iec-60908b/edcecc.c, which has all the details about the maths.
+// The EDC uses slicing-by-8, and the ECC computes all of the lines of a
+// channel at once, so the compiler can vectorize the inner loops.
+
+namespace {
+
+// The yellow book's crc32 polynomial, x³² + x³¹ + x¹⁶ + x¹⁵ + x⁴ + x³ + x + 1, reflected.
+constexpr uint32_t c_edcPoly = 0xd8018001;
+
+// c_edcTables[0] is the usual bytewise lookup table, and c_edcTables[n] is
+// the crc of a byte followed by n zero bytes.
+constexpr std::array<std::array<uint32_t, 256>, 8> generateEDCTables() {
+    std::array<std::array<uint32_t, 256>, 8> tables = {};
+    for (unsigned i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (unsigned j = 0; j < 8; j++) crc = (crc >> 1) ^ ((crc & 1) ? c_edcPoly : 0);
+        tables[0][i] = crc;
+    }
+    for (unsigned i = 0; i < 256; i++) {
+        for (unsigned n = 1; n < 8; n++) tables[n][i] = (tables[n - 1][i] >> 8) ^ tables[0][tables[n - 1][i] & 0xff];
+    }
+    return tables;
+}
+
+constexpr auto c_edcTables = generateEDCTables();
+
+// Multiplication by 2 in GF(2⁸), using the 0x11d polynomial. This is written
+// without any lookup so that it can be vectorized.
+constexpr uint8_t gfMul2(uint8_t x) { return (x << 1) ^ ((x >> 7) * 0x1d); }
+
+constexpr std::array<uint8_t, 256> generateDiv3Table() {
+    std::array<uint8_t, 256> table = {};
+    for (unsigned i = 0; i < 256; i++) {
+        uint8_t mul3 = gfMul2(i) ^ i;
+        table[mul3] = i;
+    }
+    return table;
+}
+
+constexpr auto c_gfDiv3 = generateDiv3Table();
+
+// The Q channel's lines are spread all over the sector, so we precompute the
+// location of each coefficient, ordered by step then by line.
+constexpr unsigned c_pLines = 86;
+constexpr unsigned c_pSteps = 24;
+constexpr unsigned c_qLines = 52;
+constexpr unsigned c_qSteps = 43;
+
+constexpr std::array<uint16_t, c_qLines * c_qSteps> generateQIndices() {
+    std::array<uint16_t, c_qLines * c_qSteps> indices = {};
+    for (unsigned j = 0; j < c_qSteps; j++) {
+        for (unsigned i = 0; i < c_qLines; i++) {
+            indices[j * c_qLines + i] = ((44 * j + 43 * (i / 2)) % 1118) * 2 + (i & 1);
+        }
+    }
+    return indices;
+}
+
+constexpr auto c_qIndices = generateQIndices();
+
+// Finalizes the (low, high) pairs of the long division, and stores them.
+template <unsigned lines>
+void storeECC(const uint8_t* lo, const uint8_t* hi, uint8_t* dstLo, uint8_t* dstHi) {
+    for (unsigned i = 0; i < lines; i++) {
+        uint8_t eccHigh = hi[i];
+        uint8_t eccLow = c_gfDiv3[gfMul2(lo[i]) ^ eccHigh];
+        dstLo[i] = eccLow;
+        dstHi[i] = eccHigh ^ eccLow;
+    }
+}
+
+void computeECC(uint8_t* eccData) {
+    {
+        uint8_t lo[c_pLines] = {};
+        uint8_t hi[c_pLines] = {};
+        for (unsigned j = 0; j < c_pSteps; j++) {
+            const uint8_t* row = eccData + c_pLines * j;
+            for (unsigned i = 0; i < c_pLines; i++) {
+                uint8_t coeff = row[i];
+                lo[i] = gfMul2(lo[i] ^ coeff);
+                hi[i] ^= coeff;
+            }
+        }
+        storeECC<c_pLines>(lo, hi, eccData + c_pSteps * c_pLines, eccData + (c_pSteps + 1) * c_pLines);
+    }
+    {
+        uint8_t lo[c_qLines] = {};
+        uint8_t hi[c_qLines] = {};
+        for (unsigned j = 0; j < c_qSteps; j++) {
+            const uint16_t* indices = c_qIndices.data() + j * c_qLines;
+            for (unsigned i = 0; i < c_qLines; i++) {
+                uint8_t coeff = eccData[indices[i]];
+                lo[i] = gfMul2(lo[i] ^ coeff);
+                hi[i] ^= coeff;
+            }
+        }
+        storeECC<c_qLines>(lo, hi, eccData + 43 * 26 * 2, eccData + 44 * 26 * 2);
+    }
+}
+
+template <typename Getter>
+void parallelize(size_t count, unsigned threads, Getter&& getter) {
+    // Below this, spawning threads costs more than it saves.
+    constexpr size_t c_minSectorsPerThread = 64;
+    if (threads == 0) threads = std::max(std::thread::hardware_concurrency(), 1u);
+    threads = std::min<size_t>(threads, (count + c_minSectorsPerThread - 1) / c_minSectorsPerThread);
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; i++) PCSX::IEC60908b::computeEDCECC(getter(i));
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    size_t chunk = (count + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; t++) {
+        size_t start = t * chunk;
+        size_t end = std::min(count, start + chunk);
+        if (start >= end) break;
+        workers.emplace_back([start, end, &getter]() {
+            for (size_t i = start; i < end; i++) PCSX::IEC60908b::computeEDCECC(getter(i));
+        });
+    }
+    for (auto& worker : workers) worker.join();
+}
+
+}  // namespace
+
+uint32_t PCSX::IEC60908b::computeEDC(const uint8_t* data, size_t len) {
+    auto& t = c_edcTables;
+    uint32_t edc = 0;
+    while (len >= 8) {
+        uint32_t word = edc ^ (data[0] | (data[1] << 8) | (data[2] << 16) | (uint32_t(data[3]) << 24));
+        edc = t[7][word & 0xff] ^ t[6][(word >> 8) & 0xff] ^ t[5][(word >> 16) & 0xff] ^ t[4][word >> 24] ^
+              t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+        data += 8;
+        len -= 8;
+    }
+    while (len--) edc = t[0][(edc ^ *data++) & 0xff] ^ (edc >> 8);
+    return edc;
+}
+
+void PCSX::IEC60908b::computeEDCECC(uint8_t* sector) {
+    uint8_t* location = sector + 12;
+    if (sector[15] != 2) return;
+
+    uint8_t* subheader = sector + 16;
+    bool form2 = subheader[2] & 0x20;
+    unsigned len = (form2 ? 2324 : 2048) + 8;
+
+    uint32_t edc = computeEDC(subheader, len);
+    uint8_t* edcPtr = subheader + len;
+    edcPtr[0] = edc & 0xff;
+    edcPtr[1] = (edc >> 8) & 0xff;
+    edcPtr[2] = (edc >> 16) & 0xff;
+    edcPtr[3] = (edc >> 24) & 0xff;
+
+    if (form2) return;
+
+    // The ECC is computed with a zeroed location field.
+    uint8_t actualLocation[4];
+    memcpy(actualLocation, location, 4);
+    memset(location, 0, 4);
+    computeECC(location);
+    memcpy(location, actualLocation, 4);
+}
+
+void PCSX::IEC60908b::computeEDCECC(uint8_t* sectors, size_t count, unsigned threads) {
+    parallelize(count, threads, [sectors](size_t i) { return sectors + i * FRAMESIZE_RAW; });
+}
+
+void PCSX::IEC60908b::computeEDCECC(uint8_t* const* sectors, size_t count, unsigned threads) {
+    parallelize(count, threads, [sectors](size_t i) { return sectors[i]; });
+}
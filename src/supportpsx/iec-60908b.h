@@ -145,6 +145,15 @@ struct MSF {
 // Compute the EDC and ECC for a mode2 sector.
 void computeEDCECC(uint8_t *sector);
 
+// Compute the EDC and ECC for a batch of mode2 sectors, either contiguous
+// in memory, or scattered. Large batches are spread over several threads;
+// a value of 0 for threads means using all of the available cores.
+void computeEDCECC(uint8_t *sectors, size_t count, unsigned threads = 0);
+void computeEDCECC(uint8_t *const *sectors, size_t count, unsigned threads = 0);
+
+// Compute the yellow book's crc32 over a buffer.
+uint32_t computeEDC(const uint8_t *data, size_t len);
+
 // Compute the CRC-16 for the SubQ channel.
 uint16_t subqCRC(const uint8_t *d, int len = 10);
 
@@ -0,0 +1,55 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/psxcounters.h"
+#include "gtest/gtest.h"
+
+using PCSX::Counters;
+
+TEST(AudioSync, WithinSlackDoesNotThrottle) {
+    // 256 frame periods give a slack of 1024 frames.
+    EXPECT_EQ(Counters::audioThrottleFrames(-100, 256), 0);
+    EXPECT_EQ(Counters::audioThrottleFrames(0, 256), 0);
+    EXPECT_EQ(Counters::audioThrottleFrames(1024, 256), 0);
+}
+
+TEST(AudioSync, BeyondSlackFallsBackToHalfOfIt) {
+    EXPECT_EQ(Counters::audioThrottleFrames(1025, 256), 513);
+    EXPECT_EQ(Counters::audioThrottleFrames(4000, 256), 3488);
+}
+
+TEST(AudioSync, LargePeriodsAreCapped) {
+    // Four 512 frame periods, or more, would be the whole 2048 frames voice
+    // stream, so the slack stops at 1024 frames, and the target at 512.
+    EXPECT_EQ(Counters::audioThrottleFrames(1024, 512), 0);
+    EXPECT_EQ(Counters::audioThrottleFrames(1025, 512), 513);
+    EXPECT_EQ(Counters::audioThrottleFrames(1024, 1024), 0);
+    EXPECT_EQ(Counters::audioThrottleFrames(2048, 1024), 1536);
+    EXPECT_EQ(Counters::audioThrottleFrames(4096, 1024), 3584);
+    EXPECT_EQ(Counters::audioThrottleFrames(2048, 0xffffffff), 1536);
+}
+
+TEST(AudioSync, SmallPeriodsGetAMinimumSlack) {
+    // Four 32 frame periods would only give a 128 frames slack, which is too
+    // little to absorb anything, so it never goes under 512 frames.
+    EXPECT_EQ(Counters::audioThrottleFrames(500, 32), 0);
+    EXPECT_EQ(Counters::audioThrottleFrames(512, 32), 0);
+    EXPECT_EQ(Counters::audioThrottleFrames(600, 32), 344);
+    EXPECT_EQ(Counters::audioThrottleFrames(600, 0), 344);
+}
@@ -0,0 +1,31 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+// Lua chunk for the benchmark tests to pass through -exec. Prints the speed
+// of the emulated CPU when quitting, labelled with the BenchmarkName global,
+// which an earlier -exec needs to set.
+inline constexpr char measureMIPS[] = R"(
+local start = os.clock()
+BenchmarkListener = PCSX.Events.createEventListener('Quitting', function()
+    local mips = PCSX.getRegisters().cycle / 2 / (os.clock() - start) / 1000000
+    print(string.format('%s: %.2f MIPS', BenchmarkName, mips))
+end)
+)";
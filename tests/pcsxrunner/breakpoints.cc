@@ -0,0 +1,47 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include <string>
+
+#include "benchmark.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+#include "main/main.h"
+
+// Each chunk is kept short, as the arguments get probed as file names first.
+static const char addBreakpoints[] = R"(
+BenchmarkBreakpoints = {}
+for i = 0, BenchmarkCount - 1 do
+    local t = ({ 'Exec', 'Read', 'Write' })[i % 3 + 1]
+    BenchmarkBreakpoints[i + 1] = PCSX.addBreakpoint(0x80180000 + i * 64, t, 4, 'Bench', function() return true end)
+end
+)";
+
+// Run with --gtest_also_run_disabled_tests to get the speed of the interpreter running
+// with the debugger on, and an increasing amount of breakpoints which never get hit.
+TEST(Breakpoints, DISABLED_Benchmark) {
+    for (unsigned count : {0, 10, 1000}) {
+        std::string setCount = fmt::format("BenchmarkCount = {}; BenchmarkName = '{} breakpoints'", count, count);
+        MainInvoker invoker("-no-ui", "-run", "-bios", "src/mips/openbios/openbios.bin", "-testmode", "-interpreter",
+                            "-debugger", "-exec", setCount.c_str(), "-exec", addBreakpoints, "-exec", measureMIPS,
+                            "-loadexe", "src/mips/tests/cpu/cpu.ps-exe");
+        int ret = invoker.invoke();
+        EXPECT_EQ(ret, 0);
+    }
+}
@@ -0,0 +1,54 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/cdrom.h"
+#include "gtest/gtest.h"
+
+using PCSX::CDRom;
+
+static constexpr uint32_t c_readTime = 33868800 / 75;
+
+TEST(AcceleratedCD, RealSpeedIsUntouched) {
+    EXPECT_EQ(CDRom::acceleratedSeekCycles(c_readTime * 30, 1), c_readTime * 30);
+    EXPECT_EQ(CDRom::acceleratedSectorCycles(c_readTime, 1), c_readTime);
+}
+
+TEST(AcceleratedCD, SeeksAreDivided) {
+    EXPECT_EQ(CDRom::acceleratedSeekCycles(c_readTime * 30, 2), c_readTime * 15);
+    EXPECT_EQ(CDRom::acceleratedSeekCycles(c_readTime * 32, 16), c_readTime * 2);
+    // Past the maximum, the speedup sticks to it.
+    EXPECT_EQ(CDRom::acceleratedSeekCycles(c_readTime * 32, 64), c_readTime * 2);
+}
+
+TEST(AcceleratedCD, SeeksNeverBeatAnAcknowledge) {
+    EXPECT_EQ(CDRom::acceleratedSeekCycles(0x1000, 16), 0x800);
+    EXPECT_EQ(CDRom::acceleratedSeekCycles(c_readTime * 150, 0), 0x800);
+    EXPECT_EQ(CDRom::acceleratedSeekCycles(c_readTime * 150, -3), 0x800);
+    // Delays already shorter than that are left as they are.
+    EXPECT_EQ(CDRom::acceleratedSeekCycles(0x400, 0), 0x400);
+    EXPECT_EQ(CDRom::acceleratedSeekCycles(0x400, 4), 0x400);
+}
+
+TEST(AcceleratedCD, SectorsCapAt16x) {
+    EXPECT_EQ(CDRom::acceleratedSectorCycles(c_readTime, 4), c_readTime / 4);
+    EXPECT_EQ(CDRom::acceleratedSectorCycles(c_readTime, 16), c_readTime / 16);
+    EXPECT_EQ(CDRom::acceleratedSectorCycles(c_readTime, 0), c_readTime / 16);
+    EXPECT_EQ(CDRom::acceleratedSectorCycles(c_readTime, 100), c_readTime / 16);
+    EXPECT_EQ(CDRom::acceleratedSectorCycles(c_readTime, -1), c_readTime / 16);
+}
@@ -17,6 +17,10 @@
  *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
  ***************************************************************************/
 
+#include <string>
+
+#include "benchmark.h"
+#include "fmt/format.h"
 #include "gtest/gtest.h"
 #include "main/main.h"
 
@@ -27,9 +31,40 @@ TEST(CPU, Interpreter) {
     EXPECT_EQ(ret, 0);
 }
 
+TEST(CPU, CachedInterpreter) {
+    MainInvoker invoker("-no-ui", "-run", "-bios", "src/mips/openbios/openbios.bin", "-testmode",
+                        "-cachedinterpreter", "-luacov", "-loadexe", "src/mips/tests/cpu/cpu.ps-exe");
+    int ret = invoker.invoke();
+    EXPECT_EQ(ret, 0);
+}
+
 TEST(CPU, Dynarec) {
     MainInvoker invoker("-no-ui", "-run", "-bios", "src/mips/openbios/openbios.bin", "-testmode", "-dynarec",
                         "-luacov", "-loadexe", "src/mips/tests/cpu/cpu.ps-exe");
     int ret = invoker.invoke();
     EXPECT_EQ(ret, 0);
-}
\ No newline at end of file
+}
+
+TEST(CPU, DynarecFastmem) {
+    MainInvoker invoker("-no-ui", "-run", "-bios", "src/mips/openbios/openbios.bin", "-testmode", "-dynarec",
+                        "-fastmem", "-luacov", "-loadexe", "src/mips/tests/cpu/cpu.ps-exe");
+    int ret = invoker.invoke();
+    EXPECT_EQ(ret, 0);
+}
+
+// Run with --gtest_also_run_disabled_tests to get the speed of each specialized
+// interpreter variant, across RAM sizes and PGXP modes.
+TEST(CPU, DISABLED_InterpreterBenchmark) {
+    for (const char* core : {"-interpreter", "-cachedinterpreter"}) {
+        for (const char* ram : {"-2mb", "-8mb"}) {
+            for (const char* pgxp : {"0", "2"}) {
+                std::string setName = fmt::format("BenchmarkName = '{} {} -pgxp {}'", core, ram, pgxp);
+                MainInvoker invoker("-no-ui", "-run", "-bios", "src/mips/openbios/openbios.bin", "-testmode", core,
+                                    ram, "-pgxp", pgxp, "-exec", setName.c_str(), "-exec", measureMIPS, "-loadexe",
+                                    "src/mips/tests/cpu/cpu.ps-exe");
+                int ret = invoker.invoke();
+                EXPECT_EQ(ret, 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,129 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/cputrace.h"
+
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "main/main.h"
+
+namespace {
+
+std::filesystem::path tracePath() { return std::filesystem::temp_directory_path() / "pcsx-cputrace-test.trace"; }
+
+PCSX::CPUTrace::Record makeRecord(uint32_t pc, uint32_t code, uint32_t cycle) {
+    PCSX::CPUTrace::Record record = {};
+    record.pc = pc;
+    record.code = code;
+    record.cycle = cycle;
+    return record;
+}
+
+}  // namespace
+
+TEST(CPUTrace, Destinations) {
+    // addiu $v0, $zero, 1
+    EXPECT_EQ(PCSX::CPUTrace::immediateDestination(0x24020001), 2);
+    // addu $v1, $a0, $a1
+    EXPECT_EQ(PCSX::CPUTrace::immediateDestination(0x00851821), 3);
+    // jal 0x80010000
+    EXPECT_EQ(PCSX::CPUTrace::immediateDestination(0x0c004000), 31);
+    // lw $t0, 4($sp) goes through the load delay slot instead
+    EXPECT_EQ(PCSX::CPUTrace::immediateDestination(0x8fa80004), 0);
+    // mult $a0, $a1
+    EXPECT_EQ(PCSX::CPUTrace::immediateDestination(0x00850018), 0);
+}
+
+TEST(CPUTrace, MemoryAccesses) {
+    uint32_t gpr[32] = {};
+    gpr[29] = 0x801ffff0;
+    uint32_t address = 0;
+    uint8_t flags = 0;
+    // lw $t0, 4($sp)
+    EXPECT_TRUE(PCSX::CPUTrace::memoryAccess(0x8fa80004, gpr, address, flags));
+    EXPECT_EQ(address, 0x801ffff4);
+    EXPECT_EQ(flags, PCSX::CPUTrace::MEM_READ);
+    // sw $ra, -8($sp)
+    EXPECT_TRUE(PCSX::CPUTrace::memoryAccess(0xafbffff8, gpr, address, flags));
+    EXPECT_EQ(address, 0x801fffe8);
+    EXPECT_EQ(flags, PCSX::CPUTrace::MEM_WRITE);
+    // addiu $v0, $zero, 1
+    EXPECT_FALSE(PCSX::CPUTrace::memoryAccess(0x24020001, gpr, address, flags));
+}
+
+TEST(CPUTrace, Triggers) {
+    PCSX::CPUTrace trace;
+    PCSX::CPUTrace::Triggers triggers;
+    triggers.startPC = 0x80010008;
+    triggers.stopCycle = 100;
+    ASSERT_TRUE(trace.start(tracePath(), triggers));
+    EXPECT_FALSE(trace.inWindow(0x80010000, 10));
+    EXPECT_FALSE(trace.inWindow(0x80010004, 20));
+    EXPECT_TRUE(trace.inWindow(0x80010008, 30));
+    EXPECT_TRUE(trace.inWindow(0x80010000, 40));
+    EXPECT_FALSE(trace.inWindow(0x80010004, 100));
+    EXPECT_FALSE(trace.inWindow(0x80010008, 30));
+    trace.stop();
+    std::filesystem::remove(tracePath());
+}
+
+TEST(CPUTrace, RoundTrip) {
+    constexpr unsigned c_count = 100000;
+    PCSX::CPUTrace trace;
+    ASSERT_TRUE(trace.start(tracePath(), {}));
+    for (unsigned i = 0; i < c_count; i++) {
+        auto record = makeRecord(0x80010000 + i * 4, 0, i * 2);
+        trace.push(record);
+    }
+    trace.stop();
+
+    PCSX::IO<PCSX::File> in(new PCSX::PosixFile(tracePath()));
+    ASSERT_FALSE(in->failed());
+    PCSX::CPUTrace::FileHeader header;
+    ASSERT_EQ(in->read(&header, sizeof(header)), ssize_t(sizeof(header)));
+    EXPECT_EQ(header.recordSize, sizeof(PCSX::CPUTrace::Record));
+    unsigned count = 0;
+    uint32_t dropped = 0;
+    PCSX::CPUTrace::Record record;
+    uint32_t lastPC = 0;
+    while (in->read(&record, sizeof(record)) == ssize_t(sizeof(record))) {
+        EXPECT_GT(record.pc, lastPC);
+        lastPC = record.pc;
+        dropped += record.dropped;
+        count++;
+    }
+    in->close();
+    // The ring may overflow if the flusher falls behind, but every lost
+    // record has to be accounted for in the stream.
+    EXPECT_EQ(count + dropped, c_count);
+
+    std::ostringstream out;
+    PCSX::IO<PCSX::File> decoded(new PCSX::PosixFile(tracePath()));
+    EXPECT_TRUE(PCSX::CPUTrace::decode(decoded, out));
+    decoded->close();
+    EXPECT_NE(out.str().find("80010000 00000000: nop"), std::string::npos);
+
+    std::string path = tracePath().string();
+    MainInvoker invoker("-decodetrace", path.c_str());
+    EXPECT_EQ(invoker.invoke(), 0);
+    std::filesystem::remove(tracePath());
+}
@@ -0,0 +1,101 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+#include "main/main.h"
+
+// Runs two emulators side by side, each on its own thread. They share the
+// process, and thus the uv thread and the immutable tables, but none of their
+// state: both have to reach the end of their test program on their own.
+TEST(Instances, TwoThreads) {
+    int retCPU = -1, retBasic = -1;
+    std::thread cpu([&retCPU]() {
+        MainInvoker invoker("-no-ui", "-run", "-bios", "src/mips/openbios/openbios.bin", "-testmode",
+                            "-interpreter", "-loadexe", "src/mips/tests/cpu/cpu.ps-exe");
+        retCPU = invoker.invoke();
+    });
+    std::thread basic([&retBasic]() {
+        MainInvoker invoker("-no-ui", "-run", "-bios", "src/mips/openbios/openbios.bin", "-testmode",
+                            "-interpreter", "-loadexe", "src/mips/tests/basic/basic.ps-exe");
+        retBasic = invoker.invoke();
+    });
+    cpu.join();
+    basic.join();
+    EXPECT_EQ(retCPU, 0);
+    EXPECT_EQ(retBasic, 0);
+}
+
+// Each instance stamps the last word of its 8MB RAM block, which a 2MB machine
+// never reaches, once the BIOS is done clearing memory, and checks on every vsync that
+// the stamp is still its own. The verdict gets written out when quitting.
+static const char stampRAM[] = R"(
+local ram = ffi.cast('uint32_t*', PCSX.getMemPtr())
+StampOK = 'unstamped'
+StampSet = PCSX.Events.createEventListener('ExecutionFlow::ShellReached', function()
+    ram[0x1fffff] = Stamp
+    StampOK = 'ok'
+end)
+StampCheck = PCSX.Events.createEventListener('GPU::Vsync', function()
+    if StampOK == 'ok' and ram[0x1fffff] ~= Stamp then StampOK = 'clobbered' end
+end)
+)";
+static const char stampVerdict[] = R"(
+StampDone = PCSX.Events.createEventListener('Quitting', function()
+    local f = io.open(StampResult, 'w')
+    f:write(StampOK)
+    f:close()
+end)
+)";
+
+// Two instances in the same process must not end up with the same RAM, even
+// when neither uses fastmem and RAM comes from a named shared memory object.
+TEST(Instances, SeparateRAM) {
+    auto run = [](uint32_t stamp, std::filesystem::path result, int& ret) {
+        std::string setup = fmt::format("Stamp = 0x{:08x} StampResult = [[{}]]", stamp, result.string());
+        MainInvoker invoker("-no-ui", "-run", "-bios", "src/mips/openbios/openbios.bin", "-testmode", "-interpreter",
+                            "-exec", setup.c_str(), "-exec", stampRAM, "-exec", stampVerdict, "-loadexe",
+                            "src/mips/tests/cpu/cpu.ps-exe");
+        ret = invoker.invoke();
+    };
+    auto tmp = std::filesystem::temp_directory_path();
+    auto resultA = tmp / "pcsx-instances-a.txt";
+    auto resultB = tmp / "pcsx-instances-b.txt";
+    int retA = -1, retB = -1;
+    std::thread a([&]() { run(0x12345678, resultA, retA); });
+    std::thread b([&]() { run(0x9abcdef0, resultB, retB); });
+    a.join();
+    b.join();
+    EXPECT_EQ(retA, 0);
+    EXPECT_EQ(retB, 0);
+    for (auto& path : {resultA, resultB}) {
+        std::ifstream in(path);
+        std::stringstream verdict;
+        verdict << in.rdbuf();
+        EXPECT_EQ(verdict.str(), "ok");
+        in.close();
+        std::filesystem::remove(path);
+    }
+}
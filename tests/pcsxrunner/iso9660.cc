@@ -0,0 +1,149 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+#include "main/main.h"
+
+namespace {
+
+// A tiny mode 1 image, with a root directory which also holds a "..;1"
+// directory and a ".;1" file, the way a crafted disc would try to get
+// files written outside of the extraction directory. The track length of a
+// plain image is guessed from its size as if it had raw sectors, hence the
+// padding at the end.
+class TestImage {
+  public:
+    TestImage() : m_data(32 * 2048, 0) {
+        uint8_t* pvd = sector(16);
+        pvd[0] = 1;
+        memcpy(pvd + 1, "CD001", 5);
+        pvd[6] = 1;
+        memcpy(pvd + 40, "TESTDISC", 8);
+        both32(pvd + 80, 32);
+        pvd[120] = pvd[123] = 1;
+        pvd[124] = pvd[127] = 1;
+        pvd[129] = pvd[130] = 0x08;
+        pvd[881] = 1;
+        dirEntry(pvd + 156, std::string(1, '\0'), 18, true);
+        uint8_t* terminator = sector(17);
+        terminator[0] = 255;
+        memcpy(terminator + 1, "CD001", 5);
+        terminator[6] = 1;
+
+        uint8_t* root = sector(18);
+        root += dirEntry(root, std::string(1, '\0'), 18, true);
+        root += dirEntry(root, std::string(1, '\1'), 18, true);
+        root += dirEntry(root, "..;1", 19, true);
+        root += dirEntry(root, ".;1", 21, false, 5);
+        root += dirEntry(root, "DIR", 20, true);
+        root += dirEntry(root, "README.TXT;1", 21, false, 5);
+
+        uint8_t* evil = sector(19);
+        evil += dirEntry(evil, std::string(1, '\0'), 19, true);
+        evil += dirEntry(evil, std::string(1, '\1'), 18, true);
+        evil += dirEntry(evil, "ESCAPE.TXT;1", 21, false, 5);
+
+        uint8_t* dir = sector(20);
+        dir += dirEntry(dir, std::string(1, '\0'), 20, true);
+        dir += dirEntry(dir, std::string(1, '\1'), 18, true);
+        dir += dirEntry(dir, "INNER.BIN;1", 22, false, 3);
+
+        memcpy(sector(21), "hello", 5);
+        memcpy(sector(22), "abc", 3);
+    }
+    void save(const std::filesystem::path& path) {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(m_data.data()), m_data.size());
+    }
+
+  private:
+    uint8_t* sector(unsigned lba) { return m_data.data() + lba * 2048; }
+    static void both32(uint8_t* ptr, uint32_t value) {
+        for (unsigned i = 0; i < 4; i++) {
+            ptr[i] = value >> (i * 8);
+            ptr[7 - i] = value >> (i * 8);
+        }
+    }
+    static unsigned dirEntry(uint8_t* ptr, const std::string& name, uint32_t lba, bool directory,
+                             uint32_t size = 2048) {
+        unsigned length = 33 + name.size() + ((name.size() & 1) ? 0 : 1);
+        ptr[0] = length;
+        both32(ptr + 2, lba);
+        both32(ptr + 10, size);
+        ptr[25] = directory ? 2 : 0;
+        ptr[28] = ptr[31] = 1;
+        ptr[32] = name.size();
+        memcpy(ptr + 33, name.data(), name.size());
+        return length;
+    }
+    std::vector<uint8_t> m_data;
+};
+
+}  // namespace
+
+static const char checkReader[] = R"(
+coroutine.resume(coroutine.create(function()
+    local reader = PCSX.getCurrentIso():createReader()
+    local paths = {}
+    for _, entry in ipairs(reader:listAll()) do paths[#paths + 1] = entry.path end
+    local extracted = reader:extractAll(IsoTestDest)
+    local listed = table.concat(paths, ',')
+    print(string.format('listed: %s, extracted: %d', listed, extracted))
+    PCSX.quit((listed == 'DIR,README.TXT;1,DIR/INNER.BIN;1' and extracted == 2) and 0 or 1)
+end))
+)";
+
+TEST(ISO9660Reader, ListAndExtract) {
+    auto root = std::filesystem::temp_directory_path() / "pcsx-iso9660-reader-test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    auto image = root / "test.iso";
+    auto dest = root / "out";
+    TestImage().save(image);
+
+    std::string setDest = fmt::format("IsoTestDest = '{}'", dest.generic_string());
+    std::string isoPath = image.string();
+    MainInvoker invoker("-no-ui", "-cli", "-bios", "src/mips/openbios/openbios.bin", "-testmode", "-interpreter",
+                        "-iso", isoPath.c_str(), "-exec", setDest.c_str(), "-exec", checkReader);
+    int ret = invoker.invoke();
+    EXPECT_EQ(ret, 0);
+
+    std::string contents;
+    std::ifstream readme(dest / "README.TXT", std::ios::binary);
+    std::getline(readme, contents);
+    EXPECT_EQ(contents, "hello");
+    std::ifstream inner(dest / "DIR" / "INNER.BIN", std::ios::binary);
+    std::getline(inner, contents);
+    EXPECT_EQ(contents, "abc");
+    EXPECT_FALSE(std::filesystem::exists(root / "ESCAPE.TXT"));
+    EXPECT_FALSE(std::filesystem::exists(dest / "ESCAPE.TXT"));
+
+    readme.close();
+    inner.close();
+    std::filesystem::remove_all(root);
+}
@@ -0,0 +1,61 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "gtest/gtest.h"
+#include "main/main.h"
+
+// Each chunk is kept short, as the arguments get probed as file names first.
+static const char startSlot[] = R"(
+PCSX.execSlots = PCSX.execSlots or {}
+PCSX.execSlots[1] = function() BenchStart = os.clock() end
+BenchReport = require('ffi').cast('uint32_t*', PCSX.getScratchPtr() + 0x3f8)
+)";
+
+static const char phaseName[] = R"(
+function BenchName()
+    local name = PCSX.getMemPtr() + bit.band(BenchReport[0], 0x1fffff)
+    return require('ffi').string(name)
+end
+)";
+
+static const char stopSlot[] = R"(
+PCSX.execSlots[2] = function()
+    local ns = (os.clock() - BenchStart) * 1e9 / BenchReport[1]
+    BenchBaseline = BenchBaseline or ns
+    print(string.format('%-14s %8.2f ns, %8.2f over a nop', BenchName(), ns, ns - BenchBaseline))
+end
+)";
+
+// Run with --gtest_also_run_disabled_tests to get the time each memory access
+// takes, per region and width, for each CPU core.
+TEST(MemoryBus, DISABLED_BenchmarkInterpreter) {
+    MainInvoker invoker("-no-ui", "-run", "-bios", "src/mips/openbios/openbios.bin", "-testmode", "-interpreter",
+                        "-exec", startSlot, "-exec", phaseName, "-exec", stopSlot, "-loadexe",
+                        "src/mips/tests/membench/membench.ps-exe");
+    int ret = invoker.invoke();
+    EXPECT_EQ(ret, 0);
+}
+
+TEST(MemoryBus, DISABLED_BenchmarkDynarec) {
+    MainInvoker invoker("-no-ui", "-run", "-bios", "src/mips/openbios/openbios.bin", "-testmode", "-dynarec",
+                        "-exec", startSlot, "-exec", phaseName, "-exec", stopSlot, "-loadexe",
+                        "src/mips/tests/membench/membench.ps-exe");
+    int ret = invoker.invoke();
+    EXPECT_EQ(ret, 0);
+}
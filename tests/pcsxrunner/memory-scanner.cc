@@ -0,0 +1,152 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/memory-scanner.h"
+
+#include <string.h>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using PCSX::MemoryScanner;
+using ScanType = MemoryScanner::ScanType;
+using ValueType = MemoryScanner::ValueType;
+
+namespace {
+
+bool reference(ScanType scan, int64_t current, int64_t old, int64_t value) {
+    switch (scan) {
+        case ScanType::ExactValue:
+            return current == value;
+        case ScanType::GreaterThan:
+            return current > value;
+        case ScanType::LessThan:
+            return current < value;
+        case ScanType::Changed:
+            return current != old;
+        case ScanType::Unchanged:
+            return current == old;
+        case ScanType::Increased:
+            return current > old;
+        case ScanType::Decreased:
+            return current < old;
+        case ScanType::UnknownInitialValue:
+            return true;
+    }
+    return false;
+}
+
+std::vector<uint8_t> randomMemory(size_t size, std::mt19937& rng) {
+    // Only a handful of distinct bytes, so that equality scans find something.
+    std::vector<uint8_t> mem(size);
+    for (auto& byte : mem) byte = (rng() % 4) * 0x55;
+    return mem;
+}
+
+}  // namespace
+
+TEST(MemoryScanner, ExactValue) {
+    std::vector<uint8_t> mem(4096, 0);
+    mem[0x100] = 0x34;
+    mem[0x101] = 0x12;
+    mem[0x801] = 0x34;
+    mem[0x802] = 0x12;
+    mem[0xffe] = 0x34;
+    mem[0xfff] = 0x12;
+    MemoryScanner scanner;
+    scanner.firstScan(mem.data(), mem.size(), ValueType::Short, ScanType::ExactValue, 0x1234);
+    // The one at 0x801 isn't aligned.
+    ASSERT_EQ(scanner.size(), 2);
+    EXPECT_EQ(scanner.candidate(0), 0x100);
+    EXPECT_EQ(scanner.candidate(1), 0xffe);
+    EXPECT_TRUE(scanner.isCandidate(0x100));
+    EXPECT_FALSE(scanner.isCandidate(0x801));
+
+    mem[0x100] = 0x35;
+    scanner.nextScan(mem.data(), ScanType::Changed, 0);
+    ASSERT_EQ(scanner.size(), 1);
+    EXPECT_EQ(scanner.candidate(0), 0x100);
+    EXPECT_EQ(scanner.scannedValue(0x100), 0x1235);
+}
+
+TEST(MemoryScanner, SignedAndUnsigned) {
+    std::vector<uint8_t> mem(256, 0);
+    mem[4] = 0xff;
+    MemoryScanner scanner;
+    scanner.firstScan(mem.data(), mem.size(), ValueType::Char, ScanType::LessThan, 0);
+    ASSERT_EQ(scanner.size(), 1);
+    EXPECT_EQ(scanner.candidate(0), 4);
+    scanner.firstScan(mem.data(), mem.size(), ValueType::Uchar, ScanType::GreaterThan, 0x80);
+    ASSERT_EQ(scanner.size(), 1);
+    EXPECT_EQ(scanner.candidate(0), 4);
+    EXPECT_EQ(MemoryScanner::truncate(ValueType::Char, 0xff), -1);
+    EXPECT_EQ(MemoryScanner::truncate(ValueType::Uint, -1), 0xffffffff);
+}
+
+TEST(MemoryScanner, MatchesReference) {
+    std::mt19937 rng(1234);
+    // Not a multiple of 64 slots, to go through the partial words too.
+    constexpr size_t c_size = 256 * 1024 + 36;
+    for (auto type : {ValueType::Char, ValueType::Uchar, ValueType::Short, ValueType::Ushort, ValueType::Int,
+                      ValueType::Uint}) {
+        const unsigned stride = MemoryScanner::stride(type);
+        auto before = randomMemory(c_size, rng);
+        const int64_t value = MemoryScanner::read(type, before.data(), 0);
+        MemoryScanner scanner;
+        scanner.firstScan(before.data(), before.size(), type, ScanType::UnknownInitialValue, 0);
+        ASSERT_EQ(scanner.size(), c_size / stride);
+
+        std::vector<bool> expected(c_size / stride, true);
+        for (auto scan : {ScanType::Changed, ScanType::Decreased, ScanType::LessThan, ScanType::Unchanged}) {
+            auto after = before;
+            for (size_t i = 0; i < after.size(); i += 3) after[i] = rng();
+            for (size_t slot = 0; slot < expected.size(); slot++) {
+                const int64_t current = MemoryScanner::read(type, after.data(), slot * stride);
+                const int64_t old = MemoryScanner::read(type, before.data(), slot * stride);
+                expected[slot] = expected[slot] && reference(scan, current, old, value);
+            }
+            scanner.nextScan(after.data(), scan, value);
+            std::vector<uint32_t> wanted;
+            for (size_t slot = 0; slot < expected.size(); slot++) {
+                if (expected[slot]) wanted.push_back(slot * stride);
+            }
+            ASSERT_EQ(scanner.size(), wanted.size());
+            for (size_t i = 0; i < wanted.size(); i++) EXPECT_EQ(scanner.candidate(i), wanted[i]);
+            before = after;
+        }
+    }
+}
+
+// Run with --gtest_also_run_disabled_tests to get the speed of a scan over 8MB of memory.
+TEST(MemoryScanner, DISABLED_Benchmark) {
+    std::mt19937 rng(1234);
+    auto mem = randomMemory(8 * 1024 * 1024, rng);
+    MemoryScanner scanner;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < 100; i++) {
+        scanner.firstScan(mem.data(), mem.size(), ValueType::Short, ScanType::UnknownInitialValue, 0);
+        scanner.nextScan(mem.data(), ScanType::Unchanged, 0);
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%.2f ms per pair of scans, %zu candidates left\n", elapsed * 10, scanner.size());
+}
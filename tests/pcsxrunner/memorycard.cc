@@ -0,0 +1,113 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "main/main.h"
+
+static constexpr size_t c_frameSize = 128;
+static constexpr size_t c_cardSize = 1024 * c_frameSize;
+
+static uint32_t crc32(const std::string &data) {
+    uint32_t crc = 0xffffffff;
+    for (uint8_t c : data) {
+        crc ^= c;
+        for (int i = 0; i < 8; i++) crc = (crc >> 1) ^ (0xedb88320 & -(crc & 1));
+    }
+    return ~crc;
+}
+
+static void append32(std::string &out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out.push_back(char(value >> (i * 8)));
+}
+
+// Mirrors the layout written by MemoryCard::writeFrames: magic, frame count,
+// then each frame index with its 128 bytes, and a crc32 of all of it.
+static std::string makeJournal(const std::vector<std::pair<uint32_t, char>> &frames) {
+    std::string journal = "PCSXMCJ1";
+    append32(journal, frames.size());
+    for (auto &[index, fill] : frames) {
+        append32(journal, index);
+        journal.append(c_frameSize, fill);
+    }
+    append32(journal, crc32(journal));
+    return journal;
+}
+
+static void writeFile(const std::filesystem::path &path, const std::string &data) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(data.data(), data.size());
+}
+
+static std::string readFile(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Writes a blank card and the given journal next to it, boots with that card
+// inserted, and returns what the card looks like on disk afterwards.
+static std::string loadWithJournal(const std::string &journal) {
+    auto card = std::filesystem::temp_directory_path() / "pcsx-memorycard-test.mcd";
+    auto journalPath = card;
+    journalPath += ".journal";
+    writeFile(card, std::string(c_cardSize, '\x11'));
+    writeFile(journalPath, journal);
+    auto cardPath = card.string();
+    MainInvoker invoker("-no-ui", "-cli", "-bios", "src/mips/openbios/openbios.bin", "-testmode", "-interpreter",
+                        "-memcard1", cardPath.c_str(), "-exec", "PCSX.quit(0)");
+    int ret = invoker.invoke();
+    EXPECT_EQ(ret, 0);
+    EXPECT_FALSE(std::filesystem::exists(journalPath));
+    auto contents = readFile(card);
+    std::filesystem::remove(card);
+    std::filesystem::remove(journalPath);
+    return contents;
+}
+
+TEST(MemoryCard, JournalIsReplayed) {
+    auto card = loadWithJournal(makeJournal({{3, '\xa5'}, {700, '\x5a'}}));
+    ASSERT_EQ(card.size(), c_cardSize);
+    std::string expected(c_cardSize, '\x11');
+    memset(expected.data() + 3 * c_frameSize, 0xa5, c_frameSize);
+    memset(expected.data() + 700 * c_frameSize, 0x5a, c_frameSize);
+    EXPECT_TRUE(card == expected);
+}
+
+TEST(MemoryCard, TruncatedJournalIsDiscarded) {
+    auto journal = makeJournal({{3, '\xa5'}, {700, '\x5a'}});
+    journal.resize(journal.size() - 64);
+    auto card = loadWithJournal(journal);
+    EXPECT_TRUE(card == std::string(c_cardSize, '\x11'));
+}
+
+TEST(MemoryCard, TornJournalIsDiscarded) {
+    auto journal = makeJournal({{3, '\xa5'}, {700, '\x5a'}});
+    // Corrupt the second frame's payload, as if only part of it made it to disk.
+    journal[8 + 4 + (4 + c_frameSize) + 4 + 17] = 0;
+    auto card = loadWithJournal(journal);
+    EXPECT_TRUE(card == std::string(c_cardSize, '\x11'));
+}
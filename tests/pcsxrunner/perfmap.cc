@@ -0,0 +1,62 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "core/r3000a.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+#include "main/main.h"
+
+#if defined(DYNAREC_X86_64) && defined(__linux__)
+TEST(PerfMap, DynarecBlocksAreListed) {
+    const std::filesystem::path path = fmt::format("/tmp/perf-{}.map", getpid());
+    std::filesystem::remove(path);
+    MainInvoker invoker("-no-ui", "-run", "-bios", "src/mips/openbios/openbios.bin", "-testmode", "-dynarec",
+                        "-perfmap", "-loadexe", "src/mips/tests/cpu/cpu.ps-exe");
+    int ret = invoker.invoke();
+    EXPECT_EQ(ret, 0);
+
+    std::ifstream map(path);
+    ASSERT_TRUE(map.is_open());
+    bool dispatcher = false;
+    bool resetVector = false;
+    std::string line;
+    while (std::getline(map, line)) {
+        std::istringstream fields(line);
+        uintptr_t start;
+        size_t size;
+        std::string name;
+        fields >> std::hex >> start >> size >> name;
+        EXPECT_NE(start, 0u);
+        EXPECT_NE(size, 0u);
+        if (name == "pcsx_dispatcher_entry") dispatcher = true;
+        if (name == "pcsx_block_bfc00000") resetVector = true;
+    }
+    EXPECT_TRUE(dispatcher);
+    EXPECT_TRUE(resetVector);
+    map.close();
+    std::filesystem::remove(path);
+}
+#endif
@@ -0,0 +1,286 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/pgxp_mem.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "core/pgxp_value.h"
+#include "gtest/gtest.h"
+#include "main/main.h"
+
+namespace {
+
+PGXP_value makeValue(uint32_t value, unsigned flags) {
+    PGXP_value v = {};
+    v.x = static_cast<int16_t>(value);
+    v.y = static_cast<int16_t>(value >> 16);
+    v.value = value;
+    v.flags = flags;
+    return v;
+}
+
+// The differential test needs a dynarec which supports PGXP, which only the x64 one does.
+#if defined(DYNAREC_X86_64)
+// Tiny MIPS assembler, just enough to write the differential test program below.
+enum { zero = 0, t0 = 8, t1, t2, t3, t4, t5, t6, t7, s0 = 16, s1, s2 };
+uint32_t rType(uint32_t rs, uint32_t rt, uint32_t rd, uint32_t sa, uint32_t funct) {
+    return (rs << 21) | (rt << 16) | (rd << 11) | (sa << 6) | funct;
+}
+uint32_t iType(uint32_t op, uint32_t rs, uint32_t rt, uint32_t imm) {
+    return (op << 26) | (rs << 21) | (rt << 16) | (imm & 0xffff);
+}
+uint32_t copMove(uint32_t cop, uint32_t sub, uint32_t rt, uint32_t rd) {
+    return ((0x10 | cop) << 26) | (sub << 21) | (rt << 16) | (rd << 11);
+}
+
+constexpr uint32_t c_loadAddress = 0x80010000;
+constexpr uint32_t c_verticesOffset = 0x800;
+constexpr uint32_t c_outputAddress = 0x80011000;
+constexpr unsigned c_vertexCount = 16;
+constexpr unsigned c_outputWords = c_vertexCount * 8;
+
+// Projects a handful of vertices through the GTE, and then shuffles the screen
+// coordinates around through the CPU, the same way a game preparing its
+// primitives would, and reads some of them back through unaligned loads and
+// COP0 moves sitting in load delay slots. Leaves 8 words per vertex at
+// c_outputAddress.
+std::vector<uint8_t> buildProgram() {
+    std::vector<uint32_t> code;
+    code.push_back(iType(0x0f, zero, t0, 0x4000));  // lui t0, 0x4000
+    code.push_back(copMove(0, 4, t0, 12));          // mtc0 t0, $12: cop2 on, interrupts off
+    code.push_back(iType(0x0d, zero, t1, 0x1000));  // ori t1, zero, 0x1000
+    code.push_back(copMove(2, 6, t1, 0));           // ctc2 t1, R11R12
+    code.push_back(copMove(2, 6, zero, 1));         // ctc2 zero, R13R21
+    code.push_back(copMove(2, 6, t1, 2));           // ctc2 t1, R22R23
+    code.push_back(copMove(2, 6, zero, 3));         // ctc2 zero, R31R32
+    code.push_back(copMove(2, 6, t1, 4));           // ctc2 t1, R33
+    code.push_back(copMove(2, 6, zero, 5));         // ctc2 zero, TRX
+    code.push_back(copMove(2, 6, zero, 6));         // ctc2 zero, TRY
+    code.push_back(iType(0x0d, zero, t1, 0x400));   // ori t1, zero, 0x400
+    code.push_back(copMove(2, 6, t1, 7));           // ctc2 t1, TRZ
+    code.push_back(iType(0x0f, zero, t1, 160));     // lui t1, 160
+    code.push_back(copMove(2, 6, t1, 24));          // ctc2 t1, OFX
+    code.push_back(iType(0x0f, zero, t1, 120));     // lui t1, 120
+    code.push_back(copMove(2, 6, t1, 25));          // ctc2 t1, OFY
+    code.push_back(iType(0x0d, zero, t1, 200));     // ori t1, zero, 200
+    code.push_back(copMove(2, 6, t1, 26));          // ctc2 t1, H
+    code.push_back(iType(0x0f, zero, s0, (c_loadAddress + c_verticesOffset) >> 16));
+    code.push_back(iType(0x0d, s0, s0, c_loadAddress + c_verticesOffset));
+    code.push_back(iType(0x0f, zero, s1, c_outputAddress >> 16));
+    code.push_back(iType(0x0d, s1, s1, c_outputAddress));
+    code.push_back(iType(0x0d, zero, s2, c_vertexCount));
+    const size_t loop = code.size();
+    code.push_back(iType(0x32, s0, 0, 0));            // lwc2 VXY0, 0(s0)
+    code.push_back(iType(0x32, s0, 1, 4));            // lwc2 VZ0, 4(s0)
+    code.push_back(0);                                // nop
+    code.push_back(0x4a180001);                       // rtps
+    code.push_back(0);                                // nop
+    code.push_back(iType(0x3a, s1, 14, 0));           // swc2 SXY2, 0(s1)
+    code.push_back(copMove(2, 0, t2, 14));            // mfc2 t2, SXY2
+    code.push_back(0);                                // nop
+    code.push_back(rType(0, t2, t3, 16, 0x03));       // sra t3, t2, 16
+    code.push_back(rType(0, t2, t4, 16, 0x00));       // sll t4, t2, 16
+    code.push_back(rType(0, t4, t4, 16, 0x03));       // sra t4, t4, 16
+    code.push_back(rType(t3, t4, t5, 0, 0x21));       // addu t5, t3, t4
+    code.push_back(iType(0x2b, s1, t2, 4));           // sw t2, 4(s1)
+    code.push_back(iType(0x29, s1, t4, 8));           // sh t4, 8(s1)
+    code.push_back(iType(0x29, s1, t3, 10));          // sh t3, 10(s1)
+    code.push_back(iType(0x23, s1, t6, 0));           // lw t6, 0(s1)
+    code.push_back(0);                                // nop
+    code.push_back(iType(0x2b, s1, t6, 12));          // sw t6, 12(s1)
+    code.push_back(iType(0x23, s1, t7, 4));           // lw t7, 4(s1)
+    code.push_back(iType(0x22, s1, t3, 3));           // lwl t3, 3(s1), in the delay slot of the lw
+    code.push_back(iType(0x26, s1, t3, 0));           // lwr t3, 0(s1), in the delay slot of the lwl
+    code.push_back(rType(t3, zero, t5, 0, 0x21));     // addu t5, t3, zero
+    code.push_back(iType(0x2b, s1, t3, 16));          // sw t3, 16(s1)
+    code.push_back(iType(0x2b, s1, t7, 20));          // sw t7, 20(s1)
+    code.push_back(iType(0x23, s1, t6, 4));           // lw t6, 4(s1)
+    code.push_back(copMove(0, 0, t4, 12));            // mfc0 t4, $12, in the delay slot of the lw
+    code.push_back(copMove(0, 2, t2, 12));            // cfc0 t2, $12, in the delay slot of the mfc0
+    code.push_back(rType(t4, t2, t5, 0, 0x21));       // addu t5, t4, t2
+    code.push_back(iType(0x2b, s1, t4, 24));          // sw t4, 24(s1)
+    code.push_back(iType(0x2b, s1, t2, 28));          // sw t2, 28(s1)
+    code.push_back(iType(0x09, s0, s0, 8));           // addiu s0, s0, 8
+    code.push_back(iType(0x09, s1, s1, 32));          // addiu s1, s1, 32
+    code.push_back(iType(0x09, s2, s2, 0xffff));      // addiu s2, s2, -1
+    code.push_back(iType(0x05, s2, zero, loop - code.size() - 1));  // bne s2, zero, loop
+    code.push_back(0);                                              // nop
+    code.push_back(iType(0x0f, zero, t0, 0x1f80));                  // lui t0, 0x1f80
+    code.push_back(iType(0x29, t0, zero, 0x2082));                  // sh zero, 0x2082(t0): exit with code 0
+    code.push_back(iType(0x04, zero, zero, 0xffff));                // b .
+    code.push_back(0);                                              // nop
+
+    std::vector<uint8_t> exe(2048 + 0x1000);
+    auto put32 = [&exe](size_t offset, uint32_t value) { memcpy(exe.data() + offset, &value, sizeof(value)); };
+    memcpy(exe.data(), "PS-X EXE", 8);
+    put32(0x10, c_loadAddress);
+    put32(0x18, c_loadAddress);
+    put32(0x1c, 0x1000);
+    put32(0x30, 0x801ffff0);
+    for (size_t i = 0; i < code.size(); i++) put32(2048 + i * 4, code[i]);
+    for (unsigned i = 0; i < c_vertexCount; i++) {
+        const int16_t x = i * 37 - 200;
+        const int16_t y = i * 23 - 150;
+        const int16_t z = i * 64;
+        put32(2048 + c_verticesOffset + i * 8, uint16_t(x) | (uint32_t(uint16_t(y)) << 16));
+        put32(2048 + c_verticesOffset + i * 8 + 4, uint16_t(z));
+    }
+    return exe;
+}
+
+// Runs the test program with the given core, and returns what PGXP knows about its output.
+std::vector<PGXP_value> runProgram(const std::string& exe, const char* core, int mode) {
+    std::string pgxpMode = std::to_string(mode);
+    MainInvoker invoker("-no-ui", "-run", "-bios", "src/mips/openbios/openbios.bin", "-testmode", core, "-pgxp",
+                        pgxpMode.c_str(), "-loadexe", exe.c_str());
+    int ret = invoker.invoke();
+    EXPECT_EQ(ret, 0);
+    std::vector<PGXP_value> values;
+    for (unsigned i = 0; i < c_outputWords; i++) {
+        PGXP_value v = *PGXP_ReadMem(c_outputAddress + i * 4);
+        v.count = 0;  // Only a timestamp of sorts, which doesn't need to match.
+        values.push_back(v);
+    }
+    return values;
+}
+#endif
+
+}  // namespace
+
+TEST(PGXP, UntouchedMemoryIsFree) {
+    PGXP_InitMem(0x200000);
+    const size_t empty = PGXP_GetMemUsage();
+    PGXP_value v;
+    ValidateAndCopyMem(&v, 0x80100000, 0x12345678);
+    EXPECT_EQ(v.flags, 0);
+    EXPECT_EQ(v.value, 0x12345678);
+    PGXP_value regular = makeValue(0x12345678, 0);
+    WriteMem(&regular, 0x80100000);
+    WriteMem16(&regular, 0x80100006);
+    EXPECT_EQ(PGXP_GetMemUsage(), empty);
+}
+
+TEST(PGXP, PagesAreDroppedWhenOverwritten) {
+    PGXP_InitMem(0x200000);
+    const size_t empty = PGXP_GetMemUsage();
+    PGXP_value precise = makeValue(0x00200010, VALID_01);
+    WriteMem(&precise, 0x80100000);
+    WriteMem(&precise, 0x80100004);
+    WriteMem(&precise, 0x80102000);
+    const size_t used = PGXP_GetMemUsage();
+    EXPECT_GT(used, empty);
+
+    PGXP_value v;
+    ValidateAndCopyMem(&v, 0xa0100004, 0x00200010);
+    EXPECT_EQ(v.flags, VALID_01);
+    EXPECT_EQ(v.x, 16.f);
+    EXPECT_EQ(v.y, 32.f);
+
+    // The guest reusing the memory for something else invalidates the values,
+    // and the pages go away with the last precise value they held.
+    ValidateAndCopyMem(&v, 0x80100000, 0xdeadbeef);
+    EXPECT_EQ(v.flags, 0);
+    PGXP_value regular = makeValue(0xdeadbeef, 0);
+    WriteMem(&regular, 0x80100004);
+    WriteMem(&regular, 0x80102000);
+    EXPECT_EQ(PGXP_GetMemUsage(), empty);
+}
+
+// Values carrying only flags keep their page alive, and don't vanish with the last precise value.
+TEST(PGXP, FlagsSurvivePrecisionLoss) {
+    PGXP_InitMem(0x200000);
+    const size_t empty = PGXP_GetMemUsage();
+    PGXP_value precise = makeValue(0x00200010, VALID_01);
+    WriteMem(&precise, 0x80100000);
+    PGXP_value tagged = makeValue(0x12345678, 0);
+    tagged.gFlags = 1;
+    WriteMem(&tagged, 0x80100004);
+    PGXP_value regular = makeValue(0xdeadbeef, 0);
+    WriteMem(&regular, 0x80100000);
+
+    PGXP_value v;
+    ValidateAndCopyMem(&v, 0x80100004, 0x12345678);
+    EXPECT_EQ(v.gFlags, 1);
+    EXPECT_GT(PGXP_GetMemUsage(), empty);
+
+    // A flagged value written alone into untouched memory is kept as well.
+    WriteMem(&tagged, 0x80104000);
+    ValidateAndCopyMem(&v, 0x80104000, 0x12345678);
+    EXPECT_EQ(v.gFlags, 1);
+
+    WriteMem(&regular, 0x80100004);
+    WriteMem(&regular, 0x80104000);
+    EXPECT_EQ(PGXP_GetMemUsage(), empty);
+}
+
+TEST(PGXP, RAMMirroring) {
+    PGXP_value precise = makeValue(0x00200010, VALID_01);
+    PGXP_value v;
+
+    // With 2MB, the RAM is mirrored 4 times over the first 8MB.
+    PGXP_InitMem(0x200000);
+    WriteMem(&precise, 0x80000100);
+    ValidateAndCopyMem(&v, 0x80600100, 0x00200010);
+    EXPECT_EQ(v.flags, VALID_01);
+
+    // With 8MB, it isn't.
+    PGXP_InitMem(0x800000);
+    WriteMem(&precise, 0x80000100);
+    ValidateAndCopyMem(&v, 0x80600100, 0x00200010);
+    EXPECT_EQ(v.flags, 0);
+    WriteMem(&precise, 0x80600100);
+    ValidateAndCopyMem(&v, 0x00600100, 0x00200010);
+    EXPECT_EQ(v.flags, VALID_01);
+}
+
+#if defined(DYNAREC_X86_64)
+// The dynarec needs to leave the exact same PGXP values behind as the interpreter.
+TEST(PGXP, DynarecMatchesInterpreter) {
+    const auto exe = buildProgram();
+    const auto path = std::filesystem::temp_directory_path() / "pgxp-differential.ps-exe";
+    FILE* f = fopen(path.string().c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+    fwrite(exe.data(), 1, exe.size(), f);
+    fclose(f);
+
+    for (int mode : {1, 2}) {
+        const auto interpreted = runProgram(path.string(), "-interpreter", mode);
+        const auto recompiled = runProgram(path.string(), "-dynarec", mode);
+        unsigned precise = 0;
+        for (unsigned i = 0; i < c_outputWords; i++) {
+            const auto& a = interpreted[i];
+            const auto& b = recompiled[i];
+            EXPECT_EQ(a.x, b.x) << "mode " << mode << ", word " << i;
+            EXPECT_EQ(a.y, b.y) << "mode " << mode << ", word " << i;
+            EXPECT_EQ(a.z, b.z) << "mode " << mode << ", word " << i;
+            EXPECT_EQ(a.flags, b.flags) << "mode " << mode << ", word " << i;
+            EXPECT_EQ(a.value, b.value) << "mode " << mode << ", word " << i;
+            if (a.flags) precise++;
+        }
+        EXPECT_GT(precise, 0) << "mode " << mode;
+    }
+    std::filesystem::remove(path);
+}
+#endif
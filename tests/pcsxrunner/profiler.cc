@@ -0,0 +1,97 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/sampling-profiler.h"
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+std::map<std::string, uint64_t> collapse(const PCSX::SamplingProfiler& profiler,
+                                         const std::map<uint32_t, std::string>& symbols) {
+    std::ostringstream out;
+    profiler.writeCollapsed(out, symbols);
+    std::istringstream in(out.str());
+    std::map<std::string, uint64_t> ret;
+    std::string line;
+    while (std::getline(in, line)) {
+        auto space = line.rfind(' ');
+        ret[line.substr(0, space)] += std::stoull(line.substr(space + 1));
+    }
+    return ret;
+}
+
+}  // namespace
+
+TEST(SamplingProfiler, AggregatesIdenticalStacks) {
+    PCSX::SamplingProfiler profiler;
+    const uint32_t a[] = {0x80010010, 0x80020020};
+    const uint32_t b[] = {0x80010010, 0x80030030};
+    for (unsigned i = 0; i < 3; i++) profiler.record(a, 2);
+    profiler.record(b, 2);
+    EXPECT_EQ(profiler.samples(), 4);
+    EXPECT_EQ(profiler.dropped(), 0);
+
+    auto stacks = collapse(profiler, {});
+    EXPECT_EQ(stacks.size(), 2);
+    EXPECT_EQ(stacks["0x80010010;0x80020020"], 3);
+    EXPECT_EQ(stacks["0x80010010;0x80030030"], 1);
+
+    profiler.clear();
+    EXPECT_EQ(profiler.samples(), 0);
+    EXPECT_TRUE(collapse(profiler, {}).empty());
+}
+
+TEST(SamplingProfiler, Symbolization) {
+    PCSX::SamplingProfiler profiler;
+    std::map<uint32_t, std::string> symbols = {
+        {0x80010000, "main"},
+        {0x80020000, "render frame"},
+        {0x80030000, "rtps;clip"},
+    };
+    // Return addresses inside the sampled function itself merge with it.
+    const uint32_t a[] = {0x80010010, 0x80020008, 0x80020020};
+    const uint32_t b[] = {0x80010010, 0x80030004};
+    const uint32_t c[] = {0x80000010};
+    profiler.record(a, 3);
+    profiler.record(b, 2);
+    profiler.record(c, 1);
+
+    auto stacks = collapse(profiler, symbols);
+    EXPECT_EQ(stacks["main;render_frame"], 1);
+    EXPECT_EQ(stacks["main;rtps:clip"], 1);
+    EXPECT_EQ(stacks["0x80000010"], 1);
+}
+
+TEST(SamplingProfiler, DeepStacksKeepTheInnermostFrames) {
+    PCSX::SamplingProfiler profiler;
+    uint32_t frames[PCSX::SamplingProfiler::c_maxDepth + 8];
+    for (unsigned i = 0; i < std::size(frames); i++) frames[i] = 0x80010000 + i * 4;
+    profiler.record(frames, std::size(frames));
+
+    auto stacks = collapse(profiler, {});
+    ASSERT_EQ(stacks.size(), 1);
+    const auto& stack = stacks.begin()->first;
+    EXPECT_EQ(stack.find("0x80010000;"), std::string::npos);
+    EXPECT_EQ(stack.substr(stack.rfind(';') + 1), "0x8001009c");
+}
@@ -0,0 +1,63 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include <filesystem>
+#include <string>
+
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+#include "main/main.h"
+
+// Scribbles over RAM, EXP1 and a register, saves, scribbles again, then loads
+// back. The second load also makes sure writes done after a load stay private,
+// and never reach the file the memory may have been mapped from.
+static const char roundTrip[] = R"(
+coroutine.resume(coroutine.create(function()
+    local mem, par, regs = PCSX.getMemPtr(), PCSX.getParPtr(), PCSX.getRegisters()
+    local function fill(value)
+        for i = 0, 0x1fffff, 4099 do mem[i] = value or (i % 251) end
+        par[0x1234] = value or 0x5a
+        regs.GPR.r[4] = value or 0x12345678
+    end
+    local function check()
+        for i = 0, 0x1fffff, 4099 do
+            if mem[i] ~= i % 251 then return false end
+        end
+        return par[0x1234] == 0x5a and regs.GPR.r[4] == 0x12345678
+    end
+    fill()
+    local ok = PCSX.saveMappedSaveState(MappedStateFile)
+    fill(0)
+    ok = ok and PCSX.loadMappedSaveState(MappedStateFile) and check()
+    fill(0xaa)
+    ok = ok and PCSX.loadMappedSaveState(MappedStateFile) and check()
+    PCSX.quit(ok and 0 or 1)
+end))
+)";
+
+TEST(SaveStates, MappedRoundTrip) {
+    auto file = std::filesystem::temp_directory_path() / "pcsx-mapped-sstate-test.sstate";
+    std::filesystem::remove(file);
+    std::string setFile = fmt::format("MappedStateFile = '{}'", file.generic_string());
+    MainInvoker invoker("-no-ui", "-cli", "-bios", "src/mips/openbios/openbios.bin", "-testmode", "-interpreter",
+                        "-exec", setFile.c_str(), "-exec", roundTrip);
+    int ret = invoker.invoke();
+    EXPECT_EQ(ret, 0);
+    std::filesystem::remove(file);
+}
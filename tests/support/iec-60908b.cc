@@ -0,0 +1,102 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "supportpsx/iec-60908b.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <vector>
+
+#include "cdrom/iso9660-builder.h"
+#include "gtest/gtest.h"
+#include "iec-60908b/edcecc.h"
+
+static std::vector<uint8_t> makeSectors(size_t count) {
+    std::vector<uint8_t> sectors(count * PCSX::IEC60908b::FRAMESIZE_RAW);
+    srand(42);
+    for (auto& c : sectors) c = rand();
+    for (size_t i = 0; i < count; i++) {
+        uint8_t* sector = sectors.data() + i * PCSX::IEC60908b::FRAMESIZE_RAW;
+        sector[15] = 2;
+        sector[18] = sector[22] = (i & 1) ? 0x20 : 0x08;
+    }
+    return sectors;
+}
+
+TEST(IEC60908b, SingleSectorMatchesReference) {
+    auto reference = makeSectors(64);
+    auto sectors = reference;
+    for (size_t i = 0; i < 64; i++) {
+        compute_edcecc(reference.data() + i * PCSX::IEC60908b::FRAMESIZE_RAW);
+        PCSX::IEC60908b::computeEDCECC(sectors.data() + i * PCSX::IEC60908b::FRAMESIZE_RAW);
+    }
+    EXPECT_EQ(reference, sectors);
+}
+
+TEST(IEC60908b, BatchMatchesReference) {
+    auto reference = makeSectors(1000);
+    auto sectors = reference;
+    for (size_t i = 0; i < 1000; i++) compute_edcecc(reference.data() + i * PCSX::IEC60908b::FRAMESIZE_RAW);
+    PCSX::IEC60908b::computeEDCECC(sectors.data(), 1000, 4);
+    EXPECT_EQ(reference, sectors);
+}
+
+TEST(IEC60908b, BuilderMatchesReference) {
+    PCSX::IO<PCSX::File> out = new PCSX::BufferFile(PCSX::FileOps::READWRITE);
+    PCSX::ISO9660Builder builder(out);
+    std::vector<uint8_t> reference(1000 * PCSX::IEC60908b::FRAMESIZE_RAW);
+    uint8_t data[2048];
+    for (unsigned i = 0; i < 1000; i++) {
+        memset(data, i & 0xff, sizeof(data));
+        builder.writeSector(data, PCSX::SectorMode::M2_FORM1);
+        uint8_t* sector = reference.data() + i * PCSX::IEC60908b::FRAMESIZE_RAW;
+        memset(sector + 1, 0xff, 10);
+        PCSX::IEC60908b::MSF(i + 150).toBCD(sector + 12);
+        sector[15] = 2;
+        sector[18] = sector[22] = 8;
+        memcpy(sector + 24, data, sizeof(data));
+        compute_edcecc(sector);
+    }
+    builder.flush();
+    ASSERT_EQ(out->size(), reference.size());
+    std::vector<uint8_t> written(reference.size());
+    out->readAt(written.data(), written.size(), 0);
+    EXPECT_EQ(reference, written);
+}
+
+// Run with --gtest_also_run_disabled_tests to get timings on a 650MB image.
+TEST(IEC60908b, DISABLED_Benchmark) {
+    constexpr size_t count = 650 * 1024 * 1024 / 2048;
+    auto reference = makeSectors(count);
+    auto sectors = reference;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) compute_edcecc(reference.data() + i * PCSX::IEC60908b::FRAMESIZE_RAW);
+    auto mid = std::chrono::steady_clock::now();
+    PCSX::IEC60908b::computeEDCECC(sectors.data(), count);
+    auto end = std::chrono::steady_clock::now();
+
+    auto ms = [](auto d) { return std::chrono::duration_cast<std::chrono::milliseconds>(d).count(); };
+    printf("reference: %lldms, batched: %lldms\n", (long long)ms(mid - start), (long long)ms(end - mid));
+    EXPECT_EQ(reference, sectors);
+}
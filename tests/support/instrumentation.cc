@@ -0,0 +1,93 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "support/instrumentation.h"
+
+#include "gtest/gtest.h"
+
+using Scope = PCSX::Instrumentation::Scope;
+
+static unsigned index(Scope scope) { return static_cast<unsigned>(scope); }
+
+TEST(Instrumentation, Disabled) {
+    PCSX::Instrumentation instrumentation;
+    PCSX::Instrumentation::setCurrent(&instrumentation);
+    {
+        PCSX_INSTRUMENT(GPU);
+    }
+    instrumentation.endFrame();
+    EXPECT_EQ(instrumentation.frames(), 0);
+    EXPECT_EQ(instrumentation.lastFrame().calls[index(Scope::GPU)], 0);
+    PCSX::Instrumentation::setCurrent(nullptr);
+}
+
+TEST(Instrumentation, Nesting) {
+    PCSX::Instrumentation instrumentation;
+    PCSX::Instrumentation::setCurrent(&instrumentation);
+    instrumentation.enable();
+    for (unsigned i = 0; i < 3; i++) {
+        PCSX_INSTRUMENT(GPU);
+        {
+            PCSX_INSTRUMENT(Rasterizer);
+            {
+                PCSX_INSTRUMENT(Events);
+            }
+        }
+    }
+    instrumentation.endFrame();
+    EXPECT_EQ(instrumentation.frames(), 1);
+
+    auto& frame = instrumentation.lastFrame();
+    EXPECT_EQ(frame.calls[index(Scope::GPU)], 3);
+    EXPECT_EQ(frame.calls[index(Scope::Rasterizer)], 3);
+    EXPECT_EQ(frame.calls[index(Scope::Events)], 3);
+    EXPECT_EQ(frame.calls[index(Scope::CPU)], 0);
+    uint64_t total = 0;
+    for (auto t : frame.ticks) total += t;
+    EXPECT_EQ(total, frame.totalTicks);
+
+    // A frame with no timer in it only accounts for the CPU.
+    instrumentation.endFrame();
+    EXPECT_EQ(instrumentation.frames(), 2);
+    EXPECT_EQ(instrumentation.lastFrame().calls[index(Scope::GPU)], 0);
+    EXPECT_EQ(instrumentation.lastFrame().ticks[index(Scope::GPU)], 0);
+    PCSX::Instrumentation::setCurrent(nullptr);
+}
+
+TEST(Instrumentation, DisableWhileNested) {
+    PCSX::Instrumentation instrumentation;
+    PCSX::Instrumentation::setCurrent(&instrumentation);
+    instrumentation.enable();
+    {
+        PCSX_INSTRUMENT(Lua);
+        instrumentation.disable();
+        {
+            PCSX_INSTRUMENT(SPU);
+        }
+    }
+    instrumentation.enable();
+    {
+        PCSX_INSTRUMENT(SPU);
+    }
+    instrumentation.endFrame();
+    auto& frame = instrumentation.lastFrame();
+    EXPECT_EQ(frame.calls[index(Scope::Lua)], 0);
+    EXPECT_EQ(frame.calls[index(Scope::SPU)], 1);
+    PCSX::Instrumentation::setCurrent(nullptr);
+}
@@ -0,0 +1,100 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "support/mmapfile.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <filesystem>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+std::filesystem::path writeTemp(const char* name, const std::vector<uint8_t>& data) {
+    auto path = std::filesystem::temp_directory_path() / name;
+    FILE* f = fopen(path.string().c_str(), "wb");
+    if (!data.empty()) fwrite(data.data(), 1, data.size(), f);
+    fclose(f);
+    return path;
+}
+
+}  // namespace
+
+TEST(MmapFile, Read) {
+    std::vector<uint8_t> data(100000);
+    for (size_t i = 0; i < data.size(); i++) data[i] = uint8_t(i * 7);
+    auto path = writeTemp("pcsx-mmapfile-test.bin", data);
+    {
+        PCSX::IO<PCSX::File> file(new PCSX::MmapFile(path, PCSX::MmapFile::Access::RANDOM));
+        ASSERT_FALSE(file->failed());
+        EXPECT_EQ(file->size(), data.size());
+
+        uint8_t buffer[256];
+        file->rSeek(1000, SEEK_SET);
+        EXPECT_EQ(file->read(buffer, sizeof(buffer)), sizeof(buffer));
+        EXPECT_EQ(memcmp(buffer, data.data() + 1000, sizeof(buffer)), 0);
+        EXPECT_EQ(file->rTell(), 1256);
+
+        EXPECT_EQ(file->readAt(buffer, sizeof(buffer), data.size() - 10), 10);
+        EXPECT_EQ(memcmp(buffer, data.data() + data.size() - 10, 10), 0);
+        EXPECT_EQ(file->readAt(buffer, sizeof(buffer), data.size()), -1);
+
+        file->rSeek(-1, SEEK_END);
+        EXPECT_EQ(file->getc(), data.back());
+        EXPECT_TRUE(file->eof());
+        EXPECT_EQ(file->getc(), -1);
+
+        PCSX::IO<PCSX::File> dup(file->dup());
+        file.reset();
+        EXPECT_EQ(dup->readAt<uint32_t>(4000), *reinterpret_cast<const uint32_t*>(data.data() + 4000));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(MmapFile, Borrow) {
+    std::vector<uint8_t> data(5000, 0x42);
+    data[4999] = 0x24;
+    auto path = writeTemp("pcsx-mmapfile-borrow.bin", data);
+    {
+        PCSX::IO<PCSX::MmapFile> file(new PCSX::MmapFile(path));
+        PCSX::Slice slice = file->borrow(100, 4950);
+        EXPECT_EQ(slice.size(), 50);
+        EXPECT_EQ(slice.data(), file->data() + 4950);
+        EXPECT_EQ(slice.getByte(49), 0x24);
+        EXPECT_EQ(file->borrow(10, 5000).size(), 0);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(MmapFile, EmptyAndMissing) {
+    auto path = writeTemp("pcsx-mmapfile-empty.bin", {});
+    {
+        PCSX::IO<PCSX::File> file(new PCSX::MmapFile(path));
+        EXPECT_FALSE(file->failed());
+        EXPECT_EQ(file->size(), 0);
+        EXPECT_TRUE(file->eof());
+    }
+    std::filesystem::remove(path);
+    PCSX::IO<PCSX::File> missing(new PCSX::MmapFile(path));
+    EXPECT_TRUE(missing->failed());
+}
@@ -0,0 +1,73 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "support/sharedmem.h"
+
+#include <string.h>
+
+#include "gtest/gtest.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+static void fill(PCSX::SharedMem& mem, uint8_t seed) {
+    for (size_t i = 0; i < mem.getSize(); i++) mem.getPtr()[i] = uint8_t(i * 7 + seed);
+}
+
+TEST(SharedMem, SameContentIsShared) {
+    PCSX::SharedMem a, b;
+    a.init(nullptr, 0x80000, true);
+    b.init(nullptr, 0x80000, true);
+    fill(a, 1);
+    fill(b, 1);
+    EXPECT_TRUE(a.shareContent("gtest", 0x80000));
+    EXPECT_TRUE(b.shareContent("gtest", 0x80000));
+    EXPECT_EQ(memcmp(a.getPtr(), b.getPtr(), 0x80000), 0);
+
+    // Writes stay private to the one doing them.
+    a.getPtr()[5] = 0x42;
+    EXPECT_EQ(b.getPtr()[5], uint8_t(5 * 7 + 1));
+    EXPECT_EQ(a.getPtr()[5], 0x42);
+}
+
+TEST(SharedMem, DifferentContentIsNotMixedUp) {
+    PCSX::SharedMem a, b;
+    a.init(nullptr, 0x10000, true);
+    b.init(nullptr, 0x10000, true);
+    fill(a, 2);
+    fill(b, 3);
+    EXPECT_TRUE(a.shareContent("gtest", 0x10000));
+    EXPECT_TRUE(b.shareContent("gtest", 0x10000));
+    EXPECT_EQ(a.getPtr()[0], 2);
+    EXPECT_EQ(b.getPtr()[0], 3);
+}
+
+TEST(SharedMem, OnlyThePrefixIsShared) {
+    PCSX::SharedMem a, b;
+    a.init(nullptr, 0x20000, true);
+    b.init(nullptr, 0x20000, true);
+    fill(a, 4);
+    fill(b, 4);
+    b.getPtr()[0x1ffff] = 0;
+    EXPECT_TRUE(a.shareContent("gtest", 0x10000));
+    EXPECT_TRUE(b.shareContent("gtest", 0x10000));
+    EXPECT_EQ(a.getPtr()[0x1ffff], uint8_t(0x1ffff * 7 + 4));
+    EXPECT_EQ(b.getPtr()[0x1ffff], 0);
+}
+
+#endif
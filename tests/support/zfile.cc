@@ -0,0 +1,123 @@
+/***************************************************************************
+ *   Copyright (C) 2024 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "support/zfile.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <zlib.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Somewhat compressible data, so the deflate stream has plenty of blocks.
+std::vector<uint8_t> makeData(size_t size) {
+    std::vector<uint8_t> data(size);
+    std::mt19937 rng(42);
+    for (size_t i = 0; i < size; i++) data[i] = uint8_t(i >> 7) ^ (rng() & 0x0f);
+    return data;
+}
+
+std::vector<uint8_t> compress(const std::vector<uint8_t>& data, bool gzip) {
+    z_stream z = {};
+    deflateInit2(&z, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + (gzip ? 16 : 0), MAX_MEM_LEVEL,
+                 Z_DEFAULT_STRATEGY);
+    std::vector<uint8_t> out(deflateBound(&z, data.size()));
+    z.next_in = const_cast<Bytef*>(data.data());
+    z.avail_in = data.size();
+    z.next_out = out.data();
+    z.avail_out = out.size();
+    deflate(&z, Z_FINISH);
+    out.resize(z.total_out);
+    deflateEnd(&z);
+    return out;
+}
+
+void randomReads(PCSX::IO<PCSX::ZReader> reader, const std::vector<uint8_t>& data, unsigned count) {
+    std::mt19937 rng(1234);
+    std::vector<uint8_t> buffer(4096);
+    for (unsigned i = 0; i < count; i++) {
+        size_t pos = rng() % (data.size() - buffer.size());
+        reader->rSeek(pos, SEEK_SET);
+        ASSERT_EQ(reader->read(buffer.data(), buffer.size()), buffer.size());
+        ASSERT_EQ(memcmp(buffer.data(), data.data() + pos, buffer.size()), 0);
+    }
+}
+
+}  // namespace
+
+TEST(ZReader, Sequential) {
+    auto data = makeData(1024 * 1024);
+    auto compressed = compress(data, true);
+    PCSX::IO<PCSX::File> file(new PCSX::BufferFile(compressed.data(), compressed.size()));
+    PCSX::IO<PCSX::ZReader> reader(new PCSX::ZReader(file, data.size()));
+    std::vector<uint8_t> out(data.size() + 16);
+    EXPECT_EQ(reader->read(out.data(), out.size()), data.size());
+    EXPECT_EQ(memcmp(out.data(), data.data(), data.size()), 0);
+    EXPECT_TRUE(reader->eof());
+}
+
+TEST(ZReader, RandomReads) {
+    auto data = makeData(1024 * 1024);
+    auto compressed = compress(data, true);
+    PCSX::IO<PCSX::File> file(new PCSX::BufferFile(compressed.data(), compressed.size()));
+    PCSX::IO<PCSX::ZReader> reader(new PCSX::ZReader(file, data.size()));
+    randomReads(reader, data, 32);
+}
+
+TEST(ZReader, RandomReadsIndexed) {
+    auto data = makeData(4 * 1024 * 1024);
+    auto compressed = compress(data, false);
+    PCSX::IO<PCSX::File> file(new PCSX::BufferFile(compressed.data(), compressed.size()));
+    PCSX::IO<PCSX::ZReader> reader(new PCSX::ZReader(file, data.size()));
+    reader->enableIndex(64 * 1024);
+    std::vector<uint8_t> out(data.size());
+    EXPECT_EQ(reader->read(out.data(), out.size()), data.size());
+    EXPECT_GT(reader->indexPoints(), 16);
+    randomReads(reader, data, 256);
+
+    PCSX::IO<PCSX::ZReader> dup(dynamic_cast<PCSX::ZReader*>(reader->dup()));
+    EXPECT_EQ(dup->indexPoints(), reader->indexPoints());
+    randomReads(dup, data, 256);
+}
+
+// Run with --gtest_also_run_disabled_tests to compare random access speed
+// over a large compressed file, with and without the seek index.
+TEST(ZReader, DISABLED_Benchmark) {
+    auto data = makeData(64 * 1024 * 1024);
+    auto compressed = compress(data, true);
+    for (size_t span : {size_t(0), size_t(256 * 1024), PCSX::ZReader::c_defaultIndexSpan}) {
+        PCSX::IO<PCSX::File> file(new PCSX::BufferFile(compressed.data(), compressed.size()));
+        PCSX::IO<PCSX::ZReader> reader(new PCSX::ZReader(file, data.size()));
+        if (span) reader->enableIndex(span);
+        auto start = std::chrono::steady_clock::now();
+        randomReads(reader, data, 200);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::string line = fmt::format("span {}: 200 random reads in {:.1f} ms, {} checkpoints\n", span,
+                                       elapsed.count(), reader->indexPoints());
+        printf("%s", line.c_str());
+    }
+}
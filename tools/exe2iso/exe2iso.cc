@@ -19,9 +19,9 @@
 
 #include <stdint.h>
 
+#include "cdrom/iso9660-builder.h"
 #include "flags.h"
 #include "fmt/format.h"
-#include "iec-60908b/edcecc.h"
 #include "support/file.h"
 #include "supportpsx/iec-60908b.h"
 
@@ -133,6 +133,18 @@ Usage: {} input.ps-exe [-offset value] [-pad] [-regen] [-license file] -o output
     exeSize *= 2048;
     uint32_t exeOffset = 19 + offset;
 
+    // The builder computes the EDC/ECC of the sectors in batches, on a worker thread,
+    // and writes them out in order.
+    PCSX::ISO9660Builder builder(out);
+    auto writeSector = [&builder, regen](const uint8_t sector[2352], uint32_t lba) {
+        PCSX::IEC60908b::MSF msf(lba + 150);
+        if (regen) {
+            builder.writeSectorAt(sector + 24, msf, PCSX::SectorMode::M2_FORM1);
+        } else {
+            builder.writeSectorAt(sector, msf, PCSX::SectorMode::RAW);
+        }
+    };
+
     uint8_t sector[2352];
     bool wroteLicense = false;
     // Sectors 0-15 are the license. We can keep it to zeroes and it'll work most everywhere.
@@ -146,8 +158,7 @@ Usage: {} input.ps-exe [-offset value] [-pad] [-regen] [-license file] -o output
                 memset(sector, 0, sizeof(sector));
                 memcpy(sector + 16, licenseData + 2336 * i, 2336);
                 makeHeader(sector, i);
-                if (regen) compute_edcecc(sector);
-                out->write(sector, sizeof(sector));
+                writeSector(sector, i);
             }
             wroteLicense = true;
         } else if (licenseData[0x24e2] == 'L') {
@@ -155,8 +166,7 @@ Usage: {} input.ps-exe [-offset value] [-pad] [-regen] [-license file] -o output
             for (unsigned i = 0; i < 16; i++) {
                 memcpy(sector, licenseData + 2352 * i, 2352);
                 makeHeader(sector, i);
-                if (regen) compute_edcecc(sector);
-                out->write(sector, sizeof(sector));
+                writeSector(sector, i);
             }
             wroteLicense = true;
         } else {
@@ -167,8 +177,7 @@ Usage: {} input.ps-exe [-offset value] [-pad] [-regen] [-license file] -o output
         for (unsigned i = 0; i < 16; i++) {
             memset(sector, 0, sizeof(sector));
             makeHeader(sector, i);
-            if (regen) compute_edcecc(sector);
-            out->write(sector, sizeof(sector));
+            writeSector(sector, i);
         }
     }
     // The actual structure of the iso. We're only generating 3 sectors,
@@ -179,33 +188,30 @@ Usage: {} input.ps-exe [-offset value] [-pad] [-regen] [-license file] -o output
         // This function will fill the sector with the right data, as
         // necessary for the PS1 bios.
         getSector(sector + 24, i, exeSize, exeOffset);
-        if (regen) compute_edcecc(sector);
-        out->write(sector, sizeof(sector));
+        writeSector(sector, i);
     }
     // Potential padding before the start of the exe.
     for (unsigned i = 19; i < exeOffset; i++) {
         memset(sector, 0, sizeof(sector));
         makeHeader(sector, i);
-        if (regen) compute_edcecc(sector);
-        out->write(sector, sizeof(sector));
+        writeSector(sector, i);
     }
     unsigned LBA = exeOffset;
     // The actual exe.
     for (unsigned i = 0; i < exeSize; i += 2048) {
         memset(sector, 0, sizeof(sector));
-        makeHeader(sector, LBA++);
+        makeHeader(sector, LBA);
         file->read(sector + 24, 2048);
-        if (regen) compute_edcecc(sector);
-        out->write(sector, sizeof(sector));
+        writeSector(sector, LBA++);
     }
     if (pad) {
         // 150 sectors padding.
         for (unsigned i = 0; i < 150; i++) {
             memset(sector, 0, sizeof(sector));
-            makeHeader(sector, LBA++);
-            if (regen) compute_edcecc(sector);
-            out->write(sector, sizeof(sector));
+            makeHeader(sector, LBA);
+            writeSector(sector, LBA++);
         }
     }
+    builder.close();
     fmt::print("Done.");
 }